@@ -0,0 +1,72 @@
+// Cost of one flight recorder record, from a single thread and from several threads at once,
+// against printing the same information as a log line, which is what we had before.
+
+#include "flight_recorder.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int kRecords = 2000000;
+
+    template <typename Record>
+    double nanosecondsPerRecord(int threads, Record record)
+    {
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&record]()
+                                 {
+                                     for (int i = 0; i < kRecords; ++i)
+                                     {
+                                         record(i);
+                                     } });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / kRecords;
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-90.0, 90.0);
+    std::vector<drone_sdk::Location> locations;
+    for (int i = 0; i < 1024; ++i)
+    {
+        locations.emplace_back(coordinate(generator), coordinate(generator), 100.0);
+    }
+
+    drone_sdk::FlightRecorder recorder;
+    const auto record = [&recorder, &locations](int i)
+    {
+        recorder.recordGpsSample(locations[static_cast<std::size_t>(i) & 1023], drone_sdk::SignalQuality::GOOD);
+    };
+    const double single = nanosecondsPerRecord(1, record);
+    const double contended = nanosecondsPerRecord(4, record);
+
+    std::FILE *null = std::fopen("/dev/null", "w");
+    const double text = nanosecondsPerRecord(1, [null, &locations](int i)
+                                             {
+                                                 const auto &location = locations[static_cast<std::size_t>(i) & 1023];
+                                                 std::fprintf(null, "GPS %.9f %.9f %.3f GOOD\n", location.latitude,
+                                                              location.longitude, location.altitude); });
+    std::fclose(null);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "recorder, 1 thread:   " << single << " ns/record\n"
+              << "recorder, 4 threads:  " << contended << " ns/record per thread\n"
+              << "text log line:        " << text << " ns/record\n";
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Cost of one waypoint arrival check per GPS update.
+// Compares the trig free ArrivalDetector with exact equality (the old check, which never
+// fires on real GPS data) and with a full haversine distance on every update.
+
+#include "geo.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kRounds = 20;
+
+    template <typename Check>
+    double nanosecondsPerUpdate(const std::vector<drone_sdk::Location> &updates, Check check)
+    {
+        std::size_t hits = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const auto &update : updates)
+            {
+                hits += check(update) ? 1 : 0;
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        volatile std::size_t sink = hits; // Keeps the checks from being optimized away
+        (void)sink;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               static_cast<double>(updates.size() * kRounds);
+    }
+}
+
+int main()
+{
+    const drone_sdk::Location target{32.0, 34.0, 50.0};
+
+    // GPS fixes scattered around the approach to the target, a few meters to a few kilometers out
+    std::mt19937 generator(42);
+    std::normal_distribution<double> spread(0.0, 0.005);
+    std::normal_distribution<double> altitude(50.0, 5.0);
+    std::vector<drone_sdk::Location> updates;
+    for (int i = 0; i < 1000000; ++i)
+    {
+        updates.emplace_back(target.latitude + spread(generator), target.longitude + spread(generator), altitude(generator));
+    }
+
+    drone_sdk::geo::ArrivalDetector detector(2.0);
+    detector.setTarget(target);
+
+    const double exactNs = nanosecondsPerUpdate(updates, [&target](const drone_sdk::Location &update)
+                                                { return update == target; });
+    const double detectorNs = nanosecondsPerUpdate(updates, [&detector](const drone_sdk::Location &update)
+                                                   { return detector.arrived(update); });
+    const double haversineNs = nanosecondsPerUpdate(updates, [&target](const drone_sdk::Location &update)
+                                                    { return drone_sdk::geo::distance(update, target) <= 2.0; });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "exact equality      " << std::setw(8) << exactNs << " ns/update" << std::endl
+              << "ArrivalDetector     " << std::setw(8) << detectorNs << " ns/update" << std::endl
+              << "haversine distance  " << std::setw(8) << haversineNs << " ns/update" << std::endl;
+    return 0;
+}
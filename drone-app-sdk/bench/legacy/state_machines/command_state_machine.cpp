@@ -32,12 +32,12 @@ namespace commandstatemachine
                 return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
             }
             takingOffCheck();
-            m_destination = *singleDestination;
+            setDestination(*singleDestination);
             break;
 
         case drone_sdk::CurrentMission::HOME:
             std::cout << "GOING HOMW!!!!" << std::endl;
-            m_destination = m_home;
+            setDestination(m_home);
             break;
         case drone_sdk::CurrentMission::HOVER:
             if (singleDestination || pathDestinations)
@@ -45,17 +45,15 @@ namespace commandstatemachine
                 return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
             }
             takingOffCheck();
-            m_destination = m_currLocation;
+            setDestination(m_currLocation);
             handleTaskCompleted();
             break;
         case drone_sdk::CurrentMission::PATH:
-            if (!pathDestinations)
+            if (!pathDestinations || pathDestinations->empty())
             {
                 return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
             }
-            m_pathQueue = *pathDestinations;
-            m_destination = m_pathQueue.front();
-            m_pathQueue.pop();
+            startPath(drone_sdk::Path::fromQueue(*pathDestinations));
             break;
         default:
             return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
@@ -64,44 +62,96 @@ namespace commandstatemachine
         return drone_sdk::FlightControllerStatus::SUCCESS;
     }
 
+    // Handle a path mission handed over without copies
+    drone_sdk::FlightControllerStatus CommandStateMachine::handlePathAssigned(drone_sdk::Path path)
+    {
+        if (path.empty())
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+
+        m_SM.process_event(TaskAssigned{});
+        m_currMission = drone_sdk::CurrentMission::PATH;
+        updateCurrentState();
+
+        startPath(std::move(path));
+        m_missionChangeSignal(m_currMission);
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    void CommandStateMachine::startPath(drone_sdk::Path path)
+    {
+        m_path = std::move(path);
+        setDestination(m_path.front());
+        nextLeg();
+    }
+
+    void CommandStateMachine::nextLeg()
+    {
+        const std::span<const drone_sdk::Location> leg = m_path.pop();
+        m_legBegin = static_cast<std::size_t>(leg.data() - m_path.waypoints().data());
+        m_legEnd = m_legBegin + leg.size();
+    }
+
+    drone_sdk::FlightControllerStatus CommandStateMachine::appendWaypoints(std::span<const drone_sdk::Location> waypoints)
+    {
+        return replaceRemaining(m_path.waypoints().size(), waypoints);
+    }
+
+    drone_sdk::FlightControllerStatus CommandStateMachine::replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+    {
+        if (m_currMission != drone_sdk::CurrentMission::PATH || m_currentState != drone_sdk::CommandStatus::BUSY ||
+            fromIndex < m_path.editableFrom() || fromIndex > m_path.waypoints().size())
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+        m_path.replaceRemaining(fromIndex, waypoints);
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    drone_sdk::FlightControllerStatus CommandStateMachine::truncatePath(std::size_t endIndex)
+    {
+        return replaceRemaining(endIndex, {});
+    }
+
     // Handle task aborted due to safety
     void CommandStateMachine::handleTaskAbortedSafety()
     {
         m_SM.process_event(TaskAborted{});
         // go to the height of the home
         drone_sdk::Location emergancy_landing{m_currLocation.latitude, m_currLocation.longitude, m_home.altitude};
-        m_destination = emergancy_landing;
+        setDestination(emergancy_landing);
         updateCurrentState();
     }
 
     // Subscribe to state changes
-    boost::signals2::connection CommandStateMachine::subscribeToState(const StateChangeSignal::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToState(const StateChangeSignal::slot_type &subscriber)
     {
         return m_stateChangeSignal.connect(subscriber);
     }
 
     // Subscribe to path waypoint updates
-    boost::signals2::connection CommandStateMachine::subscribeToPathWaypoint(const PathWayPoint::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToPathWaypoint(const PathWayPoint::slot_type &subscriber)
     {
         return m_pathWaypoint.connect(subscriber);
     }
 
-    boost::signals2::connection CommandStateMachine::subscribeToCurrentDestination(const CurrenitDestinationSignal::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToCurrentDestination(const CurrenitDestinationSignal::slot_type &subscriber)
     {
         return m_currDestinationSignal.connect(subscriber);
     }
 
-    boost::signals2::connection CommandStateMachine::subscribeToLandingSignal(const LandingSignal::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToLandingSignal(const LandingSignal::slot_type &subscriber)
     {
         return m_landingSignal.connect(subscriber);
     }
 
-    boost::signals2::connection CommandStateMachine::subscribeToTakingOffSignal(const TakingOffSignal::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToTakingOffSignal(const TakingOffSignal::slot_type &subscriber)
     {
         return m_takingOffSignal.connect(subscriber);
     }
 
-    boost::signals2::connection CommandStateMachine::subscribeToMission(const MissionChangeSignal::slot_type &subscriber)
+    drone_sdk::Connection CommandStateMachine::subscribeToMission(const MissionChangeSignal::slot_type &subscriber)
     {
         return m_missionChangeSignal.connect(subscriber);
     }
@@ -110,7 +160,7 @@ namespace commandstatemachine
     void CommandStateMachine::handleGpsLocationUpdate(const drone_sdk::Location &newLocation)
     {
         m_currLocation = newLocation;
-        if (m_currLocation == m_destination)
+        if (m_arrival.arrived(m_currLocation))
         {
             // std::cout<<"reached destination!!!!"<<m_currLocation.altitude<<std::endl;
             switch (m_currMission)
@@ -153,6 +203,14 @@ namespace commandstatemachine
             handleTaskAbortedSafety();
         }
     }
+
+    void CommandStateMachine::handleGeofenceStateChange(drone_sdk::safetyState geofenceState)
+    {
+        if (geofenceState == drone_sdk::safetyState::GEOFENCE_VIOLATED)
+        {
+            handleTaskAbortedSafety();
+        }
+    }
     // Handle task completion
     void CommandStateMachine::handleTaskCompleted()
     {
@@ -163,15 +221,19 @@ namespace commandstatemachine
     // Handle path updates for PATH mission
     void CommandStateMachine::handleTaskPathUpdate()
     {
-        m_pathWaypoint(m_destination);
-        if (m_pathQueue.empty())
+        // A simplified path reaches the waypoints it skipped along with the next kept one
+        for (std::size_t index = m_legBegin; index < m_legEnd; ++index)
+        {
+            m_pathWaypoint(m_path.waypoints()[index]);
+        }
+        if (m_path.empty())
         {
             handleTaskCompleted();
         }
         else
         {
-            updateCurrentDestination(m_pathQueue.front());
-            m_pathQueue.pop();
+            updateCurrentDestination(m_path.front());
+            nextLeg();
         }
     }
 
@@ -199,7 +261,7 @@ namespace commandstatemachine
     // Update current mission
     void CommandStateMachine::updateCurrentDestination(drone_sdk::Location newDestination)
     {
-        m_destination = newDestination;
+        setDestination(newDestination);
         m_currDestinationSignal(m_destination);
     }
 
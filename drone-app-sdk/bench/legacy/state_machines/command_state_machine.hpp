@@ -2,36 +2,17 @@
 #define COMMAND_STATE_MACHINE_HPP
 
 #include <boost/sml.hpp>
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include <queue>
 #include <optional>
 #include "icd.hpp"
+#include "state_machines/command_states.hpp" // States and events, shared with DroneStateMachine
+#include "path.hpp"
+#include "geo.hpp"
 #include <iostream>
 namespace commandstatemachine
 {
 
-    // Events represent triggers for state transitions in the state machine
-    struct TaskAssigned
-    {
-    }; ///< Event triggered when a new task is assigned.
-    struct TaskCompleted
-    {
-    }; ///< Event triggered when a task is completed.
-    struct TaskAborted
-    {
-    }; ///< Event triggered when a task is aborted because of emergency.
-
-    // States define the possible states of the command state machine
-    struct Idle
-    {
-    }; ///< State representing no active task (idle).
-    struct Busy
-    {
-    }; ///< State representing an ongoing task.
-    struct MissionAbort
-    {
-    }; ///< State representing an aborted mission because safety reasons.
-
     // Command_SM struct defines the state machine transitions and logic
     struct Command_SM
     {
@@ -60,14 +41,14 @@ namespace commandstatemachine
     class CommandStateMachine
     {
     public:
-        using StateChangeSignal = boost::signals2::signal<void(drone_sdk::CommandStatus)>;
-        using MissionChangeSignal = boost::signals2::signal<void(drone_sdk::CurrentMission)>;
+        using StateChangeSignal = drone_sdk::Signal<void(drone_sdk::CommandStatus)>;
+        using MissionChangeSignal = drone_sdk::Signal<void(drone_sdk::CurrentMission)>;
         
-        using PathWayPoint = boost::signals2::signal<void(drone_sdk::Location)>;
+        using PathWayPoint = drone_sdk::Signal<void(drone_sdk::Location)>;
 
-        using CurrenitDestinationSignal = boost::signals2::signal<void(drone_sdk::Location)>;
-        using LandingSignal = boost::signals2::signal<void(bool)>;
-        using TakingOffSignal = boost::signals2::signal<void(bool)>;
+        using CurrenitDestinationSignal = drone_sdk::Signal<void(drone_sdk::Location)>;
+        using LandingSignal = drone_sdk::Signal<void(bool)>;
+        using TakingOffSignal = drone_sdk::Signal<void(bool)>;
         /**
          * @brief Constructs the CommandStateMachine instance.
          */
@@ -86,6 +67,33 @@ namespace commandstatemachine
             const std::optional<drone_sdk::Location> &singleDestination = std::nullopt,
             const std::optional<std::queue<drone_sdk::Location>> &pathDestinations = std::nullopt);
 
+        /**
+         * @brief Assigns a PATH mission, taking over the waypoints without copying them.
+         * @param path The waypoints to follow, must not be empty.
+         * @retval FlightControllerStatus INVALID_COMMAND for an empty path, SUCCESS otherwise.
+         */
+        drone_sdk::FlightControllerStatus handlePathAssigned(drone_sdk::Path path);
+
+        /**
+         * @brief Edits the waypoints of the running PATH mission without restarting it.
+         * @details No signal is emitted; the current destination is never changed, so the new
+         *          waypoints are picked up as the drone gets to them.
+         * @param fromIndex Index into the path's waypoints, see drone_sdk::Path::replaceRemaining().
+         * @retval FlightControllerStatus INVALID_COMMAND without a running PATH mission or for an
+         *         index outside the waypoints not reached yet, SUCCESS otherwise.
+         */
+        drone_sdk::FlightControllerStatus appendWaypoints(std::span<const drone_sdk::Location> waypoints);
+        drone_sdk::FlightControllerStatus replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints);
+        drone_sdk::FlightControllerStatus truncatePath(std::size_t endIndex);
+
+        /**
+         * @brief The path of the current or last PATH mission.
+         */
+        const drone_sdk::Path &getPath() const
+        {
+            return m_path;
+        }
+
         /**
          * @brief Handles updates to the GPS location.
          * @param newLocation The updated GPS location of the drone.
@@ -93,6 +101,7 @@ namespace commandstatemachine
         void handleGpsLocationUpdate(const drone_sdk::Location &newLocation);
         void handleGpsStateChange(drone_sdk::safetyState gpsState);
         void handleLinkStateChange(drone_sdk::safetyState linkState);
+        void handleGeofenceStateChange(drone_sdk::safetyState geofenceState);
 
         /**
          * @brief Sets the home base location for the drone.
@@ -103,6 +112,20 @@ namespace commandstatemachine
             m_home = newHome;
         }
 
+        /**
+         * @brief Sets how close the drone must get to a destination for it to count as reached.
+         * @param radiusMeters Radius of the arrival sphere around the destination, in meters.
+         */
+        void setArrivalRadius(double radiusMeters)
+        {
+            m_arrival.setRadius(radiusMeters);
+        }
+
+        double getArrivalRadius() const
+        {
+            return m_arrival.radius();
+        }
+
         /**
          * @brief Retrieves the current home base location.
          * @return The current home base location.
@@ -117,25 +140,25 @@ namespace commandstatemachine
          * @param subscriber A callback function to be triggered on state change.
          * @return A connection object for managing the subscription.
          */
-        boost::signals2::connection subscribeToState(const StateChangeSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToState(const StateChangeSignal::slot_type &subscriber);
 
         /**
          * @brief Subscribe to getting destination updates on path/ just an inner system funciton!
          * @param subscriber A callback function to be triggered on state change.
          * @return A connection object for managing the subscription.
          */
-        boost::signals2::connection subscribeToCurrentDestination(const CurrenitDestinationSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToCurrentDestination(const CurrenitDestinationSignal::slot_type &subscriber);
         /**
          * @brief Subscribe to path waypoint updates.
          * @param subscriber A callback function to be triggered when a new waypoint is reached.
          * @return A connection object for managing the subscription.
          */
-        boost::signals2::connection subscribeToPathWaypoint(const PathWayPoint::slot_type &subscriber);
+        drone_sdk::Connection subscribeToPathWaypoint(const PathWayPoint::slot_type &subscriber);
 
-        boost::signals2::connection subscribeToLandingSignal(const LandingSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToLandingSignal(const LandingSignal::slot_type &subscriber);
 
-        boost::signals2::connection subscribeToTakingOffSignal(const TakingOffSignal::slot_type &subscriber);
-        boost::signals2::connection subscribeToMission(const MissionChangeSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToTakingOffSignal(const TakingOffSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToMission(const MissionChangeSignal::slot_type &subscriber);
 
         /**
          * @brief Retrieves the current command state.
@@ -146,6 +169,14 @@ namespace commandstatemachine
             return m_currentState;
         }
 
+        /**
+         * @brief Retrieves the type of the mission assigned last.
+         */
+        drone_sdk::CurrentMission getCurrentMission() const
+        {
+            return m_currMission;
+        }
+
     private:
         /**
          * @brief Handles task aborted events due to safety conditions.
@@ -172,6 +203,25 @@ namespace commandstatemachine
          * @param newMission The new mission type to update.
          */
         void updateCurrentDestination(drone_sdk::Location newDestination);
+
+        /**
+         * @brief Makes the first waypoint of a path the destination and keeps the rest for later.
+         */
+        void startPath(drone_sdk::Path path);
+
+        /**
+         * @brief Makes the next waypoint of the path the destination.
+         */
+        void nextLeg();
+
+        /**
+         * @brief Sets the destination that arrival is detected against.
+         */
+        void setDestination(const drone_sdk::Location &destination)
+        {
+            m_destination = destination;
+            m_arrival.setTarget(destination);
+        }
         void takingOffCheck()
         {
             if (m_currLocation.altitude == m_home.altitude)
@@ -193,8 +243,11 @@ namespace commandstatemachine
         drone_sdk::CurrentMission m_currMission;     ///< Current mission type.
         drone_sdk::Location m_currLocation;          ///< Current GPS location of the drone.
         drone_sdk::Location m_destination;           ///< Current destination for the mission.
+        drone_sdk::geo::ArrivalDetector m_arrival;   ///< Arrival check against m_destination.
         drone_sdk::Location m_home;                  ///< Home base location.
-        std::queue<drone_sdk::Location> m_pathQueue; ///< Queue of waypoints for a PATH mission.
+        drone_sdk::Path m_path;                      ///< Waypoints still ahead in a PATH mission.
+        std::size_t m_legBegin = 0;                  ///< Original waypoints reached with m_destination,
+        std::size_t m_legEnd = 0;                    ///< as indices since path edits move the waypoints.
     };
 
 } // namespace commandstatemachine
@@ -2,61 +2,14 @@
 #define FLIGHT_STATE_MACHINE_HPP
 
 #include <boost/sml.hpp>
-#include <boost/signals2.hpp> // For signal2
+#include "signal.hpp" // For drone_sdk::Signal
 #include <iostream>
 #include "icd.hpp" // For SignalQuality and Location
+#include "state_machines/flight_states.hpp" // States and events, shared with DroneStateMachine
 
 namespace flightstatemachine
 {
 
-    /**
-     * @brief Events for the FlightStateMachine
-     * These events trigger transitions between states in the state machine.
-     */
-    struct TakeoffEvent
-    {
-    }; ///< Triggered to initiate takeoff.
-    struct AirborneEvent
-    {
-    }; ///< Triggered when the drone becomes airborne.
-    struct HoverEvent
-    {
-    }; ///< Triggered to transition to hover mode.
-    struct TaskCompleteEvent
-    {
-    }; ///< Triggered when the drone completes its task.
-    struct SafetyViolationEvent
-    {
-    }; ///< Triggered during a safety violation.
-    struct LandEvent
-    {
-    }; ///< Trrigerd when preformd landing after go home/ safty violation.
-    struct ReturnHomeEvent
-    {
-    };
-    /**
-     * @brief States for the FlightStateMachine
-     * These represent the possible states the drone can be in.
-     */
-    struct Landed
-    {
-    }; ///< The drone is on the ground.
-    struct Takeoff
-    {
-    }; ///< The drone is taking off.
-    struct Airborne
-    {
-    }; ///< The drone is flying normally.
-    struct Hover
-    {
-    }; ///< The drone is hovering in place.
-    struct EmergencyLand
-    {
-    }; ///< The drone is performing an emergency landing.
-    struct ReturnHome
-    {
-    }; ///< The drone is returning to its home location.
-
     /**
      * @brief Flight_SM represents the state machine logic and transitions.
      *
@@ -103,7 +56,7 @@ namespace flightstatemachine
         FlightStateMachine();
         ~FlightStateMachine() = default;
 
-        using StateChangedSignal = boost::signals2::signal<void(drone_sdk::FlightState)>;
+        using StateChangedSignal = drone_sdk::Signal<void(drone_sdk::FlightState)>;
 
         void handleCommandStateChange(drone_sdk::CommandStatus commadState);
         /**
@@ -119,7 +72,7 @@ namespace flightstatemachine
          * @return A connection object for managing the subscription.
          */
 
-        boost::signals2::connection subscribeToStateChange(const StateChangedSignal::slot_type &subscriber)
+        drone_sdk::Connection subscribeToStateChange(const StateChangedSignal::slot_type &subscriber)
         {
             return m_stateChangedSignal.connect(subscriber);
         }
@@ -5,7 +5,8 @@ namespace safetystatemachine
     SafetyStateMachine::SafetyStateMachine()
         : m_SM(),
           m_gpsState(drone_sdk::safetyState::GPS_HEALTH),
-          m_linkState(drone_sdk::safetyState::CONNECTED) {}
+          m_linkState(drone_sdk::safetyState::CONNECTED),
+          m_geofenceState(drone_sdk::safetyState::GEOFENCE_CLEAR) {}
 
     // Handle GPS signal events
     void SafetyStateMachine::handleGpsSignal(const drone_sdk::SignalQuality &gpsSignal)
@@ -33,18 +34,36 @@ namespace safetystatemachine
         }
     }
 
+    // Handle geofence check results
+    void SafetyStateMachine::handleGeofence(bool violated)
+    {
+        drone_sdk::safetyState prevGeofenceState = m_geofenceState;
+        m_SM.process_event(GeofenceCheck{violated});
+        updateCurrentState();
+        if (m_geofenceState != prevGeofenceState)
+        {
+            m_geofenceStateChangeSignal(m_geofenceState);
+        }
+    }
+
     // Subscribe to GPS state changes
-    boost::signals2::connection SafetyStateMachine::subscribeToGpsState(const StateChangeSignal::slot_type &subscriber)
+    drone_sdk::Connection SafetyStateMachine::subscribeToGpsState(const StateChangeSignal::slot_type &subscriber)
     {
         return m_gpsStateChangeSignal.connect(subscriber);
     }
 
     // Subscribe to Link state changes
-    boost::signals2::connection SafetyStateMachine::subscribeToLinkState(const StateChangeSignal::slot_type &subscriber)
+    drone_sdk::Connection SafetyStateMachine::subscribeToLinkState(const StateChangeSignal::slot_type &subscriber)
     {
         return m_linkStateChangeSignal.connect(subscriber);
     }
 
+    // Subscribe to geofence state changes
+    drone_sdk::Connection SafetyStateMachine::subscribeToGeofenceState(const StateChangeSignal::slot_type &subscriber)
+    {
+        return m_geofenceStateChangeSignal.connect(subscriber);
+    }
+
     // Get current GPS state
     drone_sdk::safetyState SafetyStateMachine::getCurrentGpsState() const
     {
@@ -57,6 +76,12 @@ namespace safetystatemachine
         return m_linkState;
     }
 
+    // Get current geofence state
+    drone_sdk::safetyState SafetyStateMachine::getCurrentGeofenceState() const
+    {
+        return m_geofenceState;
+    }
+
     // Update current states and notify if changes occur
     void SafetyStateMachine::updateCurrentState()
     {
@@ -78,6 +103,15 @@ namespace safetystatemachine
         {
             m_linkState = drone_sdk::safetyState::NOT_CONNECTED;
         }
+
+        if (m_SM.is(boost::sml::state<GeofenceClear>))
+        {
+            m_geofenceState = drone_sdk::safetyState::GEOFENCE_CLEAR;
+        }
+        else if (m_SM.is(boost::sml::state<GeofenceBreached>))
+        {
+            m_geofenceState = drone_sdk::safetyState::GEOFENCE_VIOLATED;
+        }
     }
 
 } // namespace safetystatemachine
@@ -2,60 +2,17 @@
 #define SAFETY_STATE_MACHINE_HPP
 
 #include <boost/sml.hpp>
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include <iostream>
 
 #include "gps/gps.hpp"
 #include "link/link.hpp"
 #include "icd.hpp"
+#include "state_machines/safety_states.hpp" // States and events, shared with DroneStateMachine
 
 namespace safetystatemachine
 {
 
-    /**
-     * @brief Event representing the current GPS signal quality.
-     */
-    struct GpsSignal
-    {
-        drone_sdk::SignalQuality quality; /**< Quality of the GPS signal. */
-    };
-
-    /**
-     * @brief Event representing the current link signal quality.
-     */
-    struct LinkSignal
-    {
-        drone_sdk::SignalQuality quality; /**< Quality of the link signal. */
-    };
-
-    /**
-     * @brief State representing a healthy GPS signal.
-     */
-    struct GpsHealthy
-    {
-    };
-
-    /**
-     * @brief State representing a loss of GPS signal.
-     */
-    struct GpsNotHealthy
-    {
-    };
-
-    /**
-     * @brief State representing a connected communication link.
-     */
-    struct ConnectionConnected
-    {
-    };
-
-    /**
-     * @brief State representing a disconnected communication link.
-     */
-    struct ConnectionDisconnected
-    {
-    };
-
     /**
      * @brief Safety state machine logic and transitions.
      */
@@ -78,9 +35,14 @@ namespace safetystatemachine
                 //dont allow reconnecting
                 // Link signal transitions
                 *state<ConnectionConnected> + event<LinkSignal>[([](const LinkSignal &ls)
-                                                                 { return ls.quality == drone_sdk::SignalQuality::NO_SIGNAL; })] = state<ConnectionDisconnected>
+                                                                 { return ls.quality == drone_sdk::SignalQuality::NO_SIGNAL; })] = state<ConnectionDisconnected>,
                 // state<ConnectionDisconnected> + event<LinkSignal>[([](const LinkSignal &ls)
                 //                                                    { return ls.quality != drone_sdk::SignalQuality::NO_SIGNAL; })] = state<ConnectionConnected>);
+                // Geofence transitions, clearing again once the drone left the zone
+                *state<GeofenceClear> + event<GeofenceCheck>[([](const GeofenceCheck &gc)
+                                                              { return gc.violated; })] = state<GeofenceBreached>,
+                state<GeofenceBreached> + event<GeofenceCheck>[([](const GeofenceCheck &gc)
+                                                                { return !gc.violated; })] = state<GeofenceClear>
             );
         }
     };
@@ -91,7 +53,7 @@ namespace safetystatemachine
     class SafetyStateMachine
     {
     public:
-        using StateChangeSignal = boost::signals2::signal<void(drone_sdk::safetyState)>; /**< Signal for state changes. */
+        using StateChangeSignal = drone_sdk::Signal<void(drone_sdk::safetyState)>; /**< Signal for state changes. */
 
         /**
          * @brief Constructor for the SafetyStateMachine.
@@ -110,19 +72,32 @@ namespace safetystatemachine
          */
         void handleLinkSignal(const drone_sdk::SignalQuality &linkSignal);
 
+        /**
+         * @brief Handle the geofence check of a GPS fix.
+         * @param violated True if the fix violates the geofence.
+         */
+        void handleGeofence(bool violated);
+
         /**
          * @brief Subscribe to GPS state changes.
          * @param subscriber A callback function to be triggered on GPS state changes.
          * @return A connection object for managing the subscription.
          */
-        boost::signals2::connection subscribeToGpsState(const StateChangeSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToGpsState(const StateChangeSignal::slot_type &subscriber);
 
         /**
          * @brief Subscribe to Link state changes.
          * @param subscriber A callback function to be triggered on Link state changes.
          * @return A connection object for managing the subscription.
          */
-        boost::signals2::connection subscribeToLinkState(const StateChangeSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToLinkState(const StateChangeSignal::slot_type &subscriber);
+
+        /**
+         * @brief Subscribe to geofence state changes.
+         * @param subscriber A callback function to be triggered on geofence state changes.
+         * @return A connection object for managing the subscription.
+         */
+        drone_sdk::Connection subscribeToGeofenceState(const StateChangeSignal::slot_type &subscriber);
 
         /**
          * @brief Get the current GPS state.
@@ -136,6 +111,12 @@ namespace safetystatemachine
          */
         drone_sdk::safetyState getCurrentLinkState() const;
 
+        /**
+         * @brief Get the current geofence state.
+         * @return GEOFENCE_CLEAR or GEOFENCE_VIOLATED.
+         */
+        drone_sdk::safetyState getCurrentGeofenceState() const;
+
     private:
         /**
          * @brief Update the current states and notify subscribers if changes occur.
@@ -146,9 +127,11 @@ namespace safetystatemachine
         boost::sml::sm<Safety_SM> m_SM;     /**< The underlying state machine object. */
         drone_sdk::safetyState m_gpsState;  /**< Current GPS state. */
         drone_sdk::safetyState m_linkState; /**< Current Link state. */
+        drone_sdk::safetyState m_geofenceState; /**< Current geofence state. */
 
         StateChangeSignal m_gpsStateChangeSignal;  /**< Signal for GPS state changes. */
         StateChangeSignal m_linkStateChangeSignal; /**< Signal for Link state changes. */
+        StateChangeSignal m_geofenceStateChangeSignal; /**< Signal for geofence state changes. */
     };
 
 } // namespace safetystatemachine
@@ -0,0 +1,66 @@
+// Cost per location of computing the distance from a reference point over a large batch,
+// e.g. a long path or telemetry history. Compares geo::distance() per location with the
+// batch kernel over a plain array of Location and over a structure-of-arrays LocationBatch.
+
+#include "location_batch.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kRounds = 50;
+
+    template <typename Kernel>
+    double nanosecondsPerLocation(std::vector<double> &out, Kernel kernel)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        double sum = 0.0;
+        for (int round = 0; round < kRounds; ++round)
+        {
+            kernel(out);
+            sum += out[static_cast<std::size_t>(round) % out.size()];
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        volatile double sink = sum; // Keeps the kernels from being optimized away
+        (void)sink;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               static_cast<double>(out.size() * kRounds);
+    }
+}
+
+int main()
+{
+    const drone_sdk::Location origin{32.0, 34.0, 50.0};
+
+    std::mt19937 generator(42);
+    std::normal_distribution<double> spread(0.0, 0.01);
+    std::normal_distribution<double> altitude(50.0, 5.0);
+    std::vector<drone_sdk::Location> locations;
+    for (int i = 0; i < 100000; ++i)
+    {
+        locations.emplace_back(origin.latitude + spread(generator), origin.longitude + spread(generator), altitude(generator));
+    }
+    const drone_sdk::LocationBatch locationBatch(locations);
+    std::vector<double> out(locations.size());
+
+    const double scalarNs = nanosecondsPerLocation(out, [&](std::vector<double> &distances)
+                                                   {
+                                                       for (std::size_t i = 0; i < locations.size(); ++i)
+                                                       {
+                                                           distances[i] = drone_sdk::geo::distance(origin, locations[i]);
+                                                       } });
+    const double arrayNs = nanosecondsPerLocation(out, [&](std::vector<double> &distances)
+                                                  { drone_sdk::batch::distances(drone_sdk::columns(locations), origin, distances); });
+    const double batchNs = nanosecondsPerLocation(out, [&](std::vector<double> &distances)
+                                                  { drone_sdk::batch::distances(locationBatch.columns(), origin, distances); });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "geo::distance each      " << std::setw(8) << scalarNs << " ns/location" << std::endl
+              << "kernel, Location array  " << std::setw(8) << arrayNs << " ns/location" << std::endl
+              << "kernel, LocationBatch   " << std::setw(8) << batchNs << " ns/location" << std::endl;
+    return 0;
+}
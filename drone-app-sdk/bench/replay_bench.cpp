@@ -0,0 +1,71 @@
+// Replay speed of a full day of telemetry (10 Hz GPS, 1 Hz link) through the state machines
+// as fast as possible, with missions given every ten minutes.
+
+#include "telemetry_replay.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kRounds = 3;
+    const auto kStart = std::chrono::steady_clock::time_point(std::chrono::hours(1000));
+}
+
+int main()
+{
+    using namespace std::chrono_literals;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> step(-1e-6, 1e-6);
+    std::uniform_int_distribution<int> quality(1, 4); // Never NO_SIGNAL, the safety regions stay healthy
+
+    std::vector<drone_sdk::TelemetrySample> samples;
+    drone_sdk::Location location(32.0, 34.0, 50.0);
+    for (int i = 0; i < 24 * 3600 * 10; ++i)
+    {
+        drone_sdk::TelemetrySample gps;
+        gps.timestamp = kStart + i * 100ms;
+        gps.quality = static_cast<drone_sdk::SignalQuality>(quality(generator));
+        location.latitude += step(generator);
+        location.longitude += step(generator);
+        gps.location = location;
+        samples.push_back(gps);
+        if (i % 10 == 0)
+        {
+            drone_sdk::TelemetrySample link;
+            link.timestamp = gps.timestamp;
+            link.source = drone_sdk::TelemetrySource::LINK;
+            link.quality = drone_sdk::SignalQuality::GOOD;
+            samples.push_back(link);
+        }
+    }
+
+    std::chrono::nanoseconds elapsed{0};
+    std::uint64_t digest = 0;
+    for (int round = 0; round < kRounds; ++round)
+    {
+        drone_sdk::TelemetryReplay replay;
+        for (auto when = kStart; when < samples.back().timestamp; when += 10min)
+        {
+            replay.schedule(when, [](StateMachineManager &manager)
+                            { manager.newTask(drone_sdk::CurrentMission::GOTO, drone_sdk::Location(32.01, 34.01, 50.0), std::nullopt); });
+        }
+        const drone_sdk::ReplayResult result = replay.run(samples);
+        elapsed += result.elapsed;
+        if (round > 0 && result.digest != digest)
+        {
+            std::cout << "replays differ\n";
+            return 1;
+        }
+        digest = result.digest;
+    }
+
+    const double seconds = std::chrono::duration<double>(elapsed).count() / kRounds;
+    std::cout << std::fixed << std::setprecision(2)
+              << "24 h of telemetry (" << samples.size() << " samples) replayed in " << seconds << " s, "
+              << std::setprecision(0) << 86400.0 / seconds << "x real time, digest " << std::hex << digest << "\n";
+    return 0;
+}
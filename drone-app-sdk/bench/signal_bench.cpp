@@ -0,0 +1,61 @@
+// Emission cost of drone_sdk::Signal against boost::signals2::signal.
+// Each run connects N subscribers that accumulate the emitted value and reports the average
+// time per emission, so the numbers include the per-slot call cost of both implementations.
+
+#include "signal.hpp"
+#include "icd.hpp"
+
+#include <boost/signals2.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    constexpr int kEmissions = 200000;
+    volatile std::uint64_t g_sink = 0; // Keeps the slots from being optimized away
+
+    template <typename SignalType>
+    double nanosecondsPerEmission(int subscribers)
+    {
+        SignalType signal;
+        for (int i = 0; i < subscribers; ++i)
+        {
+            signal.connect([](drone_sdk::Location location, drone_sdk::SignalQuality quality)
+                           { g_sink = g_sink + static_cast<std::uint64_t>(location.altitude) + static_cast<std::uint64_t>(quality); });
+        }
+
+        drone_sdk::Location location{32.0, 34.0, 100.0};
+        for (int i = 0; i < kEmissions / 10; ++i) // Warm up
+        {
+            signal(location, drone_sdk::SignalQuality::GOOD);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kEmissions; ++i)
+        {
+            signal(location, drone_sdk::SignalQuality::GOOD);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / kEmissions;
+    }
+}
+
+int main()
+{
+    using SdkSignal = drone_sdk::Signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
+    using BoostSignal = boost::signals2::signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
+
+    std::cout << std::setw(12) << "subscribers" << std::setw(16) << "signals2 ns" << std::setw(16) << "Signal ns"
+              << std::setw(10) << "speedup" << std::endl;
+    for (int subscribers : {1, 8, 64})
+    {
+        const double boostNs = nanosecondsPerEmission<BoostSignal>(subscribers);
+        const double sdkNs = nanosecondsPerEmission<SdkSignal>(subscribers);
+        std::cout << std::setw(12) << subscribers << std::fixed << std::setprecision(1)
+                  << std::setw(16) << boostNs << std::setw(16) << sdkNs
+                  << std::setw(9) << boostNs / sdkNs << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Events per second through the drone's state machines.
+// Compares the three separate machines wired through signals, as StateMachineManager used to
+// run them (kept under bench/legacy), with the single DroneStateMachine, on the same mix of GPS
+// samples, link samples and missions.
+//
+// bench/legacy holds the machines as they were just before the fusion, changed only to take
+// their states and events from the headers they now share with DroneStateMachine. That is not
+// the original SDK: they already emit drone_sdk::Signal instead of boost::signals2 and keep
+// their waypoints in a Path, so the numbers measure the fusion alone.
+
+#include "state_machines/command_state_machine.hpp"
+#include "state_machines/drone_state_machine.hpp"
+#include "state_machines/flight_state_machine.hpp"
+#include "state_machines/safety_state_machine.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kRounds = 20;
+
+    struct Sample
+    {
+        enum class Kind
+        {
+            GPS,
+            LINK,
+            GOTO
+        } kind;
+        drone_sdk::Location location;
+        drone_sdk::SignalQuality quality;
+    };
+
+    // The old StateMachineManager::start() wiring
+    struct SeparateMachines
+    {
+        flightstatemachine::FlightStateMachine flight;
+        safetystatemachine::SafetyStateMachine safety;
+        commandstatemachine::CommandStateMachine command;
+
+        SeparateMachines()
+        {
+            safety.subscribeToGpsState([this](drone_sdk::safetyState state)
+                                       { command.handleGpsStateChange(state); });
+            safety.subscribeToLinkState([this](drone_sdk::safetyState state)
+                                        { command.handleLinkStateChange(state); });
+            safety.subscribeToGeofenceState([this](drone_sdk::safetyState state)
+                                            { command.handleGeofenceStateChange(state); });
+            command.subscribeToState([this](drone_sdk::CommandStatus state)
+                                     { flight.handleCommandStateChange(state); });
+            command.subscribeToMission([this](drone_sdk::CurrentMission mission)
+                                       { flight.handleNewMission(mission); });
+        }
+
+        void run(const Sample &sample)
+        {
+            switch (sample.kind)
+            {
+            case Sample::Kind::GPS:
+                safety.handleGpsSignal(sample.quality);
+                safety.handleGeofence(false);
+                command.handleGpsLocationUpdate(sample.location);
+                break;
+            case Sample::Kind::LINK:
+                safety.handleLinkSignal(sample.quality);
+                break;
+            case Sample::Kind::GOTO:
+                command.handleTaskAssigned(drone_sdk::CurrentMission::GOTO, sample.location);
+                break;
+            }
+        }
+
+        int state() const
+        {
+            return static_cast<int>(flight.getCurrentState());
+        }
+    };
+
+    struct FusedMachine
+    {
+        dronestatemachine::DroneStateMachine machine;
+
+        void run(const Sample &sample)
+        {
+            switch (sample.kind)
+            {
+            case Sample::Kind::GPS:
+                machine.handleGpsSignal(sample.quality);
+                machine.handleGeofence(false);
+                machine.handleGpsLocationUpdate(sample.location);
+                break;
+            case Sample::Kind::LINK:
+                machine.handleLinkSignal(sample.quality);
+                break;
+            case Sample::Kind::GOTO:
+                machine.handleTaskAssigned(drone_sdk::CurrentMission::GOTO, sample.location);
+                break;
+            }
+        }
+
+        int state() const
+        {
+            return static_cast<int>(machine.getFlightState());
+        }
+    };
+
+    template <typename Machines>
+    double eventsPerSecond(const std::vector<Sample> &samples)
+    {
+        int states = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            // A fresh drone each round, the losses at the end of a round are permanent
+            Machines machines;
+            for (const auto &sample : samples)
+            {
+                machines.run(sample);
+            }
+            states += machines.state();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        volatile int sink = states; // Keeps the machines from being optimized away
+        (void)sink;
+        return static_cast<double>(samples.size() * kRounds) /
+               std::chrono::duration<double>(elapsed).count();
+    }
+}
+
+int main()
+{
+    // Mostly healthy GPS and link samples around a few missions, the signals drop out near the end
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(0.0, 0.01);
+    std::uniform_int_distribution<int> kind(0, 99);
+    std::vector<Sample> samples;
+    constexpr int kSamples = 200000;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        const int roll = kind(generator);
+        const auto quality = i > kSamples * 9 / 10 && roll < 5 ? drone_sdk::SignalQuality::NO_SIGNAL
+                                                                : drone_sdk::SignalQuality::GOOD;
+        const drone_sdk::Location location{coordinate(generator), coordinate(generator), 50.0};
+        if (roll < 70)
+        {
+            samples.push_back({Sample::Kind::GPS, location, quality});
+        }
+        else if (roll < 98)
+        {
+            samples.push_back({Sample::Kind::LINK, location, quality});
+        }
+        else
+        {
+            samples.push_back({Sample::Kind::GOTO, location, quality});
+        }
+    }
+
+    const double separate = eventsPerSecond<SeparateMachines>(samples);
+    const double fused = eventsPerSecond<FusedMachine>(samples);
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "three machines + signals  " << std::setw(12) << separate << " events/s" << std::endl
+              << "DroneStateMachine         " << std::setw(12) << fused << " events/s" << std::endl;
+    return 0;
+}
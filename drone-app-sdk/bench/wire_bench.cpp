@@ -0,0 +1,72 @@
+// Messages per second through the binary wire codec, against printing the same values as
+// text and parsing them back, which is what telemetry consumers did before.
+
+#include "wire_codec.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kRounds = 20;
+
+    template <typename RoundTrip>
+    double messagesPerSecond(const std::vector<drone_sdk::Location> &locations, RoundTrip roundTrip)
+    {
+        double sum = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const auto &location : locations)
+            {
+                sum += roundTrip(location).latitude;
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        volatile double sink = sum; // Keeps the round trips from being optimized away
+        (void)sink;
+        return static_cast<double>(locations.size() * kRounds) / std::chrono::duration<double>(elapsed).count();
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> latitude(-90.0, 90.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<double> altitude(0.0, 500.0);
+    std::vector<drone_sdk::Location> locations;
+    for (int i = 0; i < 100000; ++i)
+    {
+        locations.emplace_back(latitude(generator), longitude(generator), altitude(generator));
+    }
+
+    std::array<std::uint8_t, drone_sdk::wire::kFrameSize<drone_sdk::Location>> frame{};
+    const double binary = messagesPerSecond(locations, [&frame](const drone_sdk::Location &location)
+                                            {
+                                                (void)drone_sdk::wire::encode(location, frame);
+                                                return drone_sdk::wire::decode<drone_sdk::Location>(frame).value(); });
+
+    std::array<char, 96> line{};
+    const double text = messagesPerSecond(locations, [&line](const drone_sdk::Location &location)
+                                          {
+                                              std::snprintf(line.data(), line.size(), "%.9f %.9f %.3f", location.latitude,
+                                                            location.longitude, location.altitude);
+                                              char *end = line.data();
+                                              drone_sdk::Location parsed;
+                                              parsed.latitude = std::strtod(end, &end);
+                                              parsed.longitude = std::strtod(end, &end);
+                                              parsed.altitude = std::strtod(end, &end);
+                                              return parsed; });
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "binary frame (" << frame.size() << " B)  " << std::setw(12) << binary << " msg/s" << std::endl
+              << "text line            " << std::setw(12) << text << " msg/s" << std::endl;
+    return 0;
+}
@@ -19,8 +19,9 @@ int main()
     });
 
     // Subscribe to flight state changes
-    drone.subscribeToFlightState([](drone_sdk::FlightState state) {
-        std::cout << "Flight State Changed: " << static_cast<int>(state) << std::endl;
+    drone.subscribeToFlightState([](drone_sdk::FlightTransition transition) {
+        std::cout << "Flight State Changed: " << static_cast<int>(transition.from)
+                  << " -> " << static_cast<int>(transition.to) << std::endl;
     });
 
     // Subscribe to waypoint updates
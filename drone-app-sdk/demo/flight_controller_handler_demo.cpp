@@ -2,10 +2,13 @@
 #include "flight_controller_handler.hpp"  // Include the FlightControllerHandler class header
 
 void demoFlightControllerHandler() {
+    // Without a schedule the retries wait in place, so each completion runs before its command returns
     FlightControllerHandler flightControllerHandler;
+    auto status = drone_sdk::FlightControllerStatus::UNKNOWN_ERROR;
+    const auto keepStatus = [&status](drone_sdk::FlightControllerStatus result) { status = result; };
 
     std::cout << "Arming the flight controller..." << std::endl;
-    auto status = flightControllerHandler.arm();
+    flightControllerHandler.arm(keepStatus);
     if (status == drone_sdk::FlightControllerStatus::SUCCESS) {
         std::cout << "Flight controller armed successfully!" << std::endl;
     } else {
@@ -15,7 +18,7 @@ void demoFlightControllerHandler() {
 
     std::cout << "Taking off..." << std::endl;
     drone_sdk::Location loc {2,3,4};
-    status = flightControllerHandler.takeOff(loc);
+    flightControllerHandler.takeOff(loc, keepStatus);
     if (status == drone_sdk::FlightControllerStatus::SUCCESS) {
         std::cout << "Drone is airborne!" << std::endl;
     } else {
@@ -14,6 +14,14 @@ void linkUpdateCallback(drone_sdk::SignalQuality signalQuality) {
     std::cout << "Received Link update: Signal Quality: " << static_cast<int>(signalQuality) << std::endl;
 }
 
+// Print the deadline statistics of one sensor
+void printPollingStats(const char* sensor, const PollingStats& stats) {
+    std::cout << sensor << " polling: " << stats.ticks << " ticks, "
+              << stats.missedDeadlines << " missed deadlines, max jitter "
+              << stats.maxJitter.count() << " ns, max overrun "
+              << stats.maxOverrun.count() << " ns" << std::endl;
+}
+
 int main() {
     // Initialize HardwareMonitor (which contains both GPS and Link handlers)
     HardwareMonitor hwMonitor;
@@ -22,7 +30,9 @@ int main() {
     hwMonitor.subscribeToGpsUpdates(gpsUpdateCallback);
     hwMonitor.subscribeToLinkUpdates(linkUpdateCallback);
 
-    // Start polling at 10 Hz
+    // Poll GPS at 50 Hz and the link at 5 Hz, each sensor on its own schedule
+    hwMonitor.setGpsPollingRate(50.0);
+    hwMonitor.setLinkPollingRate(5.0);
     hwMonitor.start();
 
     // Run the demo for a limited time (5 seconds)
@@ -31,5 +41,13 @@ int main() {
     // Stop polling and end the demo
     hwMonitor.stop();
 
+    // Report how well the polling kept its deadlines
+    printPollingStats("GPS", hwMonitor.getGpsPollingStats());
+    printPollingStats("Link", hwMonitor.getLinkPollingStats());
+
+    RingStats gpsQueue = hwMonitor.getGpsQueueStats();
+    std::cout << "GPS queue: " << gpsQueue.pushed << " samples, " << gpsQueue.dropped
+              << " dropped, high-water mark " << gpsQueue.highWaterMark << "/" << gpsQueue.capacity << std::endl;
+
     return 0;
 }
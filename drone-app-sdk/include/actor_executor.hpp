@@ -0,0 +1,79 @@
+#ifndef ACTOR_EXECUTOR_HPP
+#define ACTOR_EXECUTOR_HPP
+
+#include "mpsc_inbox.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief One thread that owns some state and runs every message sent to it, one at a time.
+ *
+ * Messages go through a lock-free inbox, so the threads sending them (the GPS poller, the
+ * user) never block on each other or on the actor. Each message runs to completion before
+ * the next one starts, in the order they were sent from a given thread, so the state needs
+ * no lock as long as it is only touched from messages. Messages still in the inbox when the
+ * executor is destroyed run before its thread exits.
+ */
+class ActorExecutor
+{
+public:
+    ActorExecutor();
+    ~ActorExecutor();
+
+    ActorExecutor(const ActorExecutor &) = delete;
+    ActorExecutor &operator=(const ActorExecutor &) = delete;
+
+    /**
+     * @brief Sends a message whose result nobody waits for.
+     */
+    void post(std::move_only_function<void()> message);
+
+    /**
+     * @brief Sends a message, its result or exception is delivered through the returned future.
+     * @details From the actor thread itself the message runs right away, so a message may
+     *          call code that waits for the result without deadlocking.
+     */
+    template <typename Message>
+    std::future<std::invoke_result_t<Message>> call(Message &&message)
+    {
+        std::packaged_task<std::invoke_result_t<Message>()> task(std::forward<Message>(message));
+        auto result = task.get_future();
+        if (onActorThread())
+        {
+            task();
+        }
+        else
+        {
+            post(std::move(task));
+        }
+        return result;
+    }
+
+    bool onActorThread() const
+    {
+        return std::this_thread::get_id() == m_thread.get_id();
+    }
+
+    // Messages that have finished running
+    std::uint64_t processed() const
+    {
+        return m_processed.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run();
+
+    MpscInbox<std::move_only_function<void()>> m_inbox;
+    std::atomic<std::uint64_t> m_posted{0}; ///< Bumped after every push, the actor sleeps on it.
+    std::atomic<std::uint64_t> m_processed{0};
+    std::atomic<bool> m_stopping{false};
+    std::thread m_thread; ///< Started last, after the members it uses.
+};
+
+#endif // ACTOR_EXECUTOR_HPP
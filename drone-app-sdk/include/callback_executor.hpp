@@ -0,0 +1,219 @@
+#ifndef CALLBACK_EXECUTOR_HPP
+#define CALLBACK_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief What a subscriber queue does with a new event when it is full.
+ */
+enum class OverflowPolicy
+{
+    DROP_OLDEST,     ///< Discard the oldest queued event to make room.
+    COALESCE_LATEST, ///< Overwrite the newest queued event, the subscriber only misses intermediate values.
+    BLOCK            ///< Make the publisher wait for room. Never use it for a subscriber that publishes itself.
+};
+
+/**
+ * @brief How a callback is delivered when it runs on a CallbackExecutor.
+ */
+struct DeliveryOptions
+{
+    OverflowPolicy policy = OverflowPolicy::DROP_OLDEST;
+    std::size_t capacity = 64; ///< Maximum number of queued events, at least 1.
+    std::string name;          ///< Label reported in the queue statistics.
+};
+
+/**
+ * @brief Depth metrics of one subscriber queue.
+ */
+struct SubscriberQueueStats
+{
+    std::string name;
+    OverflowPolicy policy = OverflowPolicy::DROP_OLDEST;
+    std::size_t capacity = 0;
+    std::size_t depth = 0;         ///< Events waiting right now.
+    std::size_t highWaterMark = 0; ///< Deepest the queue has been.
+    std::uint64_t delivered = 0;   ///< Events handed to the callback.
+    std::uint64_t dropped = 0;     ///< Events discarded by DROP_OLDEST.
+    std::uint64_t coalesced = 0;   ///< Events overwritten by COALESCE_LATEST.
+    std::uint64_t blocked = 0;     ///< Publishes that had to wait under BLOCK.
+};
+
+/**
+ * @brief Runs subscriber callbacks away from the threads that publish the events.
+ *
+ * Every wrapped callback gets its own bounded queue. Publishing only copies the arguments into
+ * that queue, so a slow subscriber delays nobody but itself. Events of one subscriber are
+ * delivered in order and never concurrently; different subscribers share the worker threads.
+ * Events still queued when the executor is destroyed are discarded.
+ */
+class CallbackExecutor
+{
+public:
+    /**
+     * @brief Starts the delivery threads.
+     * @param threadCount Number of threads delivering callbacks.
+     */
+    explicit CallbackExecutor(std::size_t threadCount = 1);
+    ~CallbackExecutor();
+
+    CallbackExecutor(const CallbackExecutor &) = delete;
+    CallbackExecutor &operator=(const CallbackExecutor &) = delete;
+
+    /**
+     * @brief Wraps a callback so that calling the wrapper queues the event for this executor.
+     * @details The wrapper must not be called after the executor is destroyed.
+     */
+    template <typename... Args>
+    std::function<void(Args...)> wrap(std::function<void(Args...)> callback, DeliveryOptions options)
+    {
+        auto mailbox = std::make_shared<TypedMailbox<Args...>>(std::move(callback), std::move(options));
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_mailboxes.push_back(mailbox);
+        }
+        return [this, mailbox](Args... args)
+        {
+            if (mailbox->push(args...))
+            {
+                schedule(mailbox);
+            }
+        };
+    }
+
+    /**
+     * @brief Snapshot of the queue metrics of every wrapped callback.
+     */
+    std::vector<SubscriberQueueStats> queueStats() const;
+
+private:
+    // Per-subscriber queue, drained by at most one worker at a time
+    class Mailbox
+    {
+    public:
+        explicit Mailbox(DeliveryOptions options);
+        virtual ~Mailbox() = default;
+
+        // Deliver the oldest event, returns true when more are waiting
+        virtual bool deliverNext() = 0;
+
+        // Wake blocked publishers and refuse further events
+        void close();
+        SubscriberQueueStats stats() const;
+
+    protected:
+        // Make room for one more event according to the policy, expects m_mutex to be held.
+        // Returns false when the event must not be queued.
+        template <typename Queue>
+        bool admit(std::unique_lock<std::mutex> &lock, Queue &queue);
+
+        // Bookkeeping after an event was queued, returns true when the mailbox must be scheduled
+        bool queued(std::size_t depth);
+
+        // Bookkeeping after an event was taken out, returns true when more are waiting
+        bool taken(std::size_t depth);
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_spaceCondition; ///< BLOCK publishers wait for room.
+        SubscriberQueueStats m_stats;
+        bool m_scheduled = false; ///< Waiting in or being drained from the ready queue.
+        bool m_closed = false;
+    };
+
+    template <typename... Args>
+    class TypedMailbox : public Mailbox
+    {
+    public:
+        using Event = std::tuple<std::decay_t<Args>...>;
+
+        TypedMailbox(std::function<void(Args...)> callback, DeliveryOptions options)
+            : Mailbox(std::move(options)), m_callback(std::move(callback)) {}
+
+        // Returns true when the caller must schedule the mailbox
+        bool push(const std::decay_t<Args> &...args)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!admit(lock, m_events))
+            {
+                return false;
+            }
+            m_events.emplace_back(args...);
+            return queued(m_events.size());
+        }
+
+        bool deliverNext() override
+        {
+            Event event;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                event = std::move(m_events.front());
+                m_events.pop_front();
+                m_stats.depth = m_events.size();
+            }
+            m_spaceCondition.notify_one();
+
+            std::apply(m_callback, event);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return taken(m_events.size());
+        }
+
+    private:
+        std::function<void(Args...)> m_callback;
+        std::deque<Event> m_events;
+    };
+
+    void schedule(std::shared_ptr<Mailbox> mailbox);
+    void workerLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_readyCondition;
+    std::deque<std::shared_ptr<Mailbox>> m_ready;
+    std::vector<std::shared_ptr<Mailbox>> m_mailboxes;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
+
+template <typename Queue>
+bool CallbackExecutor::Mailbox::admit(std::unique_lock<std::mutex> &lock, Queue &queue)
+{
+    if (m_closed)
+    {
+        return false;
+    }
+    if (queue.size() < m_stats.capacity)
+    {
+        return true;
+    }
+
+    switch (m_stats.policy)
+    {
+    case OverflowPolicy::DROP_OLDEST:
+        queue.pop_front();
+        ++m_stats.dropped;
+        return true;
+    case OverflowPolicy::COALESCE_LATEST:
+        queue.pop_back();
+        ++m_stats.coalesced;
+        return true;
+    case OverflowPolicy::BLOCK:
+        ++m_stats.blocked;
+        m_spaceCondition.wait(lock, [this, &queue]()
+                              { return m_closed || queue.size() < m_stats.capacity; });
+        return !m_closed;
+    }
+    return false;
+}
+
+#endif // CALLBACK_EXECUTOR_HPP
@@ -0,0 +1,122 @@
+#ifndef COMMAND_COALESCER_HPP
+#define COMMAND_COALESCER_HPP
+
+#include "command_worker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Counters of a CommandCoalescer
+struct CoalescerStats
+{
+    std::uint64_t submitted = 0;  // Setpoints handed to submit()
+    std::uint64_t sent = 0;       // Setpoints sent to the flight controller
+    std::uint64_t superseded = 0; // Setpoints replaced or cancelled before they were sent
+};
+
+/**
+ * @brief Streams setpoints of one command type to the flight controller at a bounded rate.
+ *
+ * Only the latest setpoint waits to be sent: a newer one replaces it, so a burst of path
+ * waypoints or re-plans turns into one command per period carrying the newest target. Sending
+ * happens on the command worker, as a delayed job when the previous send was less than a
+ * period ago, so commands of other types are never held up by the rate limit.
+ */
+template <typename Setpoint>
+class CommandCoalescer
+{
+public:
+    using Clock = CommandWorker::Clock;
+    using Send = std::function<void(const Setpoint &)>;
+
+    /**
+     * @param worker Runs the sends, must outlive the jobs queued by this coalescer.
+     * @param send Sends one setpoint, called on the worker thread.
+     * @param rateHz Highest command rate, 0 or less for no limit.
+     */
+    CommandCoalescer(CommandWorker &worker, Send send, double rateHz)
+        : m_worker(worker), m_send(std::move(send))
+    {
+        setRate(rateHz);
+    }
+
+    CommandCoalescer(const CommandCoalescer &) = delete;
+    CommandCoalescer &operator=(const CommandCoalescer &) = delete;
+
+    void setRate(double rateHz)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interval = rateHz > 0.0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz))
+                                  : Clock::duration::zero();
+    }
+
+    // Queues a setpoint in place of the one still waiting, if any. Safe from any thread.
+    void submit(const Setpoint &setpoint)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        if (m_pending)
+        {
+            ++m_stats.superseded;
+        }
+        m_pending = setpoint;
+        if (!m_scheduled)
+        {
+            m_scheduled = true;
+            m_worker.postAt(std::max(Clock::now(), m_lastSent + m_interval), [this]()
+                            { flush(); });
+        }
+    }
+
+    // Drops the waiting setpoint, e.g. when a new mission makes it obsolete
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending)
+        {
+            ++m_stats.superseded;
+            m_pending.reset();
+        }
+    }
+
+    CoalescerStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+    void flush()
+    {
+        std::optional<Setpoint> setpoint;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_scheduled = false;
+            if (!m_pending)
+            {
+                return; // Cancelled meanwhile
+            }
+            setpoint = std::exchange(m_pending, std::nullopt);
+            m_lastSent = Clock::now();
+            ++m_stats.sent;
+        }
+        m_send(*setpoint);
+    }
+
+    CommandWorker &m_worker;
+    Send m_send;
+
+    mutable std::mutex m_mutex;
+    std::optional<Setpoint> m_pending;
+    bool m_scheduled = false; // A flush job is queued on the worker
+    Clock::time_point m_lastSent{};
+    Clock::duration m_interval{};
+    CoalescerStats m_stats;
+};
+
+#endif // COMMAND_COALESCER_HPP
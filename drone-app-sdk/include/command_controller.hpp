@@ -2,8 +2,13 @@
 #define COMMAND_CONTROLLER_HPP
 
 #include "icd.hpp"
+#include "command_worker.hpp" // Runs the flight controller commands
+#include "command_coalescer.hpp" // Rate limits destination updates
+#include "flight_recorder.hpp"
+#include "seqlock.hpp"
 #include <queue>
 #include <functional> // For std::function
+#include <future>
 
 // Include the real or mock flight controller handler based on DEBUG flag
 #ifdef DEBUG
@@ -15,17 +20,35 @@
 class CommandController
 {
 public:
-    CommandController() = default;
+    static constexpr double kDefaultCommandRateHz = 10.0;
+
+    CommandController()
+        : m_flightControllerHandler([this](CommandWorker::Clock::duration delay, std::move_only_function<void()> retry)
+                                    { m_worker.postAt(CommandWorker::Clock::now() + delay, std::move(retry)); }),
+          m_destinations(m_worker, [this](const drone_sdk::Location &destination)
+                         { m_flightControllerHandler.goTo(destination, recorded(drone_sdk::RecordedCommand::GOTO, destination, {})); },
+                         kDefaultCommandRateHz) {}
     ~CommandController() = default;
 
+    using Completion = std::function<void(drone_sdk::FlightControllerStatus)>;
+
     void start(drone_sdk::Location home);
+    // Blocking commands, they wait for the command worker
     drone_sdk::FlightControllerStatus goTo(const drone_sdk::Location &location);
     drone_sdk::FlightControllerStatus abortMission();
     drone_sdk::FlightControllerStatus hover();
+    // Asynchronous commands, the caller never waits on flight controller I/O.
+    // Completions run on the command worker thread, once the retries of the command are over.
+    std::future<drone_sdk::FlightControllerStatus> goToAsync(const drone_sdk::Location &location);
+    void goToAsync(const drone_sdk::Location &location, Completion done);
+    std::future<drone_sdk::FlightControllerStatus> abortMissionAsync();
+    void abortMissionAsync(Completion done);
+    std::future<drone_sdk::FlightControllerStatus> hoverAsync();
+    void hoverAsync(Completion done);
     drone_sdk::FlightControllerStatus path(drone_sdk::Location firstPoint); // rest will get straight from the sm command machine
     void handleDestinationChange(drone_sdk::Location newDestination);
     void handleCommandState(drone_sdk::CommandStatus commandState);
-    drone_sdk::FlightControllerStatus takingOff(drone_sdk::Location location);
+    void takingOff(drone_sdk::Location location, drone_sdk::Retrier::Done done);
 
     void setHome(drone_sdk::Location newHome)
     {
@@ -33,7 +56,30 @@ public:
     }
     void updateCurrentLocation(const drone_sdk::Location &location)
     {
-        m_currentLocation = location;
+        m_currentLocation.store(location);
+    }
+    // Safe from any thread, the handler keeps both in seqlocks
+    void setRetryPolicy(const drone_sdk::RetryPolicy &policy)
+    {
+        m_flightControllerHandler.setRetryPolicy(policy);
+    }
+    drone_sdk::RetryMetrics retryMetrics() const
+    {
+        return m_flightControllerHandler.retryMetrics();
+    }
+    // Highest rate of destination updates sent to the flight controller, 0 for no limit
+    void setCommandRate(double rateHz)
+    {
+        m_destinations.setRate(rateHz);
+    }
+    CoalescerStats destinationStats() const
+    {
+        return m_destinations.stats();
+    }
+    // Records every flight controller command and its result, set before sending commands
+    void setFlightRecorder(drone_sdk::FlightRecorder *recorder)
+    {
+        m_recorder = recorder;
     }
 
 private:
@@ -47,7 +93,34 @@ private:
     drone_sdk::Location m_homebase;
     bool m_onPath;
     bool m_onLand;
-    drone_sdk::Location m_currentLocation;
+    SeqLock<drone_sdk::Location> m_currentLocation; // Written by the GPS thread, read by the command callers
+    drone_sdk::FlightRecorder *m_recorder = nullptr;
+    CommandCoalescer<drone_sdk::Location> m_destinations; // Uses m_worker, which drains its flushes before this goes away
+    CommandWorker m_worker; // Last, so it finishes its jobs and pending retries before the handler goes away
+
+    using Done = drone_sdk::Retrier::Done;
+    using Command = std::move_only_function<void(Done)>;
+
+    // Arm, take off if landed, then go: each step starts from the completion of the one before
+    void flyTo(const drone_sdk::Location &location, Done done);
+
+    // Starts @p command on the worker, it reports to @p done once its retries are over
+    void dispatch(Command command, Done done);
+    std::future<drone_sdk::FlightControllerStatus> dispatch(Command command);
+
+    // Records the status for @p command before passing it on to @p done, which may be empty
+    Done recorded(drone_sdk::RecordedCommand command, const drone_sdk::Location &target, Done done);
+
+    // Passes @p status through, recording it for @p command when a recorder is set
+    drone_sdk::FlightControllerStatus recordCommand(drone_sdk::RecordedCommand command, drone_sdk::FlightControllerStatus status,
+                                                    const drone_sdk::Location &target = {})
+    {
+        if (m_recorder)
+        {
+            m_recorder->recordCommand(command, status, target);
+        }
+        return status;
+    }
 
     // Callbacks
     void onCommandStateChanged(drone_sdk::CommandStatus commandState);
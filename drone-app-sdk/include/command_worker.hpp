@@ -0,0 +1,84 @@
+#ifndef COMMAND_WORKER_HPP
+#define COMMAND_WORKER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief One thread that runs the flight controller commands of a drone, in submission order.
+ *
+ * Callers only queue a job and get a future or a completion callback back, so no thread
+ * outside the worker ever waits on flight controller I/O. A job may issue several commands
+ * back to back (arm, take off, go to) without a round trip to its caller. Jobs still queued
+ * when the worker is destroyed run before its thread exits, so a final land is not lost;
+ * delayed jobs then run without waiting for their time.
+ */
+class CommandWorker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CommandWorker();
+    ~CommandWorker();
+
+    CommandWorker(const CommandWorker &) = delete;
+    CommandWorker &operator=(const CommandWorker &) = delete;
+
+    /**
+     * @brief Queues a job whose result nobody waits for.
+     */
+    void post(std::move_only_function<void()> job);
+
+    /**
+     * @brief Queues a job to run once @p due has passed, after the jobs queued by then.
+     * @details Delayed jobs wait without holding up the ones posted meanwhile.
+     */
+    void postAt(Clock::time_point due, std::move_only_function<void()> job);
+
+    /**
+     * @brief Queues a job, its result or exception is delivered through the returned future.
+     */
+    template <typename Job>
+    std::future<std::invoke_result_t<Job>> submit(Job &&job)
+    {
+        std::packaged_task<std::invoke_result_t<Job>()> task(std::forward<Job>(job));
+        auto result = task.get_future();
+        post(std::move(task));
+        return result;
+    }
+
+    /**
+     * @brief Queues a job and calls @p done with its result on the worker thread.
+     * @details @p done should be short, it delays the commands queued behind it.
+     */
+    template <typename Job, typename Done>
+    void submit(Job &&job, Done &&done)
+    {
+        post([job = std::forward<Job>(job), done = std::forward<Done>(done)]() mutable
+             { done(job()); });
+    }
+
+    // Jobs waiting, delayed ones included, not counting the one running
+    std::size_t pending() const;
+
+private:
+    void run();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::move_only_function<void()>> m_jobs;
+    std::multimap<Clock::time_point, std::move_only_function<void()>> m_delayed; ///< By due time, FIFO on ties.
+    bool m_stopping = false;
+    std::thread m_thread; ///< Started last, after the members it uses.
+};
+
+#endif // COMMAND_WORKER_HPP
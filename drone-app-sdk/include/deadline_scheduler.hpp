@@ -0,0 +1,132 @@
+#ifndef DEADLINE_SCHEDULER_HPP
+#define DEADLINE_SCHEDULER_HPP
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+// Timing statistics of a periodic task, as collected by DeadlineScheduler
+struct PollingStats
+{
+    std::uint64_t ticks = 0;                  // Number of executed ticks
+    std::uint64_t missedDeadlines = 0;        // Periods skipped because a tick ran past the next deadline
+    std::chrono::nanoseconds lastOverrun{0};  // How far the last tick ran past the end of its period
+    std::chrono::nanoseconds maxOverrun{0};   // Worst overrun seen so far
+    std::chrono::nanoseconds lastJitter{0};   // Wake-up lateness of the last tick against its deadline
+    std::chrono::nanoseconds maxJitter{0};    // Worst wake-up lateness seen so far
+    std::chrono::nanoseconds meanJitter{0};   // Average wake-up lateness over all ticks
+};
+
+// Keeps a periodic task on an absolute time grid.
+// Deadlines are computed as start + n * period, so the time spent inside a tick never
+// stretches the period. A tick that overruns skips the deadlines it missed (they are
+// counted, not replayed) and the task stays in phase with the original grid.
+class DeadlineScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit DeadlineScheduler(Clock::duration period)
+        : m_period(period), m_nextDeadline(Clock::now()) {}
+
+    // Convert a rate in Hz to the matching period, throws std::invalid_argument unless the rate
+    // is positive and finite
+    static Clock::duration periodFromRate(double rateHz)
+    {
+        if (!(rateHz > 0.0) || std::isinf(rateHz))
+        {
+            throw std::invalid_argument("Rate must be positive and finite");
+        }
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    }
+
+    void setPeriod(Clock::duration period)
+    {
+        m_period = period;
+    }
+
+    Clock::duration getPeriod() const
+    {
+        return m_period;
+    }
+
+    // Place the first deadline at 'start' and clear the statistics
+    void reset(Clock::time_point start = Clock::now())
+    {
+        m_nextDeadline = start;
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats = PollingStats{};
+        m_jitterSum = Clock::duration::zero();
+    }
+
+    Clock::time_point nextDeadline() const
+    {
+        return m_nextDeadline;
+    }
+
+    bool isDue(Clock::time_point now) const
+    {
+        return now >= m_nextDeadline;
+    }
+
+    // Record the start of a tick that was due at nextDeadline()
+    void beginTick(Clock::time_point now)
+    {
+        m_tickDeadline = m_nextDeadline;
+        const auto jitter = now > m_tickDeadline ? now - m_tickDeadline : Clock::duration::zero();
+
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.ticks;
+        m_jitterSum += jitter;
+        m_stats.lastJitter = jitter;
+        if (jitter > m_stats.maxJitter)
+        {
+            m_stats.maxJitter = jitter;
+        }
+        m_stats.meanJitter = m_jitterSum / static_cast<Clock::rep>(m_stats.ticks);
+    }
+
+    // Record the end of the current tick and advance to the next deadline on the grid
+    void endTick(Clock::time_point now)
+    {
+        const auto periodEnd = m_tickDeadline + m_period;
+        const auto overrun = now > periodEnd ? now - periodEnd : Clock::duration::zero();
+
+        // Skip every deadline that already passed, keeping the original phase
+        std::uint64_t missed = 0;
+        m_nextDeadline = periodEnd;
+        if (now > m_nextDeadline && m_period > Clock::duration::zero())
+        {
+            missed = static_cast<std::uint64_t>((now - m_nextDeadline) / m_period) + 1;
+            m_nextDeadline += m_period * static_cast<Clock::rep>(missed);
+        }
+
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats.missedDeadlines += missed;
+        m_stats.lastOverrun = overrun;
+        if (overrun > m_stats.maxOverrun)
+        {
+            m_stats.maxOverrun = overrun;
+        }
+    }
+
+    // Thread safe copy of the statistics collected so far
+    PollingStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        return m_stats;
+    }
+
+private:
+    Clock::duration m_period;          // Distance between two deadlines
+    Clock::time_point m_nextDeadline;  // Absolute time of the next tick
+    Clock::time_point m_tickDeadline;  // Deadline of the tick currently running
+
+    mutable std::mutex m_statsMutex;   // Guards the statistics, read from other threads
+    PollingStats m_stats;
+    Clock::duration m_jitterSum = Clock::duration::zero();
+};
+
+#endif // DEADLINE_SCHEDULER_HPP
@@ -10,14 +10,26 @@
 #else
 #include "hw_monitor.hpp" // Use actual HardwareMonitor otherwise
 #endif
+#include "fleet_runtime.hpp" // For FleetRuntime
+#include "seqlock.hpp"       // For the telemetry snapshot
+#include "path.hpp"          // For drone_sdk::Path
+#include "mission_queue.hpp" // For queued missions
+#include "location_history.hpp" // For the recorded GPS history
+#include "actor_executor.hpp"   // Runs the state machines
+#include "flight_recorder.hpp"  // Black box of the state machines and commands
 
 #include <queue> // for path, should go to icd
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <string>
 
 class DroneController
 {
 public:
     DroneController();
+    explicit DroneController(FleetRuntime &fleet); // Poll hardware on a runtime shared by many drones
     ~DroneController();
 
     // Command actions
@@ -25,15 +37,51 @@ public:
     drone_sdk::FlightControllerStatus abortMission();
     drone_sdk::FlightControllerStatus hover();
     drone_sdk::FlightControllerStatus path(std::queue<drone_sdk::Location>);
+    drone_sdk::FlightControllerStatus path(drone_sdk::Path path);
+    // Asynchronous commands return right away: the state machines accept or reject the task on
+    // their actor, the flight controller commands then run on the command worker. A rejection
+    // completes on the actor thread, so a state callback must not wait for these futures
+    std::future<drone_sdk::FlightControllerStatus> goToAsync(const drone_sdk::Location &location);
+    void goToAsync(const drone_sdk::Location &location, CommandController::Completion done);
+    std::future<drone_sdk::FlightControllerStatus> abortMissionAsync();
+    void abortMissionAsync(CommandController::Completion done);
+    std::future<drone_sdk::FlightControllerStatus> hoverAsync();
+    void hoverAsync(CommandController::Completion done);
+    // Edits of the running path, without restarting the mission
+    drone_sdk::FlightControllerStatus appendWaypoints(std::span<const drone_sdk::Location> waypoints);
+    drone_sdk::FlightControllerStatus replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints);
+    drone_sdk::FlightControllerStatus truncatePath(std::size_t endIndex);
+    void setArrivalRadius(double radiusMeters);
+    void setPathSimplification(double toleranceMeters); // 0 flies every waypoint
+    void setGeofence(std::shared_ptr<const drone_sdk::Geofence> geofence); // nullptr removes it
+    void setLocationHistory(std::shared_ptr<drone_sdk::LocationHistory> history); // Records every GPS update, nullptr stops
+    void setRetryPolicy(const drone_sdk::RetryPolicy &policy); // For transient flight controller failures
+    drone_sdk::RetryMetrics retryMetrics() const;
+    void setCommandRate(double rateHz);          // Destination updates per second at most, 0 for no limit
+    CoalescerStats destinationCommandStats() const; // Destination updates sent and superseded
+    std::uint64_t suppressedStateEvents() const;    // State machine events that changed no state
+    // The flight recorder is dumped into this directory on MISSION_ABORT and EMERGENCY_LAND
+    void setFlightRecorderDirectory(const std::string &directory);
+    void dumpFlightRecorder(const std::string &filename) const; // Throws std::runtime_error
 
-    // Subscription functions
-    void subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback);
-    void subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback);
+    // Mission queue, the next mission starts as soon as a GOTO or PATH mission completes
+    drone_sdk::FlightControllerStatus enqueueMission(drone_sdk::Mission mission);
+    drone_sdk::FlightControllerStatus insertMissionFront(drone_sdk::Mission mission);
+    void clearMissions();
+    std::size_t queuedMissions() const;
+
+    // Subscription functions, the state callbacks only run on real transitions
+    void subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback);
+    void subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback);
+    void subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback);
     void subscribeToGpsLocation(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback);
-    void subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback);
-    void subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback);
+    void subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback);
+    void subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback);
     void subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback);
 
+    // Latest telemetry, safe to call from any thread at any rate
+    drone_sdk::TelemetrySnapshot snapshot() const;
+
 #ifdef DEBUG_MODE
     // Functions for loading and running mock data in debug mode
     void loadMockGpsData(const std::queue<drone_sdk::Location> &locations, const std::queue<drone_sdk::SignalQuality> &qualities);
@@ -42,13 +90,42 @@ public:
     void stopMockData();
 #endif
 private:
+    void connectComponents(); // Starts the state machines and wires the monitor to them
+    void wireStateMachines(); // The part of connectComponents() run on m_actor
+
+    drone_sdk::FlightControllerStatus startPath(drone_sdk::Path path); // Flies an already simplified path
+    drone_sdk::FlightControllerStatus prepareMission(drone_sdk::Mission &mission); // Simplifies and validates
+    void startIfIdle(); // Starts the next queued mission if nothing flies, waits for m_actor
+
+    // Run on m_actor
+    drone_sdk::FlightControllerStatus startMission(drone_sdk::Mission mission); // Does not wait for the flight controller
+    void handleCommandState(const drone_sdk::CommandTransition &transition);
+    void startNextMission(); // Starts queued missions until one is accepted
+
+    // Apply a change to the published telemetry and stamp it
+    template <typename Change>
+    void updateTelemetry(Change &&change)
+    {
+        m_telemetry.modify([&change](drone_sdk::TelemetrySnapshot &snapshot)
+                           {
+                               change(snapshot);
+                               snapshot.timestamp = std::chrono::steady_clock::now();
+                               ++snapshot.version; });
+    }
+
 #ifdef DEBUG_MODE
     MockHwMonitor m_hwMonitor; // Mock hardware monitor for debugging
 #else
     HardwareMonitor m_hwMonitor; // Actual hardware monitor
 #endif
+    drone_sdk::FlightRecorder m_recorder;      // Before the components recording into it
     StateMachineManager m_stateMachineManager; // Manages state transitions for the drone
     CommandController m_commandController;     // Manages commands
+    SeqLock<drone_sdk::TelemetrySnapshot> m_telemetry; // Latest telemetry for snapshot()
+    double m_pathTolerance = 0.0;                      // Douglas-Peucker tolerance for path(), 0 is off
+    drone_sdk::MissionQueue m_missions;                // Missions waiting for the current one to complete
+    std::atomic<std::shared_ptr<drone_sdk::LocationHistory>> m_history;        // Fed from the GPS thread
+    ActorExecutor m_actor; // The only thread touching m_stateMachineManager, declared last so it stops first
 };
 
 #endif // DRONE_CONTROLLER_HPP
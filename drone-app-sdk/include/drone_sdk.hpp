@@ -2,8 +2,13 @@
 #define DRONE_SDK_HPP
 
 #include "drone_controller.hpp" // For DroneController
+#include "callback_executor.hpp" // For asynchronous callback delivery
 #include "icd.hpp"              // For various drone-related types (Location, SignalQuality, etc.)
+#include <cstdint>
 #include <memory>               // For smart pointers
+#include <mutex>
+#include <future>               // For the asynchronous commands
+#include <string>
 
 /**
  * @brief The DroneSDK class is responsible for managing the drone's actions and states.
@@ -14,12 +19,19 @@ class DroneSDK
 {
 public:
     DroneSDK();
+
+    /**
+     * @brief Creates a drone whose hardware polling runs on a runtime shared with other drones.
+     * @param fleet The shared runtime, must outlive this object.
+     */
+    explicit DroneSDK(FleetRuntime &fleet);
     ~DroneSDK() = default;
 
     DroneSDK(const DroneSDK &) = delete;
     DroneSDK &operator=(const DroneSDK &) = delete;
     DroneSDK(DroneSDK &&) noexcept = default;
-    DroneSDK &operator=(DroneSDK &&) noexcept = default;
+    // Stops the drone being replaced before its callback executor goes away
+    DroneSDK &operator=(DroneSDK &&other) noexcept;
 
     /**
      * @brief Commands the drone to move to the specified location.
@@ -40,6 +52,34 @@ public:
      */
     drone_sdk::FlightControllerStatus hover();
 
+    /**
+     * @brief Like goTo(), without waiting for the flight controller.
+     * @details Returns right away. The drone's state machine thread accepts or rejects the
+     *          task in order with the sensor updates; arming, take off and the go to command
+     *          then run back to back on the drone's command thread.
+     * @retval std::future The status of the flight once the commands are done.
+     */
+    std::future<drone_sdk::FlightControllerStatus> goToAsync(const drone_sdk::Location &location);
+
+    /**
+     * @brief Like goToAsync(), reporting the status to @p done instead.
+     * @param done Called once with the status, on the command thread or, for a rejected
+     *        task, on the state machine thread. Keep it short, later commands wait for it.
+     */
+    void goToAsync(const drone_sdk::Location &location, std::function<void(drone_sdk::FlightControllerStatus)> done);
+
+    /**
+     * @brief Like abortMission(), without waiting for the flight controller.
+     */
+    std::future<drone_sdk::FlightControllerStatus> abortMissionAsync();
+    void abortMissionAsync(std::function<void(drone_sdk::FlightControllerStatus)> done);
+
+    /**
+     * @brief Like hover(), without waiting for the flight controller.
+     */
+    std::future<drone_sdk::FlightControllerStatus> hoverAsync();
+    void hoverAsync(std::function<void(drone_sdk::FlightControllerStatus)> done);
+
     /**
      * @brief Commands the drone to follow a path consisting of multiple locations.
      * @param locations A queue of locations that the drone will follow in sequence.
@@ -47,17 +87,159 @@ public:
      */
     drone_sdk::FlightControllerStatus path(std::queue<drone_sdk::Location> locations);
 
+    /**
+     * @brief Commands the drone to follow a path without copying its waypoints.
+     * @param path The waypoints, moved in and consumed in place by the mission.
+     * @retval FlightControllerStatus The status of the first destination in path.
+     */
+    drone_sdk::FlightControllerStatus path(drone_sdk::Path path);
+
+    /**
+     * @brief Adds waypoints to the end of the running path mission.
+     * @details The path is edited in place: the mission is not restarted, no state change is
+     *          signalled and the current destination is kept. Added waypoints are not simplified.
+     * @retval FlightControllerStatus INVALID_COMMAND without a running path mission,
+     *         GEOFENCE_VIOLATION if a new leg crosses the geofence, SUCCESS otherwise.
+     */
+    drone_sdk::FlightControllerStatus appendWaypoints(std::span<const drone_sdk::Location> waypoints);
+
+    /**
+     * @brief Replaces the waypoints of the running path mission from @p fromIndex on, in place.
+     * @param fromIndex Index into the waypoints the path was given, must not be reached yet.
+     * @retval FlightControllerStatus As for appendWaypoints(), INVALID_COMMAND also for a bad index.
+     */
+    drone_sdk::FlightControllerStatus replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints);
+
+    /**
+     * @brief Drops the waypoints of the running path mission from @p endIndex on, in place.
+     * @retval FlightControllerStatus INVALID_COMMAND without a running path mission or for a bad index.
+     */
+    drone_sdk::FlightControllerStatus truncatePath(std::size_t endIndex);
+
+    /**
+     * @brief Sets how close the drone must get to a destination or waypoint for it to count as reached.
+     * @param radiusMeters Radius of the arrival sphere in meters (default 2 m).
+     */
+    void setArrivalRadius(double radiusMeters);
+
+    /**
+     * @brief Simplifies paths before flying them, see drone_sdk::simplifyPath().
+     * @details Waypoints within the tolerance of a straight leg are not commanded, but are still
+     *          reported to waypoint subscribers once the drone passes them.
+     * @param toleranceMeters Allowed deviation from the original path in meters, 0 (the default) disables it.
+     */
+    void setPathSimplification(double toleranceMeters);
+
+    /**
+     * @brief Sets the no-fly zones and altitude ceiling the drone must respect.
+     * @details Missions crossing the geofence are rejected with GEOFENCE_VIOLATION, and a GPS
+     *          fix inside it aborts the current mission. One geofence can be shared by a fleet.
+     * @param geofence The geofence, or nullptr to remove it.
+     */
+    void setGeofence(std::shared_ptr<const drone_sdk::Geofence> geofence);
+
+    /**
+     * @brief Records every GPS update of the drone into a compressed history.
+     * @details The history stays readable by the caller while it is being filled, see
+     *          drone_sdk::LocationHistory::range() and drone_sdk::LocationHistory::downsample().
+     * @param history The history to append to, or nullptr to stop recording.
+     */
+    void setLocationHistory(std::shared_ptr<drone_sdk::LocationHistory> history);
+
+    /**
+     * @brief Sets how CONNECTION_ERROR and HARDWARE_ERROR responses of the flight controller are retried.
+     * @details Retries back off exponentially with jitter within a per command deadline. Take
+     *          off is never repeated, as a lost response may hide a climb already under way.
+     * @param policy The policy, drone_sdk::RetryPolicy::none() reports the first failure.
+     */
+    void setRetryPolicy(const drone_sdk::RetryPolicy &policy);
+
+    /**
+     * @brief Counts of retried, recovered and failed commands and the time spent retrying.
+     */
+    drone_sdk::RetryMetrics retryMetrics() const;
+
+    /**
+     * @brief Limits how often destination updates (path waypoints, re-plans) are sent to the flight controller.
+     * @details Updates arriving faster replace the one still waiting, so the flight controller
+     *          always gets the newest destination. Defaults to 10 Hz.
+     * @param rateHz Highest number of updates per second, 0 or less for no limit.
+     */
+    void setCommandRate(double rateHz);
+
+    /**
+     * @brief Counts of destination updates submitted, sent and superseded before being sent.
+     */
+    CoalescerStats destinationCommandStats() const;
+
+    /**
+     * @brief Number of state machine events, mostly GPS and link samples, that changed no state
+     *        and so called no state callback.
+     */
+    std::uint64_t suppressedStateEvents() const;
+
+    /**
+     * @brief Sets where the flight recorder is dumped when a mission aborts or the drone lands
+     *        for an emergency, the system temporary directory by default.
+     * @details The recorder keeps the latest state machine events, state transitions, GPS and
+     *          link samples and flight controller commands. Each dump is a new file, see
+     *          drone_sdk::FlightRecorderFileHeader and drone_sdk::FlightRecorder::load().
+     * @param directory An existing directory.
+     */
+    void setFlightRecorderDirectory(const std::string &directory);
+
+    /**
+     * @brief Writes the content of the flight recorder to @p filename right away.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void dumpFlightRecorder(const std::string &filename) const;
+
+    /**
+     * @brief Queues a GOTO or PATH mission to fly after the ones already queued.
+     * @details The mission is simplified and checked against the geofence right away. When a
+     *          GOTO or PATH mission completes, the next queued mission is started without a
+     *          round trip to the caller. If the drone is idle, the queue starts immediately.
+     *          Hover, return home and aborts leave the queue on hold until the next enqueue.
+     * @param mission The mission, see drone_sdk::Mission::goTo() and drone_sdk::Mission::followPath().
+     * @retval FlightControllerStatus SUCCESS if queued, INVALID_COMMAND or GEOFENCE_VIOLATION otherwise.
+     */
+    drone_sdk::FlightControllerStatus enqueueMission(drone_sdk::Mission mission);
+
+    /**
+     * @brief Queues a mission to fly next, ahead of the ones already queued.
+     * @retval FlightControllerStatus SUCCESS if queued, INVALID_COMMAND or GEOFENCE_VIOLATION otherwise.
+     */
+    drone_sdk::FlightControllerStatus insertMissionFront(drone_sdk::Mission mission);
+
+    /**
+     * @brief Drops all queued missions, the current mission continues.
+     */
+    void clearMissions();
+
+    /**
+     * @brief Number of missions waiting in the queue.
+     */
+    std::size_t queuedMissions() const;
+
     /**
      * @brief Subscribes to GPS signal state changes.
+     * @details Like every state subscription below, the callback only runs when the state really
+     *          changed and gets the previous state, the new one and the time of the change.
      * @param callback A callback function that will be invoked when the GPS signal state changes.
      */
-    void subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback);
+    void subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback);
 
     /**
      * @brief Subscribes to link signal state changes.
      * @param callback A callback function that will be invoked when the link signal state changes.
      */
-    void subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback);
+    void subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback);
+
+    /**
+     * @brief Subscribes to geofence state changes.
+     * @param callback A callback function that will be invoked on changes between GEOFENCE_CLEAR and GEOFENCE_VIOLATED.
+     */
+    void subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback);
 
     /**
      * @brief Subscribes to GPS location updates.
@@ -70,13 +252,13 @@ public:
      * @brief Subscribes to flight state changes.
      * @param callback A callback function that will be invoked when the flight state changes.
      */
-    void subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback);
+    void subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback);
 
     /**
      * @brief Subscribes to command state changes.
      * @param callback A callback function that will be invoked when the command state changes.
      */
-    void subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback);
+    void subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback);
 
     /**
      * @brief Subscribes to waypoint updates.
@@ -84,7 +266,51 @@ public:
      */
     void subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback);
 
+    /**
+     * @brief Asynchronous variants of the subscriptions above.
+     * @details The callback runs on a dedicated delivery thread instead of the thread that
+     *          produced the event, through a bounded queue configured by @p options, so a slow
+     *          callback cannot stall telemetry polling or safety evaluation.
+     * @param callback The callback function.
+     * @param options Queue capacity, overflow policy and the name used in callbackQueueStats().
+     */
+    void subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options);
+    void subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options);
+    void subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options);
+    void subscribeToGpsLocation(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback, DeliveryOptions options);
+    void subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback, DeliveryOptions options);
+    void subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback, DeliveryOptions options);
+    void subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback, DeliveryOptions options);
+
+    /**
+     * @brief Queue depth metrics of every asynchronous subscription.
+     */
+    std::vector<SubscriberQueueStats> callbackQueueStats() const;
+
+    /**
+     * @brief Returns the latest telemetry as one consistent record.
+     * @details Lock-free for readers, so any number of threads may poll it at high rates without
+     *          slowing down the hardware polling.
+     * @retval TelemetrySnapshot Last position, GPS and link quality, flight and command state,
+     *         current destination and the time of the last change.
+     */
+    drone_sdk::TelemetrySnapshot snapshot() const;
+
 private:
+    // The executor is created on the first asynchronous subscription, so a drone without one
+    // starts no delivery thread. Kept on the heap with its mutex so DroneSDK stays movable.
+    struct CallbackDelivery
+    {
+        mutable std::mutex mutex;
+        std::unique_ptr<CallbackExecutor> executor;
+    };
+
+    // Creates the delivery thread on the first call, safe from any thread
+    CallbackExecutor &callbackExecutor();
+
+    // Declared before the controller so that it outlives every event the controller publishes
+    std::unique_ptr<CallbackDelivery> m_callbacks;
+
     // Unique pointer to the DroneController object. The controller manages the drone's actions and states.
     std::unique_ptr<DroneController> m_DroneController;
 };
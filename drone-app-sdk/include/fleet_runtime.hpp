@@ -0,0 +1,136 @@
+#ifndef FLEET_RUNTIME_HPP
+#define FLEET_RUNTIME_HPP
+
+#include "deadline_scheduler.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Shared polling engine for many drones in one process.
+ *
+ * Runs periodic and on-demand tasks of any number of HardwareMonitor instances on a fixed
+ * pool of worker threads. Deadlines are kept by a hashed timer wheel driven by a single timer
+ * thread, so the thread count depends on the pool size and not on the number of drones.
+ *
+ * A task never runs concurrently with itself, which keeps single-producer/single-consumer
+ * structures safe when their ends are driven by runtime tasks.
+ * The runtime must outlive every monitor attached to it.
+ */
+class FleetRuntime
+{
+public:
+    using Clock = DeadlineScheduler::Clock;
+    using TaskId = std::uint64_t;
+
+    /**
+     * @brief Starts the worker pool and the timer thread.
+     * @param workerCount Number of worker threads (defaults to the number of cores).
+     * @param tickResolution Granularity of the timer wheel.
+     * @param wheelSlots Number of slots in the timer wheel.
+     */
+    explicit FleetRuntime(std::size_t workerCount = defaultWorkerCount(),
+                          Clock::duration tickResolution = std::chrono::milliseconds(1),
+                          std::size_t wheelSlots = 1024);
+    ~FleetRuntime();
+
+    FleetRuntime(const FleetRuntime &) = delete;
+    FleetRuntime &operator=(const FleetRuntime &) = delete;
+
+    /**
+     * @brief Runs a task on the deadline grid of a scheduler.
+     * @param scheduler Provides the deadlines and collects tick statistics, must stay alive until cancel().
+     * @param task The work done on every tick.
+     * @return Id used to cancel the task.
+     */
+    TaskId schedulePeriodic(DeadlineScheduler &scheduler, std::function<void()> task);
+
+    /**
+     * @brief Registers a task that runs once on a worker every time trigger() is called.
+     * @details Triggers that arrive while the task is queued are merged, triggers that arrive while
+     *          it runs cause exactly one more run.
+     * @return Id used to trigger and cancel the task.
+     */
+    TaskId registerTriggered(std::function<void()> task);
+
+    /**
+     * @brief Requests a run of a task registered with registerTriggered().
+     */
+    void trigger(TaskId id);
+
+    /**
+     * @brief Removes a task. Blocks until a run in progress on another thread has finished.
+     */
+    void cancel(TaskId id);
+
+    std::size_t workerCount() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * @brief Number of tasks currently registered.
+     */
+    std::size_t taskCount() const;
+
+    static std::size_t defaultWorkerCount()
+    {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        return cores == 0 ? 1 : cores;
+    }
+
+private:
+    struct Task
+    {
+        TaskId id = 0;
+        DeadlineScheduler *scheduler = nullptr; ///< Null for triggered tasks.
+        std::function<void()> work;
+        std::uint64_t dueTick = 0;
+        bool armed = false;     ///< Waiting in the timer wheel.
+        bool queued = false;    ///< Waiting in the ready queue.
+        bool running = false;   ///< Executing on a worker.
+        bool rerun = false;     ///< Triggered again while running.
+        bool cancelled = false;
+        std::thread::id runner; ///< Worker executing the task.
+    };
+    using TaskPtr = std::shared_ptr<Task>;
+
+    void timerLoop();
+    void workerLoop();
+    void runTask(const TaskPtr &task);
+
+    // The following expect m_mutex to be held
+    void arm(const TaskPtr &task);
+    void enqueue(const TaskPtr &task);
+    std::uint64_t tickAt(Clock::time_point deadline) const;   ///< First tick at or after a deadline.
+    std::uint64_t elapsedTicks(Clock::time_point now) const; ///< Last tick the clock has reached.
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workCondition;  ///< Workers wait for ready tasks.
+    std::condition_variable m_timerCondition; ///< Timer thread waits for armed tasks.
+    std::condition_variable m_idleCondition;  ///< cancel() waits for a running task.
+
+    std::deque<TaskPtr> m_ready;
+    std::vector<std::vector<TaskPtr>> m_wheel;
+    std::unordered_map<TaskId, TaskPtr> m_tasks;
+    std::size_t m_armedCount = 0;
+    std::uint64_t m_currentTick = 0;
+    Clock::time_point m_epoch;
+    Clock::duration m_resolution;
+    TaskId m_nextId = 1;
+    bool m_stopping = false;
+
+    std::thread m_timerThread;
+    std::vector<std::thread> m_workers;
+};
+
+#endif // FLEET_RUNTIME_HPP
@@ -3,37 +3,71 @@
 
 #include "flight-controller/flight_controller.hpp" 
 #include "icd.hpp"
+#include "retry_policy.hpp" // Retries of transient failures
 
-class FlightControllerHandler {
+// Every command is retried on CONNECTION_ERROR and HARDWARE_ERROR according to the retry
+// policy, unless repeating it is unsafe (see drone_sdk::Idempotency). Commands report their
+// final status to their completion; the retries wait through @p schedule (see drone_sdk::Retrier).
+// @p Controller is the hardware API being driven, replaced in tests to check what is sent.
+template <typename Controller>
+class BasicFlightControllerHandler {
 public:
-    FlightControllerHandler() = default;
+    using Done = drone_sdk::Retrier::Done;
 
-    drone_sdk::FlightControllerStatus arm()  {
-        return convertResponse(m_flightController.arm());
+    explicit BasicFlightControllerHandler(drone_sdk::Retrier::Schedule schedule = {})
+        : m_retrier({}, std::move(schedule)) {}
+
+    void setRetryPolicy(const drone_sdk::RetryPolicy &policy) {
+        m_retrier.setPolicy(policy);
+    }
+
+    drone_sdk::RetryMetrics retryMetrics() const {
+        return m_retrier.metrics();
     }
 
-    drone_sdk::FlightControllerStatus disarm()  {
-        return convertResponse(m_flightController.disarm());
+    void arm(Done done)  {
+        m_retrier.run(drone_sdk::Idempotency::IDEMPOTENT, [this]() {
+            return convertResponse(m_flightController.arm());
+        }, std::move(done));
     }
 
-    drone_sdk::FlightControllerStatus takeOff(const drone_sdk::Location &location)  {
-        return convertResponse(m_flightController.takeOff(location.altitude));
+    void disarm(Done done)  {
+        m_retrier.run(drone_sdk::Idempotency::IDEMPOTENT, [this]() {
+            return convertResponse(m_flightController.disarm());
+        }, std::move(done));
+    }
+
+    // The hardware takes off to its own configured altitude and accepts no target, so the
+    // location is not sent here. Callers reach the requested altitude with the goTo that
+    // follows take off (see CommandController::flyTo).
+    void takeOff(const drone_sdk::Location &location, Done done)  {
+        (void)location;
+        m_retrier.run(drone_sdk::Idempotency::NON_IDEMPOTENT, [this]() {
+            return convertResponse(m_flightController.takeOff());
+        }, std::move(done));
     }
 
     void land()  {
-        m_flightController.land();
+        m_retrier.run(drone_sdk::Idempotency::IDEMPOTENT, [this]() {
+            return convertResponse(m_flightController.land());
+        }, {});
     }
 
-    drone_sdk::FlightControllerStatus goHome()  {
-        return convertResponse(m_flightController.goHome());
+    void goHome(Done done)  {
+        m_retrier.run(drone_sdk::Idempotency::IDEMPOTENT, [this]() {
+            return convertResponse(m_flightController.goHome());
+        }, std::move(done));
     }
 
-    drone_sdk::FlightControllerStatus goTo(drone_sdk::Location location)  {
-        return convertResponse(m_flightController.goTo(location.altitude, location.longitude, location.altitude));
+    void goTo(drone_sdk::Location location, Done done)  {
+        m_retrier.run(drone_sdk::Idempotency::IDEMPOTENT, [this, location]() {
+            return convertResponse(m_flightController.goTo(location.latitude, location.longitude, location.altitude));
+        }, std::move(done));
     }
 
 private:
-    hw_sdk_mock::FlightController m_flightController;  // Real flight controller instance
+    Controller m_flightController;  // Real flight controller instance
+    drone_sdk::Retrier m_retrier;
 
     drone_sdk::FlightControllerStatus convertResponse(hw_sdk_mock::FlightController::ResponseCode response) const {
         switch (response) {
@@ -51,4 +85,6 @@ private:
     }
 };
 
+using FlightControllerHandler = BasicFlightControllerHandler<hw_sdk_mock::FlightController>;
+
 #endif // FLIGHT_CONTROLLER_HANDLER_HPP
@@ -0,0 +1,285 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include "icd.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace drone_sdk
+{
+    enum class RecordKind : std::uint8_t
+    {
+        EVENT = 0,   ///< An event processed by the state machine.
+        TRANSITION,  ///< A state machine region changed state.
+        GPS_SAMPLE,  ///< A GPS fix handed to the state machine.
+        LINK_SAMPLE, ///< A link quality sample handed to the state machine.
+        COMMAND      ///< A flight controller command and its result.
+    };
+
+    enum class RecordedEvent : std::uint8_t
+    {
+        GPS_SIGNAL = 0,
+        LINK_SIGNAL,
+        GEOFENCE_CHECK,
+        TASK_ASSIGNED,
+        TASK_COMPLETED,
+        MISSION_STARTED
+    };
+
+    enum class StateRegion : std::uint8_t
+    {
+        COMMAND = 0, ///< CommandStatus
+        FLIGHT,      ///< FlightState
+        GPS,         ///< safetyState
+        LINK,        ///< safetyState
+        GEOFENCE     ///< safetyState
+    };
+
+    enum class RecordedCommand : std::uint8_t
+    {
+        ARM = 0,
+        TAKEOFF,
+        GOTO,
+        GO_HOME,
+        LAND
+    };
+
+    /**
+     * @brief One entry of the flight recorder, 40 bytes.
+     *
+     * What code, from and to hold depends on the kind:
+     *  - EVENT: code is a RecordedEvent, from its argument (signal quality, geofence violated, mission).
+     *  - TRANSITION: code is a StateRegion, from and to the states of that region.
+     *  - GPS_SAMPLE, LINK_SAMPLE: from is the SignalQuality, location the fix.
+     *  - COMMAND: code is a RecordedCommand, from the FlightControllerStatus, location the target.
+     */
+    struct FlightRecord
+    {
+        std::int64_t timestamp = 0; ///< steady_clock nanoseconds.
+        RecordKind kind = RecordKind::EVENT;
+        std::uint8_t code = 0;
+        std::uint8_t from = 0;
+        std::uint8_t to = 0;
+        std::uint32_t reserved = 0;
+        Location location;
+    };
+
+    /**
+     * @brief Layout of a flight recorder dump (host byte order, little endian on every target
+     *        we build for): this header followed by @c count FlightRecord, oldest first.
+     */
+    struct FlightRecorderFileHeader
+    {
+        static constexpr std::uint32_t kMagic = 0x52464444; ///< "DDFR" read as little endian.
+        static constexpr std::uint16_t kVersion = 1;
+
+        std::uint32_t magic = kMagic;
+        std::uint16_t version = kVersion;
+        std::uint16_t recordSize = sizeof(FlightRecord);
+        std::uint64_t dropped = 0; ///< Records overwritten before the dump was taken.
+        std::uint64_t count = 0;   ///< Number of records that follow.
+    };
+
+    /**
+     * @brief Always-on black box of one drone: the last records of the state machine events,
+     *        transitions, sensor samples and flight controller commands.
+     *
+     * Records go to a fixed ring allocated up front; the oldest are overwritten. Recording takes
+     * no lock for any number of threads (an atomic increment, a compare-exchange and a few
+     * relaxed stores), so it stays on the hot paths. Each slot is framed by a sequence number like
+     * a SeqLock, so a snapshot taken while threads keep recording skips the slots being written
+     * instead of reading them torn. A writer only waits when it laps the whole ring onto a slot
+     * another thread is still writing.
+     *
+     * requestDump() hands the file writing to the recorder's own thread; dumps requested while
+     * one is pending are merged into it.
+     */
+    class FlightRecorder
+    {
+    public:
+        static constexpr std::size_t kDefaultCapacity = 16384;
+
+        /**
+         * @param capacity Records kept, rounded up to a power of two.
+         * @throws std::invalid_argument If @p capacity is 0.
+         */
+        explicit FlightRecorder(std::size_t capacity = kDefaultCapacity);
+        ~FlightRecorder();
+
+        FlightRecorder(const FlightRecorder &) = delete;
+        FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+        /**
+         * @brief Records @p record, stamped with the current time.
+         */
+        void record(FlightRecord record)
+        {
+            record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count();
+            const std::uint64_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+            Slot &slot = m_slots[index & m_mask];
+            // Odd: write in progress. Taken over from the previous record of the slot only, so a
+            // late writer never stamps its older index over a newer record.
+            std::uint64_t current = slot.sequence.load(std::memory_order_acquire);
+            while (true)
+            {
+                if (current > 2 * index)
+                {
+                    return; // Lapped by a newer record, this one is overwritten already
+                }
+                if (current % 2 == 1)
+                {
+                    std::this_thread::yield(); // An older record is still being written
+                    current = slot.sequence.load(std::memory_order_acquire);
+                }
+                else if (slot.sequence.compare_exchange_weak(current, 2 * index + 1, std::memory_order_acquire,
+                                                             std::memory_order_acquire))
+                {
+                    break;
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            std::array<std::uint64_t, kWords> words;
+            std::memcpy(words.data(), &record, sizeof(record));
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                slot.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+        }
+
+        void recordEvent(RecordedEvent event, std::uint8_t argument)
+        {
+            record(entry(RecordKind::EVENT, static_cast<std::uint8_t>(event), argument));
+        }
+
+        template <typename State>
+        void recordTransition(StateRegion region, State from, State to)
+        {
+            record(entry(RecordKind::TRANSITION, static_cast<std::uint8_t>(region), static_cast<std::uint8_t>(from),
+                         static_cast<std::uint8_t>(to)));
+        }
+
+        void recordGpsSample(const Location &location, SignalQuality quality)
+        {
+            record(entry(RecordKind::GPS_SAMPLE, 0, static_cast<std::uint8_t>(quality), 0, location));
+        }
+
+        void recordLinkSample(SignalQuality quality)
+        {
+            record(entry(RecordKind::LINK_SAMPLE, 0, static_cast<std::uint8_t>(quality)));
+        }
+
+        void recordCommand(RecordedCommand command, FlightControllerStatus status, const Location &target = {})
+        {
+            record(entry(RecordKind::COMMAND, static_cast<std::uint8_t>(command), static_cast<std::uint8_t>(status), 0, target));
+        }
+
+        std::size_t capacity() const
+        {
+            return m_slots.size();
+        }
+
+        // Records made so far, including the ones overwritten since
+        std::uint64_t recorded() const
+        {
+            return m_next.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief The records still in the ring, oldest first.
+         * @param dropped If given, receives the number of records older than the returned ones.
+         */
+        std::vector<FlightRecord> snapshot(std::uint64_t *dropped = nullptr) const;
+
+        /**
+         * @brief Writes a snapshot to @p filename, see FlightRecorderFileHeader.
+         * @throws std::runtime_error If the file cannot be written.
+         */
+        void dump(const std::string &filename) const;
+
+        /**
+         * @brief Reads back a file written by dump().
+         * @throws std::runtime_error If the file cannot be read or is not a flight recorder dump.
+         */
+        static std::vector<FlightRecord> load(const std::string &filename);
+
+        /**
+         * @brief Directory requestDump() writes to, the system temporary directory by default.
+         */
+        void setDumpDirectory(const std::string &directory);
+
+        /**
+         * @brief Dumps the ring on the recorder thread, into a new file of the dump directory,
+         *        named after the time, the recorder and its dump count.
+         * @details Returns right away. Existing files are never replaced. Failures are reported
+         *          on std::cerr.
+         */
+        void requestDump();
+
+        // Dumps written by requestDump() so far
+        std::uint64_t dumps() const
+        {
+            return m_dumps.load(std::memory_order_acquire);
+        }
+
+        // File of the latest dump written by requestDump(), empty if none
+        std::string lastDump() const;
+
+    private:
+        static_assert(std::is_trivially_copyable_v<FlightRecord>, "Records are copied byte-wise");
+        static constexpr std::size_t kWords = sizeof(FlightRecord) / sizeof(std::uint64_t);
+        static_assert(sizeof(FlightRecord) == kWords * sizeof(std::uint64_t), "Records fill whole words");
+
+        struct Slot
+        {
+            std::atomic<std::uint64_t> sequence{0}; ///< 2 * index + 2 once record index is complete.
+            std::array<std::atomic<std::uint64_t>, kWords> words{};
+        };
+
+        static FlightRecord entry(RecordKind kind, std::uint8_t code, std::uint8_t from, std::uint8_t to = 0,
+                                  const Location &location = {})
+        {
+            FlightRecord record;
+            record.kind = kind;
+            record.code = code;
+            record.from = from;
+            record.to = to;
+            record.location = location;
+            return record;
+        }
+
+        // Writes a snapshot with std::fopen @p mode, "wbx" to never replace an existing file
+        void write(const std::string &filename, const char *mode) const;
+        void runDumper();
+
+        std::uint64_t m_id; ///< Unique in the process, part of the dump file names.
+        std::vector<Slot> m_slots;
+        std::uint64_t m_mask;
+        std::atomic<std::uint64_t> m_next{0}; ///< Index of the next record.
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::string m_directory;
+        std::string m_lastDump;
+        bool m_dumpRequested = false;
+        bool m_stopping = false;
+        std::atomic<std::uint64_t> m_dumps{0};
+        std::thread m_dumper; ///< Started last, after the members it uses.
+    };
+}
+
+#endif // FLIGHT_RECORDER_HPP
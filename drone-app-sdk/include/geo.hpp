@@ -0,0 +1,134 @@
+#ifndef GEO_HPP
+#define GEO_HPP
+
+#include "icd.hpp"
+
+#include <cmath>
+#include <numbers>
+
+namespace drone_sdk::geo
+{
+    // Latitude and longitude are in degrees, altitude in meters
+    constexpr double kEarthRadiusMeters = 6371008.8; ///< Mean earth radius (IUGG).
+    constexpr double kMetersPerDegree = kEarthRadiusMeters * std::numbers::pi / 180.0;
+    constexpr double kRadiansPerDegree = std::numbers::pi / 180.0;
+
+    // Longitude difference folded into [-180, 180] so paths across the antimeridian stay short
+    inline double longitudeDelta(double from, double to)
+    {
+        double delta = to - from;
+        if (delta > 180.0)
+        {
+            delta -= 360.0;
+        }
+        else if (delta < -180.0)
+        {
+            delta += 360.0;
+        }
+        return delta;
+    }
+
+    /**
+     * @brief Great circle ground distance in meters, accurate at any range.
+     */
+    inline double haversineDistance(const Location &from, const Location &to)
+    {
+        const double lat1 = from.latitude * kRadiansPerDegree;
+        const double lat2 = to.latitude * kRadiansPerDegree;
+        const double sinHalfLat = std::sin((lat2 - lat1) / 2.0);
+        const double sinHalfLon = std::sin(longitudeDelta(from.longitude, to.longitude) * kRadiansPerDegree / 2.0);
+        const double h = sinHalfLat * sinHalfLat + std::cos(lat1) * std::cos(lat2) * sinHalfLon * sinHalfLon;
+        return 2.0 * kEarthRadiusMeters * std::asin(std::sqrt(std::fmin(h, 1.0)));
+    }
+
+    /**
+     * @brief 3D distance in meters: haversine ground distance combined with the altitude difference.
+     */
+    inline double distance(const Location &from, const Location &to)
+    {
+        const double ground = haversineDistance(from, to);
+        const double vertical = to.altitude - from.altitude;
+        return std::sqrt(ground * ground + vertical * vertical);
+    }
+
+    /**
+     * @brief Decides whether the drone reached a target, evaluated on every GPS update.
+     *
+     * setTarget() precomputes the meters per degree of longitude at the target latitude, so
+     * arrived() is a trig free equirectangular squared distance compared with the squared
+     * radius. The approximation error is far below GPS noise within a few kilometers, and
+     * updates further away than kNearRangeMeters are rejected by a bounding check before that.
+     */
+    class ArrivalDetector
+    {
+    public:
+        static constexpr double kDefaultRadiusMeters = 2.0;
+        static constexpr double kNearRangeMeters = 10000.0; ///< Beyond this range use distance().
+
+        explicit ArrivalDetector(double radiusMeters = kDefaultRadiusMeters)
+        {
+            setRadius(radiusMeters);
+        }
+
+        void setRadius(double radiusMeters)
+        {
+            m_radius = std::fabs(radiusMeters);
+            m_radiusSquared = m_radius * m_radius;
+        }
+
+        double radius() const
+        {
+            return m_radius;
+        }
+
+        void setTarget(const Location &target)
+        {
+            m_target = target;
+            m_metersPerDegreeLongitude = kMetersPerDegree * std::cos(target.latitude * kRadiansPerDegree);
+        }
+
+        const Location &target() const
+        {
+            return m_target;
+        }
+
+        /**
+         * @brief True when @p current lies within the arrival radius of the target.
+         */
+        bool arrived(const Location &current) const
+        {
+            const double dz = current.altitude - m_target.altitude;
+            const double dy = (current.latitude - m_target.latitude) * kMetersPerDegree;
+            if (std::fabs(dz) > m_radius || std::fabs(dy) > m_radius)
+            {
+                return false; // Cheap reject for the usual case of still being on the way
+            }
+            const double dx = longitudeDelta(m_target.longitude, current.longitude) * m_metersPerDegreeLongitude;
+            return dx * dx + dy * dy + dz * dz <= m_radiusSquared;
+        }
+
+        /**
+         * @brief Distance to the target in meters: equirectangular when near, haversine when far.
+         */
+        double distanceTo(const Location &current) const
+        {
+            const double dz = current.altitude - m_target.altitude;
+            const double dy = (current.latitude - m_target.latitude) * kMetersPerDegree;
+            const double dx = longitudeDelta(m_target.longitude, current.longitude) * m_metersPerDegreeLongitude;
+            const double nearSquared = dx * dx + dy * dy + dz * dz;
+            if (nearSquared <= kNearRangeMeters * kNearRangeMeters)
+            {
+                return std::sqrt(nearSquared);
+            }
+            return distance(current, m_target);
+        }
+
+    private:
+        Location m_target;
+        double m_metersPerDegreeLongitude = kMetersPerDegree;
+        double m_radius = 0.0;
+        double m_radiusSquared = 0.0;
+    };
+}
+
+#endif // GEO_HPP
@@ -0,0 +1,132 @@
+#ifndef GEOFENCE_HPP
+#define GEOFENCE_HPP
+
+#include "icd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace drone_sdk
+{
+    /**
+     * @brief A no-fly zone: a polygon in latitude/longitude and the altitude band it covers.
+     * @details The altitude of the boundary vertices is ignored. Zones must not cross the
+     *          antimeridian.
+     */
+    struct GeofenceZone
+    {
+        std::vector<Location> boundary;                                      ///< At least three vertices, implicitly closed.
+        double floorMeters = -std::numeric_limits<double>::infinity();       ///< Zone applies from this altitude...
+        double ceilingMeters = std::numeric_limits<double>::infinity();      ///< ...up to this one.
+    };
+
+    /**
+     * @brief No-fly zones and an altitude ceiling, indexed for checks on every GPS update.
+     *
+     * Zones are rasterized into a sparse uniform grid of square cells in degrees. Each cell
+     * lists the zones touching it and whether it lies entirely inside the zone, so a point
+     * query is one hash lookup, and a polygon test only for zone boundaries passing through
+     * that cell. Segments walk the cells they cross, so checking a path costs in proportion
+     * to its length in cells, not to the number of zones.
+     *
+     * Building is not thread safe; a built Geofence is immutable and can be shared between
+     * drones and threads.
+     */
+    class Geofence
+    {
+    public:
+        static constexpr double kDefaultCellDegrees = 0.01; ///< About 1.1 km of latitude.
+
+        explicit Geofence(double cellDegrees = kDefaultCellDegrees);
+
+        /**
+         * @brief Adds a no-fly zone.
+         * @return Index of the zone.
+         * @throws std::invalid_argument If the zone has fewer than three vertices.
+         */
+        std::size_t addNoFlyZone(GeofenceZone zone);
+
+        // Highest allowed altitude in meters, unlimited by default
+        void setAltitudeCeiling(double ceilingMeters)
+        {
+            m_altitudeCeiling = ceilingMeters;
+        }
+
+        double altitudeCeiling() const
+        {
+            return m_altitudeCeiling;
+        }
+
+        std::size_t zoneCount() const
+        {
+            return m_zones.size();
+        }
+
+        /**
+         * @brief True when @p point is above the ceiling or inside a no-fly zone.
+         */
+        bool violates(const Location &point) const;
+
+        /**
+         * @brief True when the straight leg from @p from to @p to touches a violation.
+         * @details Conservative in altitude: a leg crossing a zone boundary violates it if
+         *          the altitude range of the leg overlaps the zone's band anywhere.
+         */
+        bool violates(const Location &from, const Location &to) const;
+
+        /**
+         * @brief Checks every leg of a path.
+         * @param waypoints The waypoints in flight order.
+         * @param start Where the drone flies to the first waypoint from, if known. If it violates
+         *        itself, as for a drone that drifted into a zone or above the ceiling, the first
+         *        leg may leave the violation: only its end and the other zones it crosses count.
+         * @return Index of the first waypoint that violates, or whose incoming leg does.
+         */
+        std::optional<std::size_t> firstViolation(std::span<const Location> waypoints,
+                                                  const std::optional<Location> &start = std::nullopt) const;
+
+    private:
+        // Boundary coordinates kept per axis for the polygon tests
+        struct Zone
+        {
+            std::vector<double> latitudes;
+            std::vector<double> longitudes;
+            double floorMeters;
+            double ceilingMeters;
+            double minLatitude;
+            double maxLatitude;
+            double minLongitude;
+            double maxLongitude;
+        };
+
+        struct CellEntry
+        {
+            std::uint32_t zone;
+            bool inside; ///< The whole cell lies inside the zone, no polygon test needed.
+        };
+
+        // Shared by violates() and firstViolation(), @p leaving ignores the violations at @p from
+        bool legViolates(const Location &from, const Location &to, bool leaving) const;
+        std::vector<std::uint32_t> zonesAt(const Location &point) const; // Zones violated at @p point
+
+        std::int64_t cellIndex(double degrees) const;
+        static std::uint64_t cellKey(std::int64_t row, std::int64_t column);
+        const std::vector<CellEntry> *cell(std::int64_t row, std::int64_t column) const;
+
+        static bool inBand(const Zone &zone, double lowMeters, double highMeters);
+        static bool contains(const Zone &zone, double latitude, double longitude);
+        static bool crossesBoundary(const Zone &zone, const Location &from, const Location &to);
+
+        double m_cellDegrees;
+        double m_altitudeCeiling = std::numeric_limits<double>::infinity();
+        std::vector<Zone> m_zones;
+        std::unordered_map<std::uint64_t, std::vector<CellEntry>> m_cells;
+    };
+}
+
+#endif // GEOFENCE_HPP
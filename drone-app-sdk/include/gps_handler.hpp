@@ -1,7 +1,7 @@
 #ifndef GPS_HANDLER_HPP
 #define GPS_HANDLER_HPP
 
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include <thread>
 #include <chrono>
 #include "gps/gps.hpp"
@@ -13,15 +13,22 @@ public:
     ~GpsHandler() = default;
 
     // Define the signal type using ICD types (drone_sdk::Location, drone_sdk::SignalQuality)
-    using GpsUpdateSignal = boost::signals2::signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
+    using GpsUpdateSignal = drone_sdk::Signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
 
     // Subscribe to GPS update signals
-    boost::signals2::connection subscribe(const GpsUpdateSignal::slot_type& slot) {
+    drone_sdk::Connection subscribe(const GpsUpdateSignal::slot_type& slot) {
         return m_gpsUpdateSignal.connect(slot);
     }
 
-    // Update GPS location and signal quality
-    void update() {
+    // One timestamped GPS reading, converted to ICD types
+    struct Sample {
+        std::chrono::steady_clock::time_point timestamp;
+        drone_sdk::Location location;
+        drone_sdk::SignalQuality quality;
+    };
+
+    // Read the device without notifying anyone (the slow, I/O bound part of an update)
+    Sample read() {
         auto location = m_gpsDevice.getLocation();         // Get location from hw_sdk_mock::Gps
         auto signalQuality = m_gpsDevice.getSignalQuality(); // Get signal quality from hw_sdk_mock::Gps
 
@@ -31,8 +38,17 @@ public:
         // Convert hw_sdk_mock::Gps::SignalQuality to drone_sdk::SignalQuality
         drone_sdk::SignalQuality icdSignalQuality = static_cast<drone_sdk::SignalQuality>(signalQuality);
 
-        // Emit the signal with converted types
-        m_gpsUpdateSignal(icdLocation, icdSignalQuality);
+        return {std::chrono::steady_clock::now(), icdLocation, icdSignalQuality};
+    }
+
+    // Notify subscribers about a reading
+    void publish(const Sample& sample) {
+        m_gpsUpdateSignal(sample.location, sample.quality);
+    }
+
+    // Update GPS location and signal quality
+    void update() {
+        publish(read());
     }
 
 private:
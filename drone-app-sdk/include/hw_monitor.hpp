@@ -3,37 +3,99 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "gps_handler.hpp"
 #include "link_handler.hpp" 
+#include "deadline_scheduler.hpp"
+#include "spsc_ring.hpp"
+#include "fleet_runtime.hpp"
 #include "icd.hpp"
 
 class HardwareMonitor {
 public:
+    static constexpr double kDefaultPollingRateHz = 10.0;
+    static constexpr std::size_t kTelemetryRingCapacity = 64;  // Samples buffered per sensor
+
     // Constructor now initializes both GpsHandler and LinkHandler
     HardwareMonitor()
-        : m_gpsHandler(), m_linkHandler(), m_running(false) {}
+        : m_gpsHandler(), m_linkHandler(), m_running(false),
+          m_gpsPeriod(DeadlineScheduler::periodFromRate(kDefaultPollingRateHz)),
+          m_linkPeriod(m_gpsPeriod),
+          m_gpsScheduler(m_gpsPeriod),
+          m_linkScheduler(m_linkPeriod) {}
 
     ~HardwareMonitor() {
         stop();
     }
 
-    // Start polling at 10 Hz for GPS and link updates
+    // Polling rates, kept until the next start() hands them to the schedulers, so a running
+    // polling thread never sees its period change. A rate that is not positive throws
+    // std::invalid_argument and leaves the previous one.
+    void setGpsPollingRate(double rateHz) {
+        m_gpsPeriod = DeadlineScheduler::periodFromRate(rateHz);
+    }
+
+    void setLinkPollingRate(double rateHz) {
+        m_linkPeriod = DeadlineScheduler::periodFromRate(rateHz);
+    }
+
+    // Start polling GPS and link updates on absolute deadlines (10 Hz by default).
+    // Each sensor runs on its own thread, so a slow GPS read never delays link-loss detection.
+    // The polling threads only acquire samples; a dispatch thread drains them to the subscribers,
+    // so slow subscribers never stall acquisition.
     void start() {
+        applyPollingRates();
+        const auto startTime = DeadlineScheduler::Clock::now();
+        m_gpsScheduler.reset(startTime);
+        m_linkScheduler.reset(startTime);
+
         m_running = true;
-        m_pollingThread = std::thread([this]() {
-            while (m_running) {
-                m_gpsHandler.update();  // Update GPS handler
-                m_linkHandler.update();  // Update Link handler
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
-        });
+        m_dispatchThread = std::thread([this]() { dispatchLoop(); });
+        m_gpsThread = std::thread([this]() { pollLoop(m_gpsScheduler, m_gpsHandler, m_gpsRing); });
+        m_linkThread = std::thread([this]() { pollLoop(m_linkScheduler, m_linkHandler, m_linkRing); });
+    }
+
+    // Fleet mode: run the same polling and dispatch as tasks of a shared runtime instead of
+    // dedicated threads. The runtime must outlive this monitor.
+    void start(FleetRuntime& fleet) {
+        applyPollingRates();
+        const auto startTime = DeadlineScheduler::Clock::now();
+        m_gpsScheduler.reset(startTime);
+        m_linkScheduler.reset(startTime);
+
+        m_running = true;
+        m_fleet = &fleet;
+        m_dispatchTask = fleet.registerTriggered([this]() { drainRings(); });
+        m_gpsTask = fleet.schedulePeriodic(m_gpsScheduler, [this]() { acquire(m_gpsHandler, m_gpsRing); });
+        m_linkTask = fleet.schedulePeriodic(m_linkScheduler, [this]() { acquire(m_linkHandler, m_linkRing); });
     }
 
     // Stop polling
     void stop() {
-        m_running = false;
-        if (m_pollingThread.joinable()) {
-            m_pollingThread.join();
+        if (m_fleet != nullptr) {
+            m_running = false;
+            m_fleet->cancel(m_gpsTask);
+            m_fleet->cancel(m_linkTask);
+            m_fleet->cancel(m_dispatchTask);
+            m_fleet = nullptr;
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_running = false;
+        }
+        m_wakeCondition.notify_all();
+        if (m_gpsThread.joinable()) {
+            m_gpsThread.join();
+        }
+        if (m_linkThread.joinable()) {
+            m_linkThread.join();
+        }
+        wakeDispatcher();
+        if (m_dispatchThread.joinable()) {
+            m_dispatchThread.join();
         }
     }
 
@@ -47,11 +109,114 @@ public:
         m_linkHandler.subscribe(slot);
     }
 
+    // Overrun, jitter and missed deadline statistics of each sensor
+    PollingStats getGpsPollingStats() const {
+        return m_gpsScheduler.stats();
+    }
+
+    PollingStats getLinkPollingStats() const {
+        return m_linkScheduler.stats();
+    }
+
+    // Depth and drop counters of the queues between polling and dispatch
+    RingStats getGpsQueueStats() const {
+        return m_gpsRing.stats();
+    }
+
+    RingStats getLinkQueueStats() const {
+        return m_linkRing.stats();
+    }
+
 private:
+    using GpsRing = SpscRing<GpsHandler::Sample, kTelemetryRingCapacity>;
+    using LinkRing = SpscRing<LinkHandler::Sample, kTelemetryRingCapacity>;
+
+    // Called before the polling starts, while nothing else reads the schedulers
+    void applyPollingRates() {
+        m_gpsScheduler.setPeriod(m_gpsPeriod);
+        m_linkScheduler.setPeriod(m_linkPeriod);
+    }
+
+    // Poll one sensor on its own deadline grid until stop() is called
+    template <typename Handler, typename Ring>
+    void pollLoop(DeadlineScheduler& scheduler, Handler& handler, Ring& ring) {
+        while (m_running) {
+            {
+                // Sleep until the deadline, but wake up at once on stop()
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                if (m_wakeCondition.wait_until(lock, scheduler.nextDeadline(), [this]() { return !m_running; })) {
+                    break;
+                }
+            }
+
+            scheduler.beginTick(DeadlineScheduler::Clock::now());
+            acquire(handler, ring);
+            scheduler.endTick(DeadlineScheduler::Clock::now());
+        }
+    }
+
+    // Take one sample and hand it to the dispatch stage
+    template <typename Handler, typename Ring>
+    void acquire(Handler& handler, Ring& ring) {
+        ring.tryPush(handler.read());  // A full ring drops the sample rather than blocking
+        if (m_fleet != nullptr) {
+            m_fleet->trigger(m_dispatchTask);
+        } else {
+            wakeDispatcher();
+        }
+    }
+
+    // Deliver queued samples to the subscribers, link first since it is safety critical
+    void drainRings() {
+        LinkHandler::Sample linkSample;
+        while (m_linkRing.tryPop(linkSample)) {
+            m_linkHandler.publish(linkSample);
+        }
+        GpsHandler::Sample gpsSample;
+        while (m_gpsRing.tryPop(gpsSample)) {
+            m_gpsHandler.publish(gpsSample);
+        }
+    }
+
+    void dispatchLoop() {
+        while (true) {
+            const auto seen = m_dispatchSequence.load(std::memory_order_acquire);
+            drainRings();
+            if (!m_running) {
+                break;
+            }
+            m_dispatchSequence.wait(seen, std::memory_order_acquire);  // Sleep until new samples arrive
+        }
+    }
+
+    void wakeDispatcher() {
+        m_dispatchSequence.fetch_add(1, std::memory_order_release);
+        m_dispatchSequence.notify_one();
+    }
+
     GpsHandler m_gpsHandler;  // HardwareMonitor owns its own GpsHandler
     LinkHandler m_linkHandler;  // HardwareMonitor owns its own LinkHandler
-    std::atomic<bool> m_running;  // Flag to control the polling thread
-    std::thread m_pollingThread;  // Thread for polling
+    std::atomic<bool> m_running;  // Flag to control the polling threads
+    std::thread m_gpsThread;  // Thread polling the GPS
+    std::thread m_linkThread;  // Thread polling the link
+    std::thread m_dispatchThread;  // Thread delivering samples to the subscribers
+
+    std::mutex m_wakeMutex;  // Pairs with m_wakeCondition to interrupt the deadline sleep
+    std::condition_variable m_wakeCondition;
+
+    GpsRing m_gpsRing;  // GPS samples waiting for dispatch (GPS thread -> dispatch thread)
+    LinkRing m_linkRing;  // Link samples waiting for dispatch (link thread -> dispatch thread)
+    std::atomic<std::uint32_t> m_dispatchSequence{0};  // Bumped on every push, the dispatcher waits on it
+
+    DeadlineScheduler::Clock::duration m_gpsPeriod;   // Set by setGpsPollingRate(), applied by start()
+    DeadlineScheduler::Clock::duration m_linkPeriod;  // Set by setLinkPollingRate(), applied by start()
+    DeadlineScheduler m_gpsScheduler;   // Deadline grid of the GPS polling
+    DeadlineScheduler m_linkScheduler;  // Deadline grid of the link polling
+
+    FleetRuntime* m_fleet = nullptr;  // Shared runtime in fleet mode, null when running on own threads
+    FleetRuntime::TaskId m_gpsTask = 0;
+    FleetRuntime::TaskId m_linkTask = 0;
+    FleetRuntime::TaskId m_dispatchTask = 0;
 };
 
 #endif // HW_MONITOR_HPP
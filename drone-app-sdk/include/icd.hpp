@@ -1,6 +1,9 @@
 #ifndef ICD_HPP
 #define ICD_HPP
 
+#include <chrono>
+#include <cstdint>
+
 namespace drone_sdk
 {
 
@@ -16,7 +19,9 @@ namespace drone_sdk
         GPS_HEALTH = 0,
         GPS_NOT_HEALTHY,
         CONNECTED,
-        NOT_CONNECTED
+        NOT_CONNECTED,
+        GEOFENCE_CLEAR,
+        GEOFENCE_VIOLATED
     };
 
 struct Location
@@ -32,20 +37,9 @@ struct Location
     Location(double lat, double lon, double alt)
         : latitude(lat), longitude(lon), altitude(alt) {}
 
-    // Copy constructor
-    Location(const Location &other)
-        : latitude(other.latitude), longitude(other.longitude), altitude(other.altitude) {}
-
-    // Assignment operator
-    Location &operator=(const Location &other)
-    {
-        if (this != &other) { // Check for self-assignment
-            latitude = other.latitude;
-            longitude = other.longitude;
-            altitude = other.altitude;
-        }
-        return *this;
-    }
+    // Defaulted copies keep Location trivially copyable (byte-wise snapshots, wire encoding)
+    Location(const Location &other) = default;
+    Location &operator=(const Location &other) = default;
 
     // Equality operator
     bool operator==(const Location &other) const
@@ -75,6 +69,7 @@ struct Location
         CONNECTION_ERROR,
         HARDWARE_ERROR,
         INVALID_COMMAND,
+        GEOFENCE_VIOLATION,
         UNKNOWN_ERROR
     };
 
@@ -118,6 +113,32 @@ struct Location
         BUSY,
         MISSION_ABORT
     };
+
+    // A state change delivered to the state subscribers, only sent when the state really changed
+    template <typename State>
+    struct StateTransition
+    {
+        State from;
+        State to;
+        std::chrono::steady_clock::time_point timestamp; // When the event causing it was processed
+    };
+
+    using FlightTransition = StateTransition<FlightState>;
+    using CommandTransition = StateTransition<CommandStatus>;
+    using SafetyTransition = StateTransition<safetyState>;
+
+    // Latest known state of the drone, read as one consistent unit
+    struct TelemetrySnapshot
+    {
+        Location location;                 // Last GPS position
+        SignalQuality gpsQuality = SignalQuality::NO_SIGNAL;
+        SignalQuality linkQuality = SignalQuality::NO_SIGNAL;
+        FlightState flightState = FlightState::LANDED;
+        CommandStatus commandStatus = CommandStatus::IDLE;
+        Location destination;              // Destination currently commanded
+        std::chrono::steady_clock::time_point timestamp; // Time of the last change
+        std::uint64_t version = 0;         // Number of changes published so far
+    };
 } // namespace drone_sdk
 
 #endif // ICD_HPP
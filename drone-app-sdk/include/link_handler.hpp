@@ -1,7 +1,7 @@
 #ifndef LINK_HANDLER_HPP
 #define LINK_HANDLER_HPP
 
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include <thread>
 #include <chrono>
 #include "link/link.hpp"
@@ -13,22 +13,35 @@ public:
     ~LinkHandler() = default;
 
     // Define the signal type using ICD types (drone_sdk::SignalQuality)
-    using LinkUpdateSignal = boost::signals2::signal<void(drone_sdk::SignalQuality)>;
+    using LinkUpdateSignal = drone_sdk::Signal<void(drone_sdk::SignalQuality)>;
 
     // Subscribe to Link update signals
-    boost::signals2::connection subscribe(const LinkUpdateSignal::slot_type& slot) {
+    drone_sdk::Connection subscribe(const LinkUpdateSignal::slot_type& slot) {
         return m_linkUpdateSignal.connect(slot);
     }
 
-    // Update Link signal quality
-    void update() {
+    // One timestamped link reading, converted to ICD types
+    struct Sample {
+        std::chrono::steady_clock::time_point timestamp;
+        drone_sdk::SignalQuality quality;
+    };
+
+    // Read the device without notifying anyone (the slow, I/O bound part of an update)
+    Sample read() {
         auto signalQuality = m_linkDevice.getSignalQuality(); // Get signal quality from hw_sdk_mock::Link
 
         // Convert hw_sdk_mock::Link::SignalQuality to drone_sdk::SignalQuality
-        drone_sdk::SignalQuality icdSignalQuality = static_cast<drone_sdk::SignalQuality>(signalQuality);
+        return {std::chrono::steady_clock::now(), static_cast<drone_sdk::SignalQuality>(signalQuality)};
+    }
 
-        // Emit the signal with the converted type
-        m_linkUpdateSignal(icdSignalQuality);
+    // Notify subscribers about a reading
+    void publish(const Sample& sample) {
+        m_linkUpdateSignal(sample.quality);
+    }
+
+    // Update Link signal quality
+    void update() {
+        publish(read());
     }
 
 private:
@@ -0,0 +1,306 @@
+#ifndef LOCATION_BATCH_HPP
+#define LOCATION_BATCH_HPP
+
+#include "geo.hpp"
+#include "icd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace drone_sdk
+{
+    /**
+     * @brief Allocator returning memory aligned for full width vector loads.
+     */
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+        T *allocate(std::size_t count)
+        {
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T *pointer, std::size_t) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t{Alignment});
+        }
+
+        friend bool operator==(const AlignedAllocator &, const AlignedAllocator &) noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * @brief Read-only view of the coordinate columns of a batch of locations.
+     * @tparam Stride Distance in doubles between consecutive entries: 1 for a LocationBatch,
+     *         3 for a plain array of Location. The kernels below take either without copying.
+     */
+    template <std::size_t Stride>
+    struct LocationColumns
+    {
+        const double *latitude = nullptr;
+        const double *longitude = nullptr;
+        const double *altitude = nullptr;
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Zero-copy columns over an array of Location.
+     */
+    inline LocationColumns<3> columns(std::span<const Location> locations)
+    {
+        static_assert(sizeof(Location) == 3 * sizeof(double), "Location must be three packed doubles");
+        if (locations.empty())
+        {
+            return {};
+        }
+        return {&locations.front().latitude, &locations.front().longitude, &locations.front().altitude, locations.size()};
+    }
+
+    /**
+     * @brief Locations stored as separate, aligned latitude, longitude and altitude arrays.
+     *
+     * The structure-of-arrays layout lets the kernels below load four (AVX2) or two (NEON)
+     * coordinates of consecutive locations at once, for paths and telemetry history alike.
+     */
+    class LocationBatch
+    {
+    public:
+        static constexpr std::size_t kAlignment = 64; ///< A cache line, enough for AVX-512 too.
+        using Column = std::vector<double, AlignedAllocator<double, kAlignment>>;
+
+        LocationBatch() = default;
+
+        // Transposes the locations into columns
+        explicit LocationBatch(std::span<const Location> locations)
+        {
+            assign(locations);
+        }
+
+        void assign(std::span<const Location> locations)
+        {
+            m_latitudes.resize(locations.size());
+            m_longitudes.resize(locations.size());
+            m_altitudes.resize(locations.size());
+            for (std::size_t i = 0; i < locations.size(); ++i)
+            {
+                m_latitudes[i] = locations[i].latitude;
+                m_longitudes[i] = locations[i].longitude;
+                m_altitudes[i] = locations[i].altitude;
+            }
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            m_latitudes.reserve(capacity);
+            m_longitudes.reserve(capacity);
+            m_altitudes.reserve(capacity);
+        }
+
+        void push_back(const Location &location)
+        {
+            m_latitudes.push_back(location.latitude);
+            m_longitudes.push_back(location.longitude);
+            m_altitudes.push_back(location.altitude);
+        }
+
+        void clear()
+        {
+            m_latitudes.clear();
+            m_longitudes.clear();
+            m_altitudes.clear();
+        }
+
+        std::size_t size() const
+        {
+            return m_latitudes.size();
+        }
+
+        bool empty() const
+        {
+            return m_latitudes.empty();
+        }
+
+        Location operator[](std::size_t index) const
+        {
+            return {m_latitudes[index], m_longitudes[index], m_altitudes[index]};
+        }
+
+        // Transposes the batch back, @p out must hold size() locations
+        void copyTo(std::span<Location> out) const
+        {
+            if (out.size() < size())
+            {
+                throw std::invalid_argument("LocationBatch::copyTo output too small");
+            }
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                out[i] = {m_latitudes[i], m_longitudes[i], m_altitudes[i]};
+            }
+        }
+
+        std::vector<Location> toLocations() const
+        {
+            std::vector<Location> locations(size());
+            copyTo(locations);
+            return locations;
+        }
+
+        std::span<const double> latitudes() const { return m_latitudes; }
+        std::span<const double> longitudes() const { return m_longitudes; }
+        std::span<const double> altitudes() const { return m_altitudes; }
+
+        LocationColumns<1> columns() const
+        {
+            return {m_latitudes.data(), m_longitudes.data(), m_altitudes.data(), size()};
+        }
+
+    private:
+        Column m_latitudes;
+        Column m_longitudes;
+        Column m_altitudes;
+    };
+
+    /**
+     * @brief Smallest box holding a batch of locations.
+     */
+    struct GeoBounds
+    {
+        double minLatitude = std::numeric_limits<double>::infinity();
+        double maxLatitude = -std::numeric_limits<double>::infinity();
+        double minLongitude = std::numeric_limits<double>::infinity();
+        double maxLongitude = -std::numeric_limits<double>::infinity();
+        double minAltitude = std::numeric_limits<double>::infinity();
+        double maxAltitude = -std::numeric_limits<double>::infinity();
+    };
+
+    /**
+     * @brief Kernels over LocationColumns, written as branch free loops over contiguous
+     *        arrays so the compiler can vectorize them.
+     *
+     * Distances and local coordinates use the same equirectangular approximation as
+     * geo::ArrivalDetector, around the given origin: well below GPS noise over a few
+     * kilometers, use geo::distance() for single far apart points.
+     */
+    namespace batch
+    {
+        namespace detail
+        {
+            // geo::longitudeDelta() as selects instead of branches
+            inline double foldLongitude(double delta)
+            {
+                delta = delta > 180.0 ? delta - 360.0 : delta;
+                return delta < -180.0 ? delta + 360.0 : delta;
+            }
+
+            template <std::size_t Stride>
+            void checkOutput(const LocationColumns<Stride> &in, std::span<double> out)
+            {
+                if (out.size() < in.size)
+                {
+                    throw std::invalid_argument("Batch kernel output too small");
+                }
+            }
+        }
+
+        template <std::size_t Stride>
+        GeoBounds bounds(const LocationColumns<Stride> &in)
+        {
+            GeoBounds box;
+            for (std::size_t i = 0; i < in.size; ++i)
+            {
+                box.minLatitude = std::min(box.minLatitude, in.latitude[i * Stride]);
+                box.maxLatitude = std::max(box.maxLatitude, in.latitude[i * Stride]);
+                box.minLongitude = std::min(box.minLongitude, in.longitude[i * Stride]);
+                box.maxLongitude = std::max(box.maxLongitude, in.longitude[i * Stride]);
+                box.minAltitude = std::min(box.minAltitude, in.altitude[i * Stride]);
+                box.maxAltitude = std::max(box.maxAltitude, in.altitude[i * Stride]);
+            }
+            return box;
+        }
+
+        /**
+         * @brief Local east/north/up meters of every location relative to @p origin.
+         * @throws std::invalid_argument If an output holds fewer than in.size values.
+         */
+        template <std::size_t Stride>
+        void toEnu(const LocationColumns<Stride> &in, const Location &origin,
+                   std::span<double> east, std::span<double> north, std::span<double> up)
+        {
+            detail::checkOutput(in, east);
+            detail::checkOutput(in, north);
+            detail::checkOutput(in, up);
+            const double metersPerDegreeLongitude = geo::kMetersPerDegree * std::cos(origin.latitude * geo::kRadiansPerDegree);
+            double *__restrict x = east.data();
+            double *__restrict y = north.data();
+            double *__restrict z = up.data();
+            for (std::size_t i = 0; i < in.size; ++i)
+            {
+                x[i] = detail::foldLongitude(in.longitude[i * Stride] - origin.longitude) * metersPerDegreeLongitude;
+                y[i] = (in.latitude[i * Stride] - origin.latitude) * geo::kMetersPerDegree;
+                z[i] = in.altitude[i * Stride] - origin.altitude;
+            }
+        }
+
+        /**
+         * @brief 3D distance in meters from @p origin to every location.
+         * @throws std::invalid_argument If @p out holds fewer than in.size values.
+         */
+        template <std::size_t Stride>
+        void distances(const LocationColumns<Stride> &in, const Location &origin, std::span<double> out)
+        {
+            detail::checkOutput(in, out);
+            const double metersPerDegreeLongitude = geo::kMetersPerDegree * std::cos(origin.latitude * geo::kRadiansPerDegree);
+            double *__restrict d = out.data();
+            for (std::size_t i = 0; i < in.size; ++i)
+            {
+                const double dx = detail::foldLongitude(in.longitude[i * Stride] - origin.longitude) * metersPerDegreeLongitude;
+                const double dy = (in.latitude[i * Stride] - origin.latitude) * geo::kMetersPerDegree;
+                const double dz = in.altitude[i * Stride] - origin.altitude;
+                d[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+        }
+
+        /**
+         * @brief Bearing in degrees clockwise from north, in [0, 360), from @p origin to every location.
+         * @throws std::invalid_argument If @p out holds fewer than in.size values.
+         */
+        template <std::size_t Stride>
+        void bearings(const LocationColumns<Stride> &in, const Location &origin, std::span<double> out)
+        {
+            detail::checkOutput(in, out);
+            const double metersPerDegreeLongitude = geo::kMetersPerDegree * std::cos(origin.latitude * geo::kRadiansPerDegree);
+            double *__restrict b = out.data();
+            for (std::size_t i = 0; i < in.size; ++i)
+            {
+                const double dx = detail::foldLongitude(in.longitude[i * Stride] - origin.longitude) * metersPerDegreeLongitude;
+                const double dy = (in.latitude[i * Stride] - origin.latitude) * geo::kMetersPerDegree;
+                const double degrees = std::atan2(dx, dy) / geo::kRadiansPerDegree;
+                b[i] = degrees < 0.0 ? degrees + 360.0 : degrees;
+            }
+        }
+    }
+}
+
+#endif // LOCATION_BATCH_HPP
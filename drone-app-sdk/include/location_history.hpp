@@ -0,0 +1,133 @@
+#ifndef LOCATION_HISTORY_HPP
+#define LOCATION_HISTORY_HPP
+
+#include "icd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace drone_sdk
+{
+    struct LocationSample
+    {
+        std::chrono::steady_clock::time_point timestamp;
+        Location location;
+    };
+
+    /**
+     * @brief Compressed in-memory history of the positions of one drone (Gorilla style).
+     *
+     * Samples are packed into blocks of a bit stream. Timestamps are stored as delta of
+     * deltas, so a steady GPS rate costs one bit per sample. Coordinates are stored in one of two ways:
+     *  - QUANTIZED (default): each coordinate is rounded to a fixed step and stored as delta of
+     *    deltas as well, a handful of bits per coordinate while the drone flies smoothly.
+     *  - XOR: the doubles are stored losslessly as XOR with the previous value. Changes in
+     *    the low mantissa bits of a moving drone keep this to roughly 2 to 3 times smaller than raw.
+     *
+     * Full blocks are immutable and shared with readers, so reads decode without holding up
+     * append(), which may be called from the GPS thread while other threads read.
+     */
+    class LocationHistory
+    {
+    public:
+        enum class Encoding
+        {
+            QUANTIZED = 0,
+            XOR
+        };
+
+        struct Options
+        {
+            Encoding encoding = Encoding::QUANTIZED;
+            double degreesStep = 1e-7;  ///< Latitude/longitude step when quantized, about 1 cm.
+            double metersStep = 0.01;   ///< Altitude step when quantized.
+            std::chrono::steady_clock::duration timeStep = std::chrono::milliseconds(1); ///< Timestamps are rounded down to it.
+            std::size_t samplesPerBlock = 1024; ///< Granularity of range lookups.
+        };
+
+        LocationHistory() : LocationHistory(Options{}) {}
+
+        /**
+         * @throws std::invalid_argument If a step is not positive or samplesPerBlock is 0.
+         */
+        explicit LocationHistory(const Options &options);
+
+        LocationHistory(const LocationHistory &) = delete;
+        LocationHistory &operator=(const LocationHistory &) = delete;
+
+        /**
+         * @brief Records a position. Timestamps are expected in order, an earlier one is
+         *        recorded at the time of the previous sample.
+         */
+        void append(std::chrono::steady_clock::time_point timestamp, const Location &location);
+
+        // Number of samples recorded
+        std::size_t size() const;
+
+        // Bytes of compressed data, for comparison with size() * sizeof(LocationSample)
+        std::size_t compressedBytes() const;
+
+        void clear();
+
+        /**
+         * @brief Calls @p visit with every sample from @p begin to @p end (both included), in order.
+         * @details Only the blocks overlapping the range are decoded.
+         */
+        void forEach(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                     const std::function<void(const LocationSample &)> &visit) const;
+
+        // Samples from @p begin to @p end, both included
+        std::vector<LocationSample> range(std::chrono::steady_clock::time_point begin,
+                                          std::chrono::steady_clock::time_point end) const;
+
+        /**
+         * @brief At most one sample per @p interval from @p begin to @p end: the first sample
+         *        of every interval that has one.
+         * @throws std::invalid_argument If @p interval is not positive.
+         */
+        std::vector<LocationSample> downsample(std::chrono::steady_clock::time_point begin,
+                                               std::chrono::steady_clock::time_point end,
+                                               std::chrono::steady_clock::duration interval) const;
+
+    private:
+        struct Block
+        {
+            std::vector<std::uint64_t> words; ///< Bit stream, most significant bit first.
+            std::size_t bits = 0;
+            std::size_t count = 0;
+            std::int64_t firstTick = 0;
+            std::int64_t lastTick = 0;
+        };
+
+        // Encoder state carried from one sample to the next within a block
+        struct EncoderState
+        {
+            std::int64_t tick = 0;
+            std::int64_t tickDelta = 0;
+            std::int64_t values[3] = {};      ///< Quantized coordinates, or the bits of the doubles.
+            std::int64_t valueDeltas[3] = {}; ///< QUANTIZED only.
+            int leading[3] = {-1, -1, -1};    ///< XOR only, window of the last value written.
+            int trailing[3] = {};
+        };
+
+        void encode(Block &block, std::int64_t tick, const Location &location);
+        void decode(const Block &block, std::int64_t firstTick, std::int64_t lastTick,
+                    const std::function<void(const LocationSample &)> &visit) const;
+
+        const Options m_options;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::shared_ptr<const Block>> m_blocks; ///< Full blocks, oldest first.
+        Block m_open;                                       ///< Block being appended to.
+        EncoderState m_state;
+        std::size_t m_sealedSamples = 0;
+        std::size_t m_sealedBytes = 0;
+    };
+}
+
+#endif // LOCATION_HISTORY_HPP
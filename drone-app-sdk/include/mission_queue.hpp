@@ -0,0 +1,84 @@
+#ifndef MISSION_QUEUE_HPP
+#define MISSION_QUEUE_HPP
+
+#include "icd.hpp"
+#include "path.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace drone_sdk
+{
+    /**
+     * @brief A GOTO or PATH mission waiting in the mission queue.
+     */
+    struct Mission
+    {
+        CurrentMission type = CurrentMission::GOTO;
+        Location destination; ///< Target of a GOTO mission.
+        Path path;            ///< Waypoints of a PATH mission.
+
+        static Mission goTo(const Location &destination)
+        {
+            return {CurrentMission::GOTO, destination, Path{}};
+        }
+
+        static Mission followPath(Path waypoints)
+        {
+            return {CurrentMission::PATH, Location{}, std::move(waypoints)};
+        }
+    };
+
+    /**
+     * @brief Missions to fly one after the other, filled by the operator and drained when the
+     *        current mission completes, possibly on another thread.
+     */
+    class MissionQueue
+    {
+    public:
+        void pushBack(Mission mission)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_missions.push_back(std::move(mission));
+        }
+
+        void pushFront(Mission mission)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_missions.push_front(std::move(mission));
+        }
+
+        std::optional<Mission> pop()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_missions.empty())
+            {
+                return std::nullopt;
+            }
+            Mission next = std::move(m_missions.front());
+            m_missions.pop_front();
+            return next;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_missions.clear();
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_missions.size();
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::deque<Mission> m_missions;
+    };
+}
+
+#endif // MISSION_QUEUE_HPP
@@ -0,0 +1,71 @@
+#ifndef MPSC_INBOX_HPP
+#define MPSC_INBOX_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// Unbounded lock-free multi-producer/single-consumer queue (Vyukov's intrusive node queue).
+// Any number of threads may call push(), which is one atomic exchange and never waits for
+// the consumer or the other producers. Exactly one thread may call tryPop().
+// Elements pushed by one thread are popped in the order that thread pushed them.
+template <typename T>
+class MpscInbox
+{
+public:
+    MpscInbox()
+        : m_tail(new Node)
+    {
+        m_head.store(m_tail, std::memory_order_relaxed);
+    }
+
+    ~MpscInbox()
+    {
+        while (m_tail != nullptr)
+        {
+            Node *next = m_tail->next.load(std::memory_order_relaxed);
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    MpscInbox(const MpscInbox &) = delete;
+    MpscInbox &operator=(const MpscInbox &) = delete;
+
+    // Producer side, from any thread
+    void push(T value)
+    {
+        Node *node = new Node;
+        node->value.emplace(std::move(value));
+        Node *previous = m_head.exchange(node, std::memory_order_acq_rel);
+        // Until this store the consumer sees the queue end at previous, see tryPop()
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer side: returns false when empty, or when a producer is between the two steps of push()
+    bool tryPop(T &value)
+    {
+        Node *next = m_tail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value = std::move(*next->value);
+        next->value.reset(); // next becomes the new stub
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        std::optional<T> value;
+    };
+
+    alignas(64) std::atomic<Node *> m_head; // Last node pushed, shared by the producers
+    alignas(64) Node *m_tail;               // Stub before the next element, consumer only
+};
+
+#endif // MPSC_INBOX_HPP
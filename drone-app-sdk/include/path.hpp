@@ -0,0 +1,283 @@
+#ifndef PATH_HPP
+#define PATH_HPP
+
+#include "icd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace drone_sdk
+{
+    /**
+     * @brief Waypoints of a PATH mission, allocated once and consumed in place.
+     *
+     * The waypoints live in contiguous immutable storage that is shared, never copied; the
+     * Path itself only holds a view of it and a cursor to the next waypoint. A Path is
+     * move-only, so handing it from the SDK down to the command state machine moves a few
+     * pointers no matter how many waypoints it has.
+     *
+     * A path may carry a route, a subset of its waypoints that is actually flown (see
+     * simplifyPath()). The queue-like accessors then walk the route while pop() still reports
+     * every original waypoint covered by the leg, so waypoint callbacks see the full path.
+     *
+     * Waypoints not reached yet can be edited in place while the mission flies the path.
+     */
+    class Path
+    {
+    public:
+        Path() = default;
+
+        // Takes ownership of the waypoints without copying them
+        explicit Path(std::vector<Location> waypoints)
+            : m_owned(std::make_shared<std::vector<Location>>(std::move(waypoints)))
+        {
+            m_points = std::span<const Location>(m_owned->data(), m_owned->size());
+            m_storage = m_owned;
+        }
+
+        Path(std::initializer_list<Location> waypoints) : Path(std::vector<Location>(waypoints)) {}
+
+        /**
+         * @brief Uses waypoints kept alive by someone else, e.g. a mapped file.
+         * @param owner Keeps the memory behind @p waypoints valid for the lifetime of the path.
+         * @param waypoints The waypoints, not copied.
+         */
+        Path(std::shared_ptr<const void> owner, std::span<const Location> waypoints)
+            : m_storage(std::move(owner)), m_points(waypoints) {}
+
+        /**
+         * @brief Builds a path from the legacy queue based API, the only place waypoints are copied.
+         */
+        static Path fromQueue(std::queue<Location> waypoints)
+        {
+            std::vector<Location> points;
+            points.reserve(waypoints.size());
+            while (!waypoints.empty())
+            {
+                points.push_back(waypoints.front());
+                waypoints.pop();
+            }
+            return Path(std::move(points));
+        }
+
+        Path(Path &&other) noexcept
+            : m_storage(std::move(other.m_storage)), m_owned(std::move(other.m_owned)), m_points(other.m_points),
+              m_route(std::move(other.m_route)), m_cursor(other.m_cursor)
+        {
+            other.m_points = {};
+            other.m_route.clear();
+            other.m_cursor = 0;
+        }
+
+        Path &operator=(Path &&other) noexcept
+        {
+            if (this != &other)
+            {
+                m_storage = std::move(other.m_storage);
+                m_owned = std::move(other.m_owned);
+                m_points = other.m_points;
+                m_route = std::move(other.m_route);
+                m_cursor = other.m_cursor;
+                other.m_points = {};
+                other.m_route.clear();
+                other.m_cursor = 0;
+            }
+            return *this;
+        }
+
+        Path(const Path &) = delete;
+        Path &operator=(const Path &) = delete;
+
+        // Queue-like access to the waypoints still ahead (on the route, if there is one)
+        bool empty() const
+        {
+            return m_cursor >= legCount();
+        }
+
+        std::size_t size() const
+        {
+            return legCount() - m_cursor;
+        }
+
+        const Location &front() const
+        {
+            if (empty())
+            {
+                throw std::out_of_range("Path has no waypoints left");
+            }
+            return m_points[position()];
+        }
+
+        /**
+         * @brief Moves past front().
+         * @return The original waypoints covered by reaching front(): just front() itself, or on
+         *         a route also the skipped waypoints of the leg leading to it.
+         */
+        std::span<const Location> pop()
+        {
+            if (empty())
+            {
+                return {};
+            }
+            const std::size_t end = position() + 1;
+            const std::size_t begin = (m_route.empty() || m_cursor == 0) ? end - 1 : m_route[m_cursor - 1] + 1;
+            ++m_cursor;
+            return m_points.subspan(begin, end - begin);
+        }
+
+        // Original waypoints not reached yet
+        std::span<const Location> remaining() const
+        {
+            return m_points.subspan(position());
+        }
+
+        // Every waypoint of the path, including the ones already consumed
+        std::span<const Location> waypoints() const
+        {
+            return m_points;
+        }
+
+        // Index of the next waypoint in waypoints(), its size once all were reached
+        std::size_t position() const
+        {
+            if (m_route.empty())
+            {
+                return m_cursor;
+            }
+            return m_cursor < m_route.size() ? m_route[m_cursor] : m_points.size();
+        }
+
+        /**
+         * @brief Flies only some of the waypoints still ahead.
+         * @param route Strictly increasing indices into waypoints(), starting at position() and
+         *        ending at the last waypoint.
+         * @throws std::invalid_argument If the route does not satisfy the above.
+         */
+        void setRoute(std::vector<std::size_t> route)
+        {
+            if (empty() || route.empty() || route.front() != position() || route.back() != m_points.size() - 1)
+            {
+                throw std::invalid_argument("Route must run from the next waypoint to the last one");
+            }
+            for (std::size_t i = 1; i < route.size(); ++i)
+            {
+                if (route[i] <= route[i - 1])
+                {
+                    throw std::invalid_argument("Route indices must be strictly increasing");
+                }
+            }
+            m_route = std::move(route);
+            m_cursor = 0;
+        }
+
+        // Indices into waypoints() of the routed waypoints still ahead, empty without a route
+        std::span<const std::size_t> route() const
+        {
+            return std::span<const std::size_t>(m_route).subspan(std::min(m_cursor, m_route.size()));
+        }
+
+        // Number of waypoints flown, the route if there is one
+        std::size_t routeSize() const
+        {
+            return legCount();
+        }
+
+        /**
+         * @brief Adds waypoints after the last one, amortized O(k) for k waypoints.
+         * @details Like the other edits, this invalidates spans returned earlier. A path over
+         *          memory it does not own (e.g. a mapped file) copies it once on the first edit.
+         */
+        void append(std::span<const Location> waypoints)
+        {
+            replaceRemaining(m_points.size(), waypoints);
+        }
+
+        // Index of the first waypoint not popped yet, including ones a route skips
+        std::size_t editableFrom() const
+        {
+            if (m_route.empty())
+            {
+                return m_cursor;
+            }
+            return m_cursor == 0 ? m_route.front() : m_route[m_cursor - 1] + 1;
+        }
+
+        /**
+         * @brief Replaces the waypoints from @p fromIndex on.
+         * @details On a route the new waypoints are all flown, the untouched part keeps its route.
+         * @param fromIndex Index into waypoints(), from editableFrom() up to the number of waypoints.
+         * @throws std::out_of_range If @p fromIndex is outside that range.
+         */
+        void replaceRemaining(std::size_t fromIndex, std::span<const Location> waypoints)
+        {
+            const std::size_t next = editableFrom();
+            if (fromIndex < next || fromIndex > m_points.size())
+            {
+                throw std::out_of_range("Only waypoints not reached yet can be replaced");
+            }
+
+            std::vector<Location> &points = ownedPoints();
+            points.resize(fromIndex);
+            points.insert(points.end(), waypoints.begin(), waypoints.end());
+            m_points = std::span<const Location>(points.data(), points.size());
+
+            if (!m_route.empty())
+            {
+                while (m_route.size() > m_cursor && m_route.back() >= fromIndex)
+                {
+                    m_route.pop_back();
+                }
+                // Waypoints kept up to fromIndex end in a routed one, so none is left uncovered
+                if (fromIndex > next && (m_route.size() == m_cursor || m_route.back() != fromIndex - 1))
+                {
+                    m_route.push_back(fromIndex - 1);
+                }
+                for (std::size_t index = fromIndex; index < points.size(); ++index)
+                {
+                    m_route.push_back(index);
+                }
+            }
+        }
+
+        /**
+         * @brief Drops the waypoints from @p endIndex on.
+         * @throws std::out_of_range If @p endIndex is before editableFrom() or past the end.
+         */
+        void truncate(std::size_t endIndex)
+        {
+            replaceRemaining(endIndex, {});
+        }
+
+    private:
+        // The waypoints as a vector this path may change, copied the first time if needed
+        std::vector<Location> &ownedPoints()
+        {
+            if (!m_owned)
+            {
+                m_owned = std::make_shared<std::vector<Location>>(m_points.begin(), m_points.end());
+                m_storage = m_owned;
+            }
+            return *m_owned;
+        }
+
+        std::size_t legCount() const
+        {
+            return m_route.empty() ? m_points.size() : m_route.size();
+        }
+
+        std::shared_ptr<const void> m_storage;           ///< Keeps the waypoint memory alive.
+        std::shared_ptr<std::vector<Location>> m_owned; ///< Same as m_storage when the path owns its waypoints.
+        std::span<const Location> m_points;
+        std::vector<std::size_t> m_route; ///< Indices into m_points that are flown, empty for all.
+        std::size_t m_cursor = 0;         ///< Next waypoint, indexes m_route when there is one.
+    };
+}
+
+#endif // PATH_HPP
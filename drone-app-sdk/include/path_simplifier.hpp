@@ -0,0 +1,39 @@
+#ifndef PATH_SIMPLIFIER_HPP
+#define PATH_SIMPLIFIER_HPP
+
+#include "icd.hpp"
+#include "path.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace drone_sdk
+{
+    /**
+     * @brief Douglas-Peucker simplification of a polyline of waypoints.
+     *
+     * The waypoints are projected once into local east/north/up meters around the first one
+     * and kept as separate coordinate arrays, so the distance scan of each segment is a
+     * branch free loop the compiler can vectorize. Segments are split with an explicit stack,
+     * which keeps deep recursion off the call stack for very long paths.
+     *
+     * @param waypoints The polyline.
+     * @param toleranceMeters Largest allowed 3D distance between a dropped waypoint and the
+     *        segment that replaces it.
+     * @return Increasing indices of the waypoints to keep, always including the first and last.
+     */
+    std::vector<std::size_t> douglasPeucker(std::span<const Location> waypoints, double toleranceMeters);
+
+    /**
+     * @brief Restricts a path to the waypoints that matter for flying it.
+     * @details The waypoints still ahead are simplified with douglasPeucker() and set as the
+     *          route of @p path. The original waypoints stay in the path, so the mission still
+     *          reports each of them as reached.
+     * @param path The path to simplify, returned with its route set.
+     * @param toleranceMeters Allowed deviation in meters, a path is returned unchanged for 0.
+     */
+    Path simplifyPath(Path path, double toleranceMeters);
+}
+
+#endif // PATH_SIMPLIFIER_HPP
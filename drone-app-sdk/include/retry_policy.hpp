@@ -0,0 +1,271 @@
+#ifndef RETRY_POLICY_HPP
+#define RETRY_POLICY_HPP
+
+#include "icd.hpp"
+#include "seqlock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace drone_sdk
+{
+    /**
+     * @brief Whether repeating a command can change the outcome of the first attempt.
+     * @details A command lost with a CONNECTION_ERROR may still have reached the drone. Only
+     *          commands with an absolute target (go to, go home, arm, land) are safe to repeat,
+     *          a repeated take off could climb twice.
+     */
+    enum class Idempotency
+    {
+        IDEMPOTENT = 0,
+        NON_IDEMPOTENT
+    };
+
+    /**
+     * @brief How transient flight controller failures (CONNECTION_ERROR, HARDWARE_ERROR) are retried.
+     *
+     * The n-th retry waits initialBackoff * multiplier^(n-1), capped at maxBackoff, minus a random
+     * share of up to @c jitter of it so a fleet does not retry in lockstep. Retries stop after
+     * maxAttempts or once the next wait would end past the deadline of the command.
+     */
+    struct RetryPolicy
+    {
+        int maxAttempts = 4; ///< Including the first one, 1 disables retries.
+        std::chrono::milliseconds initialBackoff{50};
+        double multiplier = 2.0;
+        std::chrono::milliseconds maxBackoff{500};
+        double jitter = 0.5; ///< Share of the backoff that is randomized, 0 to 1.
+        std::chrono::milliseconds deadline{2000}; ///< Per command, no retry starts after it.
+
+        static RetryPolicy none()
+        {
+            RetryPolicy policy;
+            policy.maxAttempts = 1;
+            return policy;
+        }
+    };
+
+    struct RetryMetrics
+    {
+        std::uint64_t commands = 0;         ///< Commands run.
+        std::uint64_t retries = 0;          ///< Attempts after the first.
+        std::uint64_t recovered = 0;        ///< Commands that succeeded after a retry.
+        std::uint64_t exhausted = 0;        ///< Commands that failed transiently on their last attempt.
+        std::uint64_t deadlineExceeded = 0; ///< Of those, stopped by the deadline rather than maxAttempts.
+        std::uint64_t cancelled = 0;        ///< Of those, stopped by a later command.
+        std::chrono::nanoseconds retryTime{0}; ///< Time from first failures to final outcomes.
+    };
+
+    /**
+     * @brief Runs commands under a RetryPolicy and keeps RetryMetrics.
+     * @details The waits between attempts are handed to the schedule, which runs the next
+     *          attempt once they are over (the command worker queues it as a delayed job), so
+     *          other commands run meanwhile. The latest command wins: starting one cancels the
+     *          retries still pending for the ones before it.
+     *
+     *          run() and the attempts are meant for one thread (the command worker). The policy
+     *          and the metrics may be changed and read from any thread.
+     */
+    class Retrier
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Done = std::move_only_function<void(FlightControllerStatus)>;
+        using Schedule = std::function<void(Clock::duration, std::move_only_function<void()>)>;
+
+        /**
+         * @param schedule Runs a retry after the given wait, on the thread calling run(). Without
+         *                 one the retrier sleeps in place, only fit for a thread of its own.
+         */
+        explicit Retrier(RetryPolicy policy = {}, Schedule schedule = {}, std::uint32_t seed = std::random_device{}())
+            : m_policy(policy), m_schedule(std::move(schedule)), m_random(seed)
+        {
+            if (!m_schedule)
+            {
+                m_schedule = [](Clock::duration delay, std::move_only_function<void()> retry)
+                {
+                    std::this_thread::sleep_for(delay);
+                    retry();
+                };
+            }
+        }
+
+        Retrier(const Retrier &) = delete;
+        Retrier &operator=(const Retrier &) = delete;
+
+        void setPolicy(const RetryPolicy &policy)
+        {
+            m_policy.store(policy);
+        }
+
+        RetryPolicy policy() const
+        {
+            return m_policy.load();
+        }
+
+        RetryMetrics metrics() const
+        {
+            return m_metrics.load();
+        }
+
+        static bool isTransient(FlightControllerStatus status)
+        {
+            return status == FlightControllerStatus::CONNECTION_ERROR || status == FlightControllerStatus::HARDWARE_ERROR;
+        }
+
+        /**
+         * @brief Wait before retry number @p retry (1 for the first retry), without jitter.
+         */
+        static Clock::duration backoff(const RetryPolicy &policy, int retry)
+        {
+            const double scaled = static_cast<double>(policy.initialBackoff.count()) *
+                                  std::pow(policy.multiplier, static_cast<double>(retry - 1));
+            const double capped = std::min(scaled, static_cast<double>(policy.maxBackoff.count()));
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(capped));
+        }
+
+        /**
+         * @brief Calls @p attempt until it succeeds, fails for good, the policy gives up or a
+         *        later command cancels its retries.
+         * @param attempt Callable returning FlightControllerStatus, kept until the last attempt.
+         * @param done Called with the status of the last attempt, may be empty.
+         */
+        template <typename Attempt>
+        void run(Idempotency idempotency, Attempt attempt, Done done)
+        {
+            const RetryPolicy policy = m_policy.load();
+            const Clock::time_point start = Clock::now();
+            const std::uint64_t generation = ++m_generation;
+            const FlightControllerStatus status = attempt();
+            if (!isTransient(status) || idempotency == Idempotency::NON_IDEMPOTENT || policy.maxAttempts <= 1)
+            {
+                m_metrics.modify([status](RetryMetrics &metrics)
+                                 {
+                                     ++metrics.commands;
+                                     metrics.exhausted += isTransient(status) ? 1 : 0; });
+                if (done)
+                {
+                    done(status);
+                }
+                return;
+            }
+
+            auto retrying = std::make_unique<Retrying<Attempt>>(std::move(attempt));
+            retrying->done = std::move(done);
+            retrying->policy = policy;
+            retrying->start = start;
+            retrying->firstFailure = Clock::now();
+            retrying->generation = generation;
+            retrying->status = status;
+            retry(std::move(retrying));
+        }
+
+    private:
+        enum class Outcome
+        {
+            FINISHED = 0,
+            DEADLINE,
+            CANCELLED
+        };
+
+        // A command between attempts, moved from one scheduled retry to the next
+        template <typename Attempt>
+        struct Retrying
+        {
+            explicit Retrying(Attempt &&command) : attempt(std::move(command)) {}
+
+            Attempt attempt;
+            Done done;
+            RetryPolicy policy;
+            Clock::time_point start;
+            Clock::time_point firstFailure;
+            Clock::duration waited{0};
+            std::uint64_t generation = 0;
+            std::uint64_t retries = 0;
+            FlightControllerStatus status = FlightControllerStatus::SUCCESS; ///< Of the last attempt.
+        };
+
+        // Schedules the next attempt of a command whose last one failed transiently, or gives up
+        template <typename Attempt>
+        void retry(std::unique_ptr<Retrying<Attempt>> retrying)
+        {
+            const RetryPolicy &policy = retrying->policy;
+            if (retrying->retries + 1 >= static_cast<std::uint64_t>(policy.maxAttempts))
+            {
+                finish(*retrying, Outcome::FINISHED);
+                return;
+            }
+            const Clock::duration delay = jittered(policy, backoff(policy, static_cast<int>(retrying->retries) + 1));
+            // The waits count even if the schedule ran the retry early
+            if (std::max(Clock::now() - retrying->start, retrying->waited) + delay > policy.deadline)
+            {
+                finish(*retrying, Outcome::DEADLINE);
+                return;
+            }
+            retrying->waited += delay;
+            m_schedule(delay, [this, retrying = std::move(retrying)]() mutable
+                       {
+                           if (retrying->generation != m_generation)
+                           {
+                               finish(*retrying, Outcome::CANCELLED);
+                               return;
+                           }
+                           retrying->status = retrying->attempt();
+                           ++retrying->retries;
+                           if (isTransient(retrying->status))
+                           {
+                               retry(std::move(retrying));
+                           }
+                           else
+                           {
+                               finish(*retrying, Outcome::FINISHED);
+                           } });
+        }
+
+        template <typename Attempt>
+        void finish(Retrying<Attempt> &retrying, Outcome outcome)
+        {
+            const auto spent = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - retrying.firstFailure);
+            const bool failed = isTransient(retrying.status);
+            const std::uint64_t retries = retrying.retries;
+            m_metrics.modify([&](RetryMetrics &metrics)
+                             {
+                                 ++metrics.commands;
+                                 metrics.retries += retries;
+                                 metrics.recovered += (!failed && retries > 0) ? 1 : 0;
+                                 metrics.exhausted += failed ? 1 : 0;
+                                 metrics.deadlineExceeded += (failed && outcome == Outcome::DEADLINE) ? 1 : 0;
+                                 metrics.cancelled += (failed && outcome == Outcome::CANCELLED) ? 1 : 0;
+                                 metrics.retryTime += spent; });
+            if (retrying.done)
+            {
+                retrying.done(retrying.status);
+            }
+        }
+
+        Clock::duration jittered(const RetryPolicy &policy, Clock::duration delay)
+        {
+            const double jitter = std::clamp(policy.jitter, 0.0, 1.0);
+            if (jitter == 0.0)
+            {
+                return delay;
+            }
+            std::uniform_real_distribution<double> share(0.0, jitter);
+            return std::chrono::duration_cast<Clock::duration>(delay * (1.0 - share(m_random)));
+        }
+
+        SeqLock<RetryPolicy> m_policy;
+        SeqLock<RetryMetrics> m_metrics;
+        Schedule m_schedule;
+        std::mt19937 m_random;
+        std::uint64_t m_generation = 0; ///< Of the latest command, read by the retries of earlier ones.
+    };
+}
+
+#endif // RETRY_POLICY_HPP
@@ -0,0 +1,126 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+/**
+ * @brief Publishes the latest value of a small trivially copyable struct to any number of readers.
+ *
+ * Readers never block and never write shared memory: load() copies the value and retries if a
+ * writer was active meanwhile, so polling at high rates does not slow the publishing thread.
+ * Writers are serialized by a mutex and keep a private copy, which lets several threads each
+ * update their own fields with modify().
+ *
+ * The value is kept in relaxed atomic words framed by acquire/release fences on the sequence
+ * counter, so a torn read is detected instead of being a data race.
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock values are copied byte-wise");
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+    explicit SeqLock(const T &initial) : m_shadow(initial)
+    {
+        storeWords(initial);
+    }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    /**
+     * @brief Returns a consistent copy of the latest published value.
+     */
+    T load() const
+    {
+        std::array<std::uint64_t, kWords> words;
+        while (true)
+        {
+            const std::uint64_t before = m_sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0)
+            {
+                for (std::size_t i = 0; i < kWords; ++i)
+                {
+                    words[i] = m_words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == before)
+                {
+                    break;
+                }
+            }
+        }
+
+        T value;
+        std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T)); // Trivially copyable, see static_assert
+        return value;
+    }
+
+    /**
+     * @brief Replaces the published value.
+     */
+    void store(const T &value)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_shadow = value;
+        publish();
+    }
+
+    /**
+     * @brief Applies a change to the latest value and publishes the result.
+     * @param change Callable taking T&, runs with the writer mutex held.
+     */
+    template <typename Change>
+    void modify(Change &&change)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        change(m_shadow);
+        publish();
+    }
+
+    /**
+     * @brief Number of values published so far.
+     */
+    std::uint64_t version() const
+    {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    // Expects m_writeMutex to be held
+    void publish()
+    {
+        const std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed); // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(m_shadow);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void storeWords(const T &value)
+    {
+        std::array<std::uint64_t, kWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::array<std::atomic<std::uint64_t>, kWords> m_words{};
+
+    std::mutex m_writeMutex;
+    T m_shadow; ///< Writer side copy of the published value.
+};
+
+#endif // SEQLOCK_HPP
@@ -0,0 +1,193 @@
+#ifndef DRONE_SDK_SIGNAL_HPP
+#define DRONE_SDK_SIGNAL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace drone_sdk
+{
+    namespace detail
+    {
+        // Shared between a signal's slot and the connections handed out for it
+        struct SlotState
+        {
+            std::atomic<bool> connected{true};
+        };
+    }
+
+    /**
+     * @brief Handle of a subscription made with Signal::connect().
+     * @details Stays valid after the signal is gone, disconnect() is then a no-op.
+     */
+    class Connection
+    {
+    public:
+        Connection() = default;
+        explicit Connection(std::weak_ptr<detail::SlotState> state) : m_state(std::move(state)) {}
+
+        /**
+         * @brief Stops future emissions from reaching the slot. A call already in progress on
+         *        another thread may still complete.
+         */
+        void disconnect() const
+        {
+            if (auto state = m_state.lock())
+            {
+                state->connected.store(false, std::memory_order_release);
+            }
+        }
+
+        bool connected() const
+        {
+            auto state = m_state.lock();
+            return state && state->connected.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::weak_ptr<detail::SlotState> m_state;
+    };
+
+    template <typename Signature>
+    class Signal;
+
+    /**
+     * @brief Lightweight replacement for boost::signals2::signal on the telemetry path.
+     *
+     * The slot list is immutable once published. connect() and disconnect_all_slots() build a
+     * new list under a writer mutex and swap it in atomically (copy-on-write, RCU style), so
+     * emitting takes no lock and does not allocate: it registers as a reader, walks the current
+     * list and calls every slot that is still connected. Old lists are freed by a later writer
+     * once no emission is in progress.
+     *
+     * Slots may connect and disconnect from inside an emission. Emission from several threads
+     * at once is allowed, slots must then be thread safe themselves.
+     */
+    template <typename... Args>
+    class Signal<void(Args...)>
+    {
+    public:
+        using slot_type = std::function<void(Args...)>;
+
+        Signal() : m_slots(new SlotList()) {}
+        ~Signal()
+        {
+            delete m_slots.load(std::memory_order_relaxed);
+        }
+
+        Signal(const Signal &) = delete;
+        Signal &operator=(const Signal &) = delete;
+
+        /**
+         * @brief Adds a slot, called after the slots already connected.
+         * @return A connection object for managing the subscription.
+         */
+        Connection connect(slot_type slot)
+        {
+            auto entry = std::make_shared<Slot>();
+            entry->function = std::move(slot);
+
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            const SlotList *current = m_slots.load(std::memory_order_relaxed);
+            auto next = std::make_unique<SlotList>();
+            next->reserve(current->size() + 1);
+            for (const auto &existing : *current)
+            {
+                if (existing->connected.load(std::memory_order_relaxed))
+                {
+                    next->push_back(existing); // Disconnected slots are dropped here
+                }
+            }
+            next->push_back(entry);
+            publish(std::move(next));
+
+            return Connection(std::weak_ptr<detail::SlotState>(entry));
+        }
+
+        void disconnect_all_slots()
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            for (const auto &slot : *m_slots.load(std::memory_order_relaxed))
+            {
+                slot->connected.store(false, std::memory_order_release);
+            }
+            publish(std::make_unique<SlotList>());
+        }
+
+        std::size_t num_slots() const
+        {
+            ReadGuard guard(m_readers);
+            std::size_t count = 0;
+            for (const auto &slot : *m_slots.load(std::memory_order_seq_cst))
+            {
+                count += slot->connected.load(std::memory_order_acquire) ? 1 : 0;
+            }
+            return count;
+        }
+
+        bool empty() const
+        {
+            return num_slots() == 0;
+        }
+
+        // Emit to every connected slot in connection order
+        void operator()(Args... args) const
+        {
+            ReadGuard guard(m_readers);
+            for (const auto &slot : *m_slots.load(std::memory_order_seq_cst))
+            {
+                if (slot->connected.load(std::memory_order_acquire))
+                {
+                    slot->function(args...);
+                }
+            }
+        }
+
+    private:
+        struct Slot : detail::SlotState
+        {
+            slot_type function;
+        };
+        using SlotList = std::vector<std::shared_ptr<Slot>>;
+
+        // Marks an emission in progress for as long as it lives, also when a slot throws
+        struct ReadGuard
+        {
+            explicit ReadGuard(std::atomic<std::uint32_t> &readers) : m_counter(readers)
+            {
+                m_counter.fetch_add(1, std::memory_order_seq_cst);
+            }
+            ~ReadGuard()
+            {
+                m_counter.fetch_sub(1, std::memory_order_release);
+            }
+            ReadGuard(const ReadGuard &) = delete;
+            ReadGuard &operator=(const ReadGuard &) = delete;
+
+            std::atomic<std::uint32_t> &m_counter;
+        };
+
+        // Expects m_writeMutex to be held
+        void publish(std::unique_ptr<SlotList> next)
+        {
+            m_retired.emplace_back(m_slots.exchange(next.release(), std::memory_order_seq_cst));
+            // A reader that registers after this check loads the new list, so with no reader
+            // registered now nobody can still be walking a retired one
+            if (m_readers.load(std::memory_order_seq_cst) == 0)
+            {
+                m_retired.clear();
+            }
+        }
+
+        std::atomic<SlotList *> m_slots;
+        mutable std::atomic<std::uint32_t> m_readers{0};
+        std::mutex m_writeMutex;
+        std::vector<std::unique_ptr<SlotList>> m_retired; // Replaced lists that readers may still hold
+    };
+}
+
+#endif // DRONE_SDK_SIGNAL_HPP
@@ -0,0 +1,115 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Counters of an SpscRing, as seen by the producer
+struct RingStats
+{
+    std::uint64_t pushed = 0;        // Elements accepted by the ring
+    std::uint64_t dropped = 0;       // Elements rejected because the ring was full
+    std::size_t highWaterMark = 0;   // Highest number of elements waiting at once
+    std::size_t capacity = 0;        // Number of slots in the ring
+};
+
+// Bounded lock-free single-producer/single-consumer ring buffer.
+// Exactly one thread may call tryPush() and exactly one (other) thread may call tryPop().
+// When the consumer falls behind, new elements are dropped and counted instead of blocking
+// the producer. stats() may be called from any thread.
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // Producer side: returns false (and counts a drop) when the ring is full
+    bool tryPush(const T &value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == Capacity)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == Capacity)
+            {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        m_buffer[head & kMask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+
+        m_pushed.store(m_pushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        const std::size_t depth = head + 1 - m_tail.load(std::memory_order_relaxed);
+        if (depth > m_highWaterMark.load(std::memory_order_relaxed))
+        {
+            m_highWaterMark.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Consumer side: returns false when the ring is empty
+    bool tryPop(T &value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead)
+            {
+                return false;
+            }
+        }
+
+        value = m_buffer[tail & kMask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of waiting elements, exact when called from producer or consumer
+    std::size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    RingStats stats() const
+    {
+        RingStats stats;
+        stats.pushed = m_pushed.load(std::memory_order_relaxed);
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+        stats.capacity = Capacity;
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kCacheLine = 64;
+
+    // Producer owned line: write index, its view of the read index and the counters
+    alignas(kCacheLine) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+    std::atomic<std::uint64_t> m_pushed{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::size_t> m_highWaterMark{0};
+
+    // Consumer owned line: read index and its view of the write index
+    alignas(kCacheLine) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead = 0;
+
+    alignas(kCacheLine) std::array<T, Capacity> m_buffer{};
+};
+
+#endif // SPSC_RING_HPP
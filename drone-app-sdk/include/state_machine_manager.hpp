@@ -1,36 +1,27 @@
 #ifndef STATE_MACHINE_MANAGER_HPP
 #define STATE_MACHINE_MANAGER_HPP
 
-#include "state_machines/safety_state_machine.hpp"
-#include "state_machines/flight_state_machine.hpp"
-#include "state_machines/command_state_machine.hpp"
+#include "state_machines/drone_state_machine.hpp"
 #include "icd.hpp"
+#include "geofence.hpp"
 
 #include <boost/sml.hpp>
+#include <atomic>
+#include <cstdint>
 #include <queue>
 #include <optional>
 #include <functional>
 #include <memory>
+#include <vector>
 
 class StateMachineManager
 {
 public:
     explicit StateMachineManager() = default;
     ~StateMachineManager() = default;
+    // The regions of the drone state machine need no wiring, kept for the callers that start the manager
     void start()
     {
-        m_safetySM.subscribeToGpsState([this](drone_sdk::safetyState gpsState)
-                                       { m_commandSM.handleGpsStateChange(gpsState); });
-
-        m_safetySM.subscribeToLinkState([this](drone_sdk::safetyState linkState)
-                                        { m_commandSM.handleLinkStateChange(linkState); });
-
-        // subscribe flight state machine to commands
-        m_commandSM.subscribeToState([this](drone_sdk::CommandStatus commandState)
-                                     { m_flightSM.handleCommandStateChange(commandState); });
-        // subscribe flight state machine to commands
-        m_commandSM.subscribeToMission([this](drone_sdk::CurrentMission newMission)
-                                       { m_flightSM.handleNewMission(newMission); });
     }
     // Subscription functions for external components
     void subscribeToGpsUpdates(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback)
@@ -43,45 +34,74 @@ public:
         m_linkUpdateCallback = std::move(callback);
     }
 
-    // State subscriptions
-    void subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback)
+    // State subscriptions, called on real transitions only
+    void subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback)
+    {
+        m_droneSM.subscribeToFlightState(std::move(callback));
+    }
+
+    void subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
     {
-        m_flightSM.subscribeToStateChange(std::move(callback));
+        m_droneSM.subscribeToGpsState(std::move(callback));
     }
 
-    void subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback)
+    void subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
     {
-        m_safetySM.subscribeToGpsState(std::move(callback));
+        m_droneSM.subscribeToLinkState(std::move(callback));
     }
 
-    void subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback)
+    void subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback)
     {
-        m_safetySM.subscribeToLinkState(std::move(callback));
+        m_droneSM.subscribeToGeofenceState(std::move(callback));
     }
 
-    void subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback)
+    void subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback)
     {
-        m_commandSM.subscribeToState(std::move(callback));
+        m_droneSM.subscribeToCommandState(std::move(callback));
     }
 
     void subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback)
     {
-        m_commandSM.subscribeToPathWaypoint(std::move(callback));
+        m_droneSM.subscribeToPathWaypoint(std::move(callback));
+    }
+
+    // Records the state machine events and transitions and the sensor samples, nullptr stops recording
+    void setFlightRecorder(drone_sdk::FlightRecorder *recorder)
+    {
+        m_recorder = recorder;
+        m_droneSM.setRecorder(recorder);
+    }
+
+    // Time of the state transitions, steady_clock unless a replay sets its virtual clock
+    void setClock(const drone_sdk::VirtualClock *clock)
+    {
+        m_droneSM.setClock(clock);
     }
 
     void setHome(drone_sdk::Location newHome)
     {
-        m_commandSM.setHomebase(std::move(newHome));
+        m_droneSM.setHomebase(std::move(newHome));
     }
 
     drone_sdk::Location getHome()
     {
-        return m_commandSM.getHomebase();
+        return m_droneSM.getHomebase();
+    }
+
+    void setArrivalRadius(double radiusMeters)
+    {
+        m_droneSM.setArrivalRadius(radiusMeters);
+    }
+
+    // Checked on every GPS update and for every new mission, nullptr removes the geofence
+    void setGeofence(std::shared_ptr<const drone_sdk::Geofence> geofence)
+    {
+        m_geofence.store(std::move(geofence));
     }
 
     void subscribeToCurrentDestination(std::function<void(drone_sdk::Location)> callback)
     {
-        m_commandSM.subscribeToCurrentDestination(std::move(callback));
+        m_droneSM.subscribeToCurrentDestination(std::move(callback));
     }
 
     drone_sdk::FlightControllerStatus newTask(
@@ -89,7 +109,112 @@ public:
         const std::optional<drone_sdk::Location> &singleDestination,
         const std::optional<std::queue<drone_sdk::Location>> &pathDestinations)
     {
-        return m_commandSM.handleTaskAssigned(newMission, singleDestination, pathDestinations);
+        // Only missions flying to given waypoints can cross the geofence
+        if (newMission == drone_sdk::CurrentMission::GOTO && singleDestination &&
+            checkGeofence({&*singleDestination, 1}) != drone_sdk::FlightControllerStatus::SUCCESS)
+        {
+            return drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION;
+        }
+        if (newMission == drone_sdk::CurrentMission::PATH && pathDestinations)
+        {
+            std::vector<drone_sdk::Location> waypoints;
+            for (auto queue = *pathDestinations; !queue.empty(); queue.pop())
+            {
+                waypoints.push_back(queue.front());
+            }
+            if (checkGeofence(waypoints) != drone_sdk::FlightControllerStatus::SUCCESS)
+            {
+                return drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION;
+            }
+        }
+        return m_droneSM.handleTaskAssigned(newMission, singleDestination, pathDestinations);
+    }
+
+    drone_sdk::FlightControllerStatus newPathTask(drone_sdk::Path path)
+    {
+        if (checkGeofence(path, m_lastLocation) != drone_sdk::FlightControllerStatus::SUCCESS)
+        {
+            return drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION;
+        }
+        return m_droneSM.handlePathAssigned(std::move(path));
+    }
+
+    // Edits of the running PATH mission, the new legs are checked against the geofence
+    drone_sdk::FlightControllerStatus appendWaypoints(std::span<const drone_sdk::Location> waypoints)
+    {
+        return replaceRemaining(m_droneSM.getPath().waypoints().size(), waypoints);
+    }
+
+    drone_sdk::FlightControllerStatus replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+    {
+        const auto current = m_droneSM.getPath().waypoints();
+        if (fromIndex > 0 && fromIndex <= current.size() &&
+            checkGeofence(waypoints, current[fromIndex - 1]) != drone_sdk::FlightControllerStatus::SUCCESS)
+        {
+            return drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION;
+        }
+        return m_droneSM.replaceRemaining(fromIndex, waypoints);
+    }
+
+    drone_sdk::FlightControllerStatus truncatePath(std::size_t endIndex)
+    {
+        return m_droneSM.truncatePath(endIndex);
+    }
+
+    /**
+     * @brief Checks the legs through @p waypoints against the geofence.
+     * @param start Where the first leg starts, the last GPS fix unless given.
+     * @retval FlightControllerStatus GEOFENCE_VIOLATION if a leg crosses the geofence, SUCCESS otherwise.
+     */
+    drone_sdk::FlightControllerStatus checkGeofence(std::span<const drone_sdk::Location> waypoints) const
+    {
+        return checkGeofence(waypoints, m_lastLocation);
+    }
+
+    /**
+     * @brief Checks the legs @p path flies, the ones between its routed waypoints on a simplified path.
+     * @details A shortcut between routed waypoints may cut through a zone the original waypoints go around.
+     */
+    drone_sdk::FlightControllerStatus checkGeofence(const drone_sdk::Path &path, const std::optional<drone_sdk::Location> &start) const
+    {
+        const auto route = path.route();
+        if (route.empty())
+        {
+            return checkGeofence(path.remaining(), start);
+        }
+        std::vector<drone_sdk::Location> flown;
+        flown.reserve(route.size());
+        for (const std::size_t index : route)
+        {
+            flown.push_back(path.waypoints()[index]);
+        }
+        return checkGeofence(flown, start);
+    }
+
+    drone_sdk::FlightControllerStatus checkGeofence(std::span<const drone_sdk::Location> waypoints, const std::optional<drone_sdk::Location> &start) const
+    {
+        const auto geofence = m_geofence.load();
+        if (geofence && geofence->firstViolation(waypoints, start))
+        {
+            return drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION;
+        }
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    drone_sdk::CommandStatus getCommandState() const
+    {
+        return m_droneSM.getCommandState();
+    }
+
+    drone_sdk::CurrentMission getCurrentMission() const
+    {
+        return m_droneSM.getCurrentMission();
+    }
+
+    // Events that changed no state, safe to read from any thread
+    std::uint64_t suppressedStateEvents() const
+    {
+        return m_droneSM.suppressedEvents();
     }
 
     void handleGpsUpdate(const drone_sdk::Location &location, const drone_sdk::SignalQuality quality)
@@ -97,8 +222,15 @@ public:
         if (m_gpsUpdateCallback)
             m_gpsUpdateCallback(location, quality);
 
-        m_safetySM.handleGpsSignal(quality);
-        m_commandSM.handleGpsLocationUpdate(location);
+        if (m_recorder)
+            m_recorder->recordGpsSample(location, quality);
+        m_droneSM.handleGpsSignal(quality);
+        m_lastLocation = location;
+        if (const auto geofence = m_geofence.load())
+        {
+            m_droneSM.handleGeofence(geofence->violates(location));
+        }
+        m_droneSM.handleGpsLocationUpdate(location);
     }
 
     void handleLinkUpdate(drone_sdk::SignalQuality quality)
@@ -106,17 +238,21 @@ public:
         if (m_linkUpdateCallback)
             m_linkUpdateCallback(quality);
 
-        m_safetySM.handleLinkSignal(quality);
+        if (m_recorder)
+            m_recorder->recordLinkSample(quality);
+        m_droneSM.handleLinkSignal(quality);
     }
 
 private:
-    flightstatemachine::FlightStateMachine m_flightSM;
-    safetystatemachine::SafetyStateMachine m_safetySM;
-    commandstatemachine::CommandStateMachine m_commandSM;
+    dronestatemachine::DroneStateMachine m_droneSM;
+    drone_sdk::FlightRecorder *m_recorder = nullptr;
 
     // Callback functions for GPS and Link updates
     std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> m_gpsUpdateCallback;
     std::function<void(drone_sdk::SignalQuality)> m_linkUpdateCallback;
+
+    std::atomic<std::shared_ptr<const drone_sdk::Geofence>> m_geofence; // Swapped while GPS updates read it
+    std::optional<drone_sdk::Location> m_lastLocation;                  // Start of the first leg of a new mission
 };
 
 #endif // STATE_MACHINE_MANAGER_HPP
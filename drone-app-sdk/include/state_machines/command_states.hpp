@@ -0,0 +1,32 @@
+#ifndef COMMAND_STATES_HPP
+#define COMMAND_STATES_HPP
+
+// Events and states of the command region of DroneStateMachine.
+namespace commandstatemachine
+{
+
+    // Events represent triggers for state transitions in the state machine
+    struct TaskAssigned
+    {
+    }; ///< Event triggered when a new task is assigned.
+    struct TaskCompleted
+    {
+    }; ///< Event triggered when a task is completed.
+    struct TaskAborted
+    {
+    }; ///< Event triggered when a task is aborted because of emergency.
+
+    // States define the possible states of the command state machine
+    struct Idle
+    {
+    }; ///< State representing no active task (idle).
+    struct Busy
+    {
+    }; ///< State representing an ongoing task.
+    struct MissionAbort
+    {
+    }; ///< State representing an aborted mission because safety reasons.
+
+} // namespace commandstatemachine
+
+#endif // COMMAND_STATES_HPP
@@ -0,0 +1,402 @@
+#ifndef DRONE_STATE_MACHINE_HPP
+#define DRONE_STATE_MACHINE_HPP
+
+#include <boost/sml.hpp>
+#include "signal.hpp"
+#include "icd.hpp"
+#include "flight_recorder.hpp"
+#include "virtual_clock.hpp"
+#include "path.hpp"
+#include "state_machines/safety_states.hpp"
+#include "state_machines/flight_states.hpp"
+#include "state_machines/command_states.hpp"
+#include "state_machines/mission_route.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <span>
+
+namespace dronestatemachine
+{
+    namespace cmd = commandstatemachine;
+    namespace flight = flightstatemachine;
+    namespace safety = safetystatemachine;
+
+    /**
+     * @brief Event telling the flight region which mission was accepted.
+     */
+    struct MissionStarted
+    {
+        drone_sdk::CurrentMission mission; /**< Type of the accepted mission. */
+    };
+
+    // Bits of DroneStatus::fired, one per region
+    constexpr std::uint8_t kCommandRegion = 1u << 0;
+    constexpr std::uint8_t kFlightRegion = 1u << 1;
+    constexpr std::uint8_t kGpsRegion = 1u << 2;
+    constexpr std::uint8_t kLinkRegion = 1u << 3;
+    constexpr std::uint8_t kGeofenceRegion = 1u << 4;
+
+    /**
+     * @brief The state of every region, written by the transitions themselves so reading it
+     *        takes no is() probes. Injected into the machine as its only dependency.
+     */
+    struct DroneStatus
+    {
+        drone_sdk::CommandStatus command = drone_sdk::CommandStatus::IDLE;
+        drone_sdk::FlightState flight = drone_sdk::FlightState::LANDED;
+        drone_sdk::safetyState gps = drone_sdk::safetyState::GPS_HEALTH;
+        drone_sdk::safetyState link = drone_sdk::safetyState::CONNECTED;
+        drone_sdk::safetyState geofence = drone_sdk::safetyState::GEOFENCE_CLEAR;
+        std::uint8_t fired = 0; /**< Regions that took a transition on the current event. */
+    };
+
+    /**
+     * @brief The command, flight and safety machines as orthogonal regions of one machine.
+     *
+     * Every event is offered to all five regions in a single process_event(), so the reactions
+     * that used to travel between three machines through signals (a lost GPS aborting the
+     * mission, the aborted mission landing the drone) are transitions of the table.
+     *
+     * Regions are processed in the order their initial states are listed: command, flight,
+     * then the safety regions. The guards rely on it, the command region judges a safety event
+     * against the safety states from before it and the flight region sees the command state
+     * from after it.
+     */
+    struct Drone_SM
+    {
+        auto operator()()
+        {
+            using namespace boost::sml;
+            using drone_sdk::CommandStatus;
+            using drone_sdk::CurrentMission;
+            using drone_sdk::FlightState;
+            using drone_sdk::safetyState;
+            using drone_sdk::SignalQuality;
+
+            // Safety losses, only the first one of each kind aborts
+            const auto gpsLost = [](const safety::GpsSignal &signal, const DroneStatus &status)
+            { return signal.quality == SignalQuality::NO_SIGNAL && status.gps == safetyState::GPS_HEALTH; };
+            const auto linkLost = [](const safety::LinkSignal &signal, const DroneStatus &status)
+            { return signal.quality == SignalQuality::NO_SIGNAL && status.link == safetyState::CONNECTED; };
+            const auto breached = [](const safety::GeofenceCheck &check, const DroneStatus &status)
+            { return check.violated && status.geofence == safetyState::GEOFENCE_CLEAR; };
+            const auto cleared = [](const safety::GeofenceCheck &check)
+            { return !check.violated; };
+            // The command region aborted the mission on this event
+            const auto aborted = [](const DroneStatus &status)
+            { return (status.fired & kCommandRegion) != 0 && status.command == CommandStatus::MISSION_ABORT; };
+            const auto flies = [](const MissionStarted &started)
+            { return started.mission == CurrentMission::GOTO || started.mission == CurrentMission::PATH; };
+            const auto hovers = [](const MissionStarted &started)
+            { return started.mission == CurrentMission::HOVER; };
+            const auto returnsHome = [](const MissionStarted &started)
+            { return started.mission == CurrentMission::HOME; };
+
+            const auto command = [](CommandStatus state)
+            {
+                return [state](DroneStatus &status)
+                {
+                    status.command = state;
+                    status.fired |= kCommandRegion;
+                };
+            };
+            const auto flight = [](FlightState state)
+            {
+                return [state](DroneStatus &status)
+                {
+                    status.flight = state;
+                    status.fired |= kFlightRegion;
+                };
+            };
+            const auto gps = [](safetyState state)
+            {
+                return [state](DroneStatus &status)
+                {
+                    status.gps = state;
+                    status.fired |= kGpsRegion;
+                };
+            };
+            const auto link = [](safetyState state)
+            {
+                return [state](DroneStatus &status)
+                {
+                    status.link = state;
+                    status.fired |= kLinkRegion;
+                };
+            };
+            const auto geofence = [](safetyState state)
+            {
+                return [state](DroneStatus &status)
+                {
+                    status.geofence = state;
+                    status.fired |= kGeofenceRegion;
+                };
+            };
+
+            return make_transition_table(
+                // Command region, a new task replaces the running one but not an abort
+                *state<cmd::Idle> + event<cmd::TaskAssigned> / command(CommandStatus::BUSY) = state<cmd::Busy>,
+                state<cmd::Busy> + event<cmd::TaskAssigned> / command(CommandStatus::BUSY) = state<cmd::Busy>,
+                state<cmd::MissionAbort> + event<cmd::TaskAssigned> / command(CommandStatus::MISSION_ABORT) = state<cmd::MissionAbort>,
+                state<cmd::Busy> + event<cmd::TaskCompleted> / command(CommandStatus::IDLE) = state<cmd::Idle>,
+                state<cmd::MissionAbort> + event<cmd::TaskCompleted> / command(CommandStatus::IDLE) = state<cmd::Idle>,
+                state<cmd::Busy> + event<safety::GpsSignal>[gpsLost] / command(CommandStatus::MISSION_ABORT) = state<cmd::MissionAbort>,
+                state<cmd::Busy> + event<safety::LinkSignal>[linkLost] / command(CommandStatus::MISSION_ABORT) = state<cmd::MissionAbort>,
+                state<cmd::Busy> + event<safety::GeofenceCheck>[breached] / command(CommandStatus::MISSION_ABORT) = state<cmd::MissionAbort>,
+
+                // Flight region, following the tasks
+                *state<flight::Landed> + event<cmd::TaskAssigned> / flight(FlightState::TAKEOFF) = state<flight::Takeoff>,
+                state<flight::Takeoff> + event<cmd::TaskAssigned> / flight(FlightState::AIRBORNE) = state<flight::Airborne>,
+                state<flight::Hover> + event<cmd::TaskAssigned> / flight(FlightState::AIRBORNE) = state<flight::Airborne>,
+                state<flight::Airborne> + event<cmd::TaskAssigned> / flight(FlightState::AIRBORNE) = state<flight::Airborne>,
+                state<flight::Takeoff> + event<cmd::TaskCompleted> / flight(FlightState::HOVER) = state<flight::Hover>,
+                state<flight::Airborne> + event<cmd::TaskCompleted> / flight(FlightState::HOVER) = state<flight::Hover>,
+                state<flight::Takeoff> + event<MissionStarted>[flies] / flight(FlightState::AIRBORNE) = state<flight::Airborne>,
+                state<flight::Airborne> + event<MissionStarted>[flies] / flight(FlightState::AIRBORNE) = state<flight::Airborne>,
+                state<flight::Hover> + event<MissionStarted>[hovers] / flight(FlightState::HOVER) = state<flight::Hover>,
+                state<flight::Airborne> + event<MissionStarted>[returnsHome] / flight(FlightState::RETURN_HOME) = state<flight::ReturnHome>,
+                // and landing when a safety loss aborted the mission
+                state<flight::Takeoff> + event<safety::GpsSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Airborne> + event<safety::GpsSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Hover> + event<safety::GpsSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::ReturnHome> + event<safety::GpsSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Takeoff> + event<safety::LinkSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Airborne> + event<safety::LinkSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Hover> + event<safety::LinkSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::ReturnHome> + event<safety::LinkSignal>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Takeoff> + event<safety::GeofenceCheck>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Airborne> + event<safety::GeofenceCheck>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::Hover> + event<safety::GeofenceCheck>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+                state<flight::ReturnHome> + event<safety::GeofenceCheck>[aborted] / flight(FlightState::EMERGENCY_LAND) = state<flight::EmergencyLand>,
+
+                // Safety regions, GPS and link do not recover once lost
+                *state<safety::GpsHealthy> + event<safety::GpsSignal>[gpsLost] / gps(safetyState::GPS_NOT_HEALTHY) = state<safety::GpsNotHealthy>,
+                *state<safety::ConnectionConnected> + event<safety::LinkSignal>[linkLost] / link(safetyState::NOT_CONNECTED) = state<safety::ConnectionDisconnected>,
+                *state<safety::GeofenceClear> + event<safety::GeofenceCheck>[breached] / geofence(safetyState::GEOFENCE_VIOLATED) = state<safety::GeofenceBreached>,
+                state<safety::GeofenceBreached> + event<safety::GeofenceCheck>[cleared] / geofence(safetyState::GEOFENCE_CLEAR) = state<safety::GeofenceClear>);
+        }
+    };
+
+    /**
+     * @brief The state machines of one drone, run as the single Drone_SM.
+     *
+     * Takes the same inputs and offers the same notifications as the command, flight and
+     * safety state machines wired together, with the mission data (destination, path) kept
+     * next to the machine. Subscribers are notified once the event was processed by every
+     * region: flight first, then command, then the safety states. A state subscriber only hears
+     * about real changes, events that leave every state as it was are counted instead.
+     */
+    class DroneStateMachine
+    {
+    public:
+        using CommandStateSignal = drone_sdk::Signal<void(drone_sdk::CommandTransition)>;
+        using FlightStateSignal = drone_sdk::Signal<void(drone_sdk::FlightTransition)>;
+        using SafetyStateSignal = drone_sdk::Signal<void(drone_sdk::SafetyTransition)>;
+        using LocationSignal = drone_sdk::Signal<void(drone_sdk::Location)>;
+
+        DroneStateMachine();
+
+        DroneStateMachine(const DroneStateMachine &) = delete;
+        DroneStateMachine &operator=(const DroneStateMachine &) = delete;
+
+        // Sensor input
+        void handleGpsSignal(drone_sdk::SignalQuality quality);
+        void handleLinkSignal(drone_sdk::SignalQuality quality);
+        void handleGeofence(bool violated);
+        void handleGpsLocationUpdate(const drone_sdk::Location &location);
+
+        /**
+         * @brief Assigns a new task, see CommandStateMachine::handleTaskAssigned().
+         */
+        drone_sdk::FlightControllerStatus handleTaskAssigned(
+            drone_sdk::CurrentMission newMission,
+            const std::optional<drone_sdk::Location> &singleDestination = std::nullopt,
+            const std::optional<std::queue<drone_sdk::Location>> &pathDestinations = std::nullopt);
+
+        /**
+         * @brief Assigns a PATH mission, see CommandStateMachine::handlePathAssigned().
+         */
+        drone_sdk::FlightControllerStatus handlePathAssigned(drone_sdk::Path path);
+
+        // Edits of the running PATH mission, see CommandStateMachine::replaceRemaining()
+        drone_sdk::FlightControllerStatus appendWaypoints(std::span<const drone_sdk::Location> waypoints);
+        drone_sdk::FlightControllerStatus replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints);
+        drone_sdk::FlightControllerStatus truncatePath(std::size_t endIndex);
+
+        const drone_sdk::Path &getPath() const
+        {
+            return m_route.path();
+        }
+
+        void setHomebase(const drone_sdk::Location &newHome)
+        {
+            m_home = newHome;
+        }
+
+        drone_sdk::Location getHomebase() const
+        {
+            return m_home;
+        }
+
+        void setArrivalRadius(double radiusMeters)
+        {
+            m_route.setArrivalRadius(radiusMeters);
+        }
+
+        double getArrivalRadius() const
+        {
+            return m_route.arrivalRadius();
+        }
+
+        drone_sdk::CommandStatus getCommandState() const
+        {
+            return m_status.command;
+        }
+
+        drone_sdk::CurrentMission getCurrentMission() const
+        {
+            return m_currMission;
+        }
+
+        drone_sdk::FlightState getFlightState() const
+        {
+            return m_status.flight;
+        }
+
+        drone_sdk::safetyState getGpsState() const
+        {
+            return m_status.gps;
+        }
+
+        drone_sdk::safetyState getLinkState() const
+        {
+            return m_status.link;
+        }
+
+        drone_sdk::safetyState getGeofenceState() const
+        {
+            return m_status.geofence;
+        }
+
+        /**
+         * @brief Events that changed no state and so notified no state subscriber.
+         * @details Safe to read from any thread.
+         */
+        std::uint64_t suppressedEvents() const
+        {
+            return m_suppressed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Records every event and state transition to @p recorder from now on.
+         * @param recorder Outlives this machine, or nullptr to stop recording.
+         */
+        void setRecorder(drone_sdk::FlightRecorder *recorder)
+        {
+            m_recorder = recorder;
+        }
+
+        /**
+         * @brief Stamps the transitions with @p clock instead of steady_clock, for replays.
+         * @param clock Outlives this machine, or nullptr for steady_clock.
+         */
+        void setClock(const drone_sdk::VirtualClock *clock)
+        {
+            m_clock = clock;
+        }
+
+        drone_sdk::Connection subscribeToCommandState(const CommandStateSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToFlightState(const FlightStateSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToGpsState(const SafetyStateSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToLinkState(const SafetyStateSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToGeofenceState(const SafetyStateSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToPathWaypoint(const LocationSignal::slot_type &subscriber);
+        drone_sdk::Connection subscribeToCurrentDestination(const LocationSignal::slot_type &subscriber);
+
+    private:
+        /**
+         * @brief Runs @p event through every region.
+         * @return The states from before the event, to be passed to notify().
+         */
+        template <typename Event>
+        DroneStatus dispatch(const Event &event)
+        {
+            if (m_recorder)
+            {
+                record(event);
+            }
+            const DroneStatus before = m_status;
+            m_status.fired = 0;
+            m_SM.process_event(event);
+            m_status.fired = 0;
+            return before;
+        }
+
+        void record(const safety::GpsSignal &signal)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::GPS_SIGNAL, static_cast<std::uint8_t>(signal.quality));
+        }
+        void record(const safety::LinkSignal &signal)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::LINK_SIGNAL, static_cast<std::uint8_t>(signal.quality));
+        }
+        void record(const safety::GeofenceCheck &check)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::GEOFENCE_CHECK, check.violated);
+        }
+        void record(const cmd::TaskAssigned &)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::TASK_ASSIGNED, 0);
+        }
+        void record(const cmd::TaskCompleted &)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::TASK_COMPLETED, 0);
+        }
+        void record(const MissionStarted &started)
+        {
+            m_recorder->recordEvent(drone_sdk::RecordedEvent::MISSION_STARTED, static_cast<std::uint8_t>(started.mission));
+        }
+
+        // Notifies the subscribers of the states that differ from @p before
+        void notify(const DroneStatus &before);
+
+        // Runs a safety event, heading down where the drone is if it aborted the mission
+        template <typename Event>
+        void handleSafetyEvent(const Event &event)
+        {
+            const DroneStatus before = dispatch(event);
+            if (before.command != m_status.command)
+            {
+                m_route.setDestination({m_currLocation.latitude, m_currLocation.longitude, m_home.altitude});
+            }
+            notify(before);
+        }
+
+        void completeTask();
+        void advancePath(); // Reports the waypoints reached and flies the next leg
+
+        DroneStatus m_status;                  ///< Declared before m_SM, which refers to it.
+        boost::sml::sm<Drone_SM> m_SM{m_status};
+        drone_sdk::CurrentMission m_currMission = drone_sdk::CurrentMission::HOVER;
+        drone_sdk::Location m_currLocation;    ///< Current GPS location of the drone.
+        drone_sdk::Location m_home;            ///< Home base location.
+        cmd::MissionRoute m_route;             ///< Destination and waypoints of the mission.
+
+        CommandStateSignal m_commandSignal;
+        FlightStateSignal m_flightSignal;
+        SafetyStateSignal m_gpsSignal;
+        SafetyStateSignal m_linkSignal;
+        SafetyStateSignal m_geofenceSignal;
+        LocationSignal m_waypointSignal;
+        LocationSignal m_destinationSignal;
+        std::atomic<std::uint64_t> m_suppressed{0};
+        drone_sdk::FlightRecorder *m_recorder = nullptr;
+        const drone_sdk::VirtualClock *m_clock = nullptr;
+    };
+
+} // namespace dronestatemachine
+
+#endif // DRONE_STATE_MACHINE_HPP
@@ -0,0 +1,58 @@
+#ifndef FLIGHT_STATES_HPP
+#define FLIGHT_STATES_HPP
+
+// Events and states of the flight region of DroneStateMachine.
+namespace flightstatemachine
+{
+
+    /**
+     * @brief Events for the FlightStateMachine
+     * These events trigger transitions between states in the state machine.
+     */
+    struct TakeoffEvent
+    {
+    }; ///< Triggered to initiate takeoff.
+    struct AirborneEvent
+    {
+    }; ///< Triggered when the drone becomes airborne.
+    struct HoverEvent
+    {
+    }; ///< Triggered to transition to hover mode.
+    struct TaskCompleteEvent
+    {
+    }; ///< Triggered when the drone completes its task.
+    struct SafetyViolationEvent
+    {
+    }; ///< Triggered during a safety violation.
+    struct LandEvent
+    {
+    }; ///< Trrigerd when preformd landing after go home/ safty violation.
+    struct ReturnHomeEvent
+    {
+    };
+    /**
+     * @brief States for the FlightStateMachine
+     * These represent the possible states the drone can be in.
+     */
+    struct Landed
+    {
+    }; ///< The drone is on the ground.
+    struct Takeoff
+    {
+    }; ///< The drone is taking off.
+    struct Airborne
+    {
+    }; ///< The drone is flying normally.
+    struct Hover
+    {
+    }; ///< The drone is hovering in place.
+    struct EmergencyLand
+    {
+    }; ///< The drone is performing an emergency landing.
+    struct ReturnHome
+    {
+    }; ///< The drone is returning to its home location.
+
+} // namespace flightstatemachine
+
+#endif // FLIGHT_STATES_HPP
@@ -0,0 +1,126 @@
+#ifndef MISSION_ROUTE_HPP
+#define MISSION_ROUTE_HPP
+
+#include "icd.hpp"
+#include "path.hpp"
+#include "geo.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace commandstatemachine
+{
+    /**
+     * @brief Where the current mission is headed: the destination, the arrival check against
+     *        it and, on a PATH mission, the waypoints still ahead.
+     */
+    class MissionRoute
+    {
+    public:
+        /**
+         * @brief Sets the destination that arrival is detected against.
+         */
+        void setDestination(const drone_sdk::Location &destination)
+        {
+            m_destination = destination;
+            m_arrival.setTarget(destination);
+        }
+
+        const drone_sdk::Location &destination() const
+        {
+            return m_destination;
+        }
+
+        bool arrived(const drone_sdk::Location &location) const
+        {
+            return m_arrival.arrived(location);
+        }
+
+        void setArrivalRadius(double radiusMeters)
+        {
+            m_arrival.setRadius(radiusMeters);
+        }
+
+        double arrivalRadius() const
+        {
+            return m_arrival.radius();
+        }
+
+        /**
+         * @brief Makes the first waypoint of a non-empty path the destination and keeps the rest for later.
+         */
+        void startPath(drone_sdk::Path path)
+        {
+            m_path = std::move(path);
+            setDestination(m_path.front());
+            nextLeg();
+        }
+
+        /**
+         * @brief Makes the next waypoint of the path the destination.
+         * @return False once the path has no waypoints left.
+         */
+        bool advance()
+        {
+            if (m_path.empty())
+            {
+                return false;
+            }
+            setDestination(m_path.front());
+            nextLeg();
+            return true;
+        }
+
+        /**
+         * @brief The original waypoints reached with the destination, as indices into
+         *        path().waypoints(): just the destination, or on a simplified path also the
+         *        waypoints its leg skipped. Indices, since path edits move the waypoints.
+         */
+        std::size_t legBegin() const
+        {
+            return m_legBegin;
+        }
+
+        std::size_t legEnd() const
+        {
+            return m_legEnd;
+        }
+
+        /**
+         * @brief The path of the current or last PATH mission.
+         */
+        const drone_sdk::Path &path() const
+        {
+            return m_path;
+        }
+
+        // Whether replaceRemaining() may start at @p fromIndex, see drone_sdk::Path::replaceRemaining()
+        bool canReplace(std::size_t fromIndex) const
+        {
+            return fromIndex >= m_path.editableFrom() && fromIndex <= m_path.waypoints().size();
+        }
+
+        void replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+        {
+            m_path.replaceRemaining(fromIndex, waypoints);
+        }
+
+    private:
+        void nextLeg()
+        {
+            const std::span<const drone_sdk::Location> leg = m_path.pop();
+            m_legBegin = static_cast<std::size_t>(leg.data() - m_path.waypoints().data());
+            m_legEnd = m_legBegin + leg.size();
+        }
+
+        drone_sdk::Location m_destination;         ///< Current destination for the mission.
+        drone_sdk::geo::ArrivalDetector m_arrival; ///< Arrival check against m_destination.
+        drone_sdk::Path m_path;                    ///< Waypoints still ahead in a PATH mission.
+        std::size_t m_legBegin = 0;
+        std::size_t m_legEnd = 0;
+    };
+
+} // namespace commandstatemachine
+
+#endif // MISSION_ROUTE_HPP
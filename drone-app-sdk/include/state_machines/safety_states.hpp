@@ -0,0 +1,78 @@
+#ifndef SAFETY_STATES_HPP
+#define SAFETY_STATES_HPP
+
+#include "icd.hpp"
+
+// Events and states of the GPS, link and geofence regions of DroneStateMachine.
+namespace safetystatemachine
+{
+
+    /**
+     * @brief Event representing the current GPS signal quality.
+     */
+    struct GpsSignal
+    {
+        drone_sdk::SignalQuality quality; /**< Quality of the GPS signal. */
+    };
+
+    /**
+     * @brief Event representing the current link signal quality.
+     */
+    struct LinkSignal
+    {
+        drone_sdk::SignalQuality quality; /**< Quality of the link signal. */
+    };
+
+    /**
+     * @brief Event carrying the result of the geofence check of the latest GPS fix.
+     */
+    struct GeofenceCheck
+    {
+        bool violated; /**< The fix is above the ceiling or inside a no-fly zone. */
+    };
+
+    /**
+     * @brief State representing a healthy GPS signal.
+     */
+    struct GpsHealthy
+    {
+    };
+
+    /**
+     * @brief State representing a loss of GPS signal.
+     */
+    struct GpsNotHealthy
+    {
+    };
+
+    /**
+     * @brief State representing a connected communication link.
+     */
+    struct ConnectionConnected
+    {
+    };
+
+    /**
+     * @brief State representing a disconnected communication link.
+     */
+    struct ConnectionDisconnected
+    {
+    };
+
+    /**
+     * @brief State representing a drone outside all no-fly zones.
+     */
+    struct GeofenceClear
+    {
+    };
+
+    /**
+     * @brief State representing a drone inside a no-fly zone or above the ceiling.
+     */
+    struct GeofenceBreached
+    {
+    };
+
+} // namespace safetystatemachine
+
+#endif // SAFETY_STATES_HPP
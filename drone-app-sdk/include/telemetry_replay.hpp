@@ -0,0 +1,137 @@
+#ifndef TELEMETRY_REPLAY_HPP
+#define TELEMETRY_REPLAY_HPP
+
+#include "icd.hpp"
+#include "flight_recorder.hpp"
+#include "state_machine_manager.hpp"
+#include "virtual_clock.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace drone_sdk
+{
+    enum class TelemetrySource : std::uint8_t
+    {
+        GPS = 0,
+        LINK
+    };
+
+    // One recorded sample, as the hardware monitor delivered it
+    struct TelemetrySample
+    {
+        std::chrono::steady_clock::time_point timestamp;
+        TelemetrySource source = TelemetrySource::GPS;
+        SignalQuality quality = SignalQuality::NO_SIGNAL;
+        Location location; ///< GPS samples only.
+    };
+
+    struct ReplayOptions
+    {
+        enum class Mode
+        {
+            AS_FAST_AS_POSSIBLE = 0, ///< Samples back to back, only the virtual clock keeps the recorded timing.
+            SCALED                   ///< Samples paced on the wall clock, speed times faster than recorded.
+        };
+
+        Mode mode = Mode::AS_FAST_AS_POSSIBLE;
+        double speed = 1.0; ///< SCALED only, 2 replays twice as fast as recorded.
+    };
+
+    struct ReplayResult
+    {
+        static constexpr std::uint64_t kEmptyDigest = 0xcbf29ce484222325; ///< FNV-1a offset basis.
+
+        std::size_t samples = 0;     ///< Samples fed to the state machines.
+        std::size_t transitions = 0; ///< State transitions they caused.
+        /// FNV-1a of every transition (region, from, to, virtual time), equal for equal runs.
+        std::uint64_t digest = kEmptyDigest;
+        std::chrono::nanoseconds simulated{0}; ///< Virtual time from the first to the last sample.
+        std::chrono::nanoseconds elapsed{0};   ///< Wall time the replay took.
+    };
+
+    /**
+     * @brief Feeds a recorded telemetry log through a StateMachineManager of its own, on a
+     *        virtual clock.
+     *
+     * The transitions are stamped with the time of the sample causing them, so a replay gives
+     * the same transitions at the same times on every run, whatever the mode and the load of
+     * the machine. This lets a day of flight logs be replayed in seconds to compare the
+     * transitions of two versions of the state machines, through ReplayResult::digest or the
+     * manager's own subscriptions.
+     *
+     * Everything runs on the thread calling run(); the state callbacks run there as well.
+     */
+    class TelemetryReplay
+    {
+    public:
+        using Action = std::function<void(StateMachineManager &)>;
+
+        TelemetryReplay();
+
+        TelemetryReplay(const TelemetryReplay &) = delete;
+        TelemetryReplay &operator=(const TelemetryReplay &) = delete;
+
+        /**
+         * @brief The manager the samples are fed to, to set it up (home, geofence, subscriptions)
+         *        before run().
+         */
+        StateMachineManager &manager()
+        {
+            return m_manager;
+        }
+
+        const VirtualClock &clock() const
+        {
+            return m_clock;
+        }
+
+        /**
+         * @brief Runs @p action on the manager at virtual time @p when, before the samples of the
+         *        same time. Actions of the same time run in the order they were scheduled.
+         * @details Used for what the log does not hold, such as the missions given to the drone.
+         */
+        void schedule(std::chrono::steady_clock::time_point when, Action action);
+
+        /**
+         * @brief Replays @p samples, which must be in time order, and the scheduled actions.
+         * @details The virtual clock starts at the first sample or action. The scheduled actions
+         *          are consumed, the state of the manager is kept from one run to the next.
+         * @throws std::invalid_argument If the samples are out of order or the speed is not positive.
+         */
+        ReplayResult run(std::span<const TelemetrySample> samples, const ReplayOptions &options = {});
+
+        /**
+         * @brief The GPS and link samples of flight recorder records, in order.
+         */
+        static std::vector<TelemetrySample> fromRecords(std::span<const FlightRecord> records);
+
+        /**
+         * @brief The GPS and link samples of a flight recorder dump, see FlightRecorder::dump().
+         * @throws std::runtime_error If the file cannot be read.
+         */
+        static std::vector<TelemetrySample> load(const std::string &filename);
+
+    private:
+        struct ScheduledAction
+        {
+            std::chrono::steady_clock::time_point when;
+            Action action;
+        };
+
+        void recordTransition(StateRegion region, std::uint8_t from, std::uint8_t to,
+                              std::chrono::steady_clock::time_point timestamp);
+
+        VirtualClock m_clock;       ///< Declared before m_manager, which reads it.
+        StateMachineManager m_manager;
+        std::vector<ScheduledAction> m_actions;
+        ReplayResult *m_result = nullptr; ///< Result of the run in progress, fed by the subscriptions.
+    };
+}
+
+#endif // TELEMETRY_REPLAY_HPP
@@ -0,0 +1,45 @@
+#ifndef VIRTUAL_CLOCK_HPP
+#define VIRTUAL_CLOCK_HPP
+
+#include <chrono>
+
+namespace drone_sdk
+{
+    /**
+     * @brief A steady_clock that only moves when told to, so replays stamp their transitions
+     *        with the time of the recorded samples rather than the time they are replayed at.
+     * @details Not thread safe, it is advanced and read by the thread running the replay.
+     */
+    class VirtualClock
+    {
+    public:
+        using time_point = std::chrono::steady_clock::time_point;
+        using duration = std::chrono::steady_clock::duration;
+
+        explicit VirtualClock(time_point start = {}) : m_now(start) {}
+
+        time_point now() const
+        {
+            return m_now;
+        }
+
+        // Never goes back, an earlier @p time is ignored
+        void advanceTo(time_point time)
+        {
+            if (time > m_now)
+            {
+                m_now = time;
+            }
+        }
+
+        void advance(duration elapsed)
+        {
+            advanceTo(m_now + elapsed);
+        }
+
+    private:
+        time_point m_now;
+    };
+}
+
+#endif // VIRTUAL_CLOCK_HPP
@@ -0,0 +1,111 @@
+#ifndef WAYPOINT_FILE_HPP
+#define WAYPOINT_FILE_HPP
+
+#include "icd.hpp"
+#include "path.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace drone_sdk
+{
+    /**
+     * @brief Binary waypoint file layout (little endian).
+     *
+     * A 24 byte header followed by @c count records of three doubles (latitude, longitude,
+     * altitude), the same layout as drone_sdk::Location, so a mapped file is used as is.
+     */
+    struct WaypointFileHeader
+    {
+        static constexpr std::uint32_t kMagic = 0x54505744; ///< "DWPT" read as little endian.
+        static constexpr std::uint16_t kVersion = 1;
+
+        std::uint32_t magic = kMagic;
+        std::uint16_t version = kVersion;
+        std::uint16_t recordSize = sizeof(Location);
+        std::uint64_t reserved = 0;
+        std::uint64_t count = 0; ///< Number of waypoint records.
+    };
+
+    /**
+     * @brief Read-only memory mapping of a waypoint file.
+     * @details Pages are read on first access, so opening even a large file reads nothing up
+     *          front. The sequential access hint makes the kernel read ahead and lets it reclaim
+     *          passed pages first under memory pressure. They are clean file pages that need no
+     *          swap, but they stay resident until the kernel reclaims them.
+     */
+    class MappedWaypointFile
+    {
+    public:
+        /**
+         * @brief Maps a waypoint file.
+         * @throws std::runtime_error If the file cannot be mapped or is not a valid waypoint file.
+         */
+        static std::shared_ptr<MappedWaypointFile> open(const std::string &filename);
+
+        ~MappedWaypointFile();
+
+        MappedWaypointFile(const MappedWaypointFile &) = delete;
+        MappedWaypointFile &operator=(const MappedWaypointFile &) = delete;
+
+        std::span<const Location> waypoints() const
+        {
+            return m_waypoints;
+        }
+
+    private:
+        MappedWaypointFile(void *mapping, std::size_t length);
+
+        void *m_mapping;
+        std::size_t m_length;
+        std::span<const Location> m_waypoints;
+    };
+
+    /**
+     * @brief Loads a PATH mission straight from a waypoint file without copying the waypoints.
+     * @details The returned path keeps the mapping alive until the mission is done with it.
+     * @throws std::runtime_error If the file cannot be mapped or is not a valid waypoint file.
+     */
+    Path loadPathFile(const std::string &filename);
+
+    /**
+     * @brief Streams waypoints into a new waypoint file, for generators of large missions.
+     * @details The record count in the header is written by close(), which the destructor
+     *          calls as well.
+     */
+    class WaypointFileWriter
+    {
+    public:
+        /**
+         * @throws std::runtime_error If the file cannot be created.
+         */
+        explicit WaypointFileWriter(const std::string &filename);
+        ~WaypointFileWriter();
+
+        WaypointFileWriter(const WaypointFileWriter &) = delete;
+        WaypointFileWriter &operator=(const WaypointFileWriter &) = delete;
+
+        void append(const Location &waypoint);
+        void append(std::span<const Location> waypoints);
+
+        /**
+         * @throws std::runtime_error If the file cannot be finalized.
+         */
+        void close();
+
+        std::uint64_t count() const
+        {
+            return m_count;
+        }
+
+    private:
+        std::FILE *m_file;
+        std::uint64_t m_count = 0;
+    };
+}
+
+#endif // WAYPOINT_FILE_HPP
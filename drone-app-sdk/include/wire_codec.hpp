@@ -0,0 +1,316 @@
+#ifndef WIRE_CODEC_HPP
+#define WIRE_CODEC_HPP
+
+#include "icd.hpp"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Binary encoding of the ICD types.
+ *
+ * Every value travels in a fixed size frame:
+ *
+ *   | version (1) | type id (1) | payload (WireTraits<T>::kPayloadSize) | CRC-32 (4) |
+ *
+ * Integers and doubles are little endian regardless of the host, the CRC (IEEE 802.3, as
+ * used by zlib) covers everything before it. Frame sizes, offsets and the CRC table are all
+ * compile time constants; encode() and decode() work on caller provided buffers and never
+ * allocate.
+ *
+ * Type ids and payload layouts are the wire contract: changing either needs a new kVersion.
+ */
+namespace drone_sdk::wire
+{
+    constexpr std::uint8_t kVersion = 1;
+    constexpr std::size_t kHeaderSize = 2; ///< Version and type id.
+    constexpr std::size_t kCrcSize = 4;
+
+    enum class WireError
+    {
+        BUFFER_TOO_SMALL = 0,
+        UNSUPPORTED_VERSION,
+        WRONG_TYPE,
+        CRC_MISMATCH,
+        INVALID_VALUE
+    };
+
+    namespace detail
+    {
+        constexpr std::array<std::uint32_t, 256> makeCrcTable()
+        {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint32_t, 256> kCrcTable = makeCrcTable();
+
+        constexpr void putU32(std::uint8_t *out, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+
+        constexpr std::uint32_t getU32(const std::uint8_t *in)
+        {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        constexpr void putU64(std::uint8_t *out, std::uint64_t value)
+        {
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+
+        constexpr std::uint64_t getU64(const std::uint8_t *in)
+        {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+    }
+
+    constexpr std::uint32_t crc32(std::span<const std::uint8_t> bytes)
+    {
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (const std::uint8_t byte : bytes)
+        {
+            crc = detail::kCrcTable[(crc ^ byte) & 0xFFu] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    static_assert(crc32(std::array<std::uint8_t, 9>{'1', '2', '3', '4', '5', '6', '7', '8', '9'}) == 0xCBF43926u,
+                  "CRC-32 check value");
+
+    /**
+     * @brief Payload layout of a type, specialized for every ICD type below.
+     *
+     * A specialization provides kTypeId, kPayloadSize, write(value, out) and
+     * read(in, value), which returns false for bytes that are no valid value.
+     */
+    template <typename T>
+    struct WireTraits;
+
+    template <typename E, std::uint8_t TypeId, E Last>
+    struct EnumWireTraits
+    {
+        static_assert(static_cast<unsigned>(Last) <= 0xFFu, "Enum values must fit in one byte");
+
+        static constexpr std::uint8_t kTypeId = TypeId;
+        static constexpr std::size_t kPayloadSize = 1;
+
+        static constexpr void write(E value, std::uint8_t *out)
+        {
+            out[0] = static_cast<std::uint8_t>(value);
+        }
+
+        static constexpr bool read(const std::uint8_t *in, E &value)
+        {
+            if (in[0] > static_cast<std::uint8_t>(Last))
+            {
+                return false;
+            }
+            value = static_cast<E>(in[0]);
+            return true;
+        }
+    };
+
+    template <>
+    struct WireTraits<Location>
+    {
+        static constexpr std::uint8_t kTypeId = 1;
+        static constexpr std::size_t kPayloadSize = 3 * sizeof(double);
+
+        static void write(const Location &value, std::uint8_t *out)
+        {
+            detail::putU64(out, std::bit_cast<std::uint64_t>(value.latitude));
+            detail::putU64(out + 8, std::bit_cast<std::uint64_t>(value.longitude));
+            detail::putU64(out + 16, std::bit_cast<std::uint64_t>(value.altitude));
+        }
+
+        static bool read(const std::uint8_t *in, Location &value)
+        {
+            value.latitude = std::bit_cast<double>(detail::getU64(in));
+            value.longitude = std::bit_cast<double>(detail::getU64(in + 8));
+            value.altitude = std::bit_cast<double>(detail::getU64(in + 16));
+            return true;
+        }
+    };
+
+    template <>
+    struct WireTraits<SignalQuality> : EnumWireTraits<SignalQuality, 2, SignalQuality::EXCELLENT> {};
+
+    template <>
+    struct WireTraits<FlightState> : EnumWireTraits<FlightState, 3, FlightState::RETURN_HOME> {};
+
+    template <>
+    struct WireTraits<CommandStatus> : EnumWireTraits<CommandStatus, 4, CommandStatus::MISSION_ABORT> {};
+
+    template <>
+    struct WireTraits<FlightControllerStatus>
+        : EnumWireTraits<FlightControllerStatus, 5, FlightControllerStatus::UNKNOWN_ERROR> {};
+
+    template <>
+    struct WireTraits<CurrentMission> : EnumWireTraits<CurrentMission, 6, CurrentMission::EMERGENCY> {};
+
+    template <>
+    struct WireTraits<safetyState> : EnumWireTraits<safetyState, 7, safetyState::GEOFENCE_VIOLATED> {};
+
+    /**
+     * @brief The snapshot field by field, the timestamp as steady clock nanoseconds.
+     * @details Steady clock time only compares with timestamps taken on the same host.
+     */
+    template <>
+    struct WireTraits<TelemetrySnapshot>
+    {
+        static constexpr std::uint8_t kTypeId = 8;
+        static constexpr std::size_t kPayloadSize = 2 * WireTraits<Location>::kPayloadSize + 4 + 2 * sizeof(std::uint64_t);
+
+        static void write(const TelemetrySnapshot &value, std::uint8_t *out)
+        {
+            WireTraits<Location>::write(value.location, out);
+            WireTraits<SignalQuality>::write(value.gpsQuality, out + 24);
+            WireTraits<SignalQuality>::write(value.linkQuality, out + 25);
+            WireTraits<FlightState>::write(value.flightState, out + 26);
+            WireTraits<CommandStatus>::write(value.commandStatus, out + 27);
+            WireTraits<Location>::write(value.destination, out + 28);
+            const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(value.timestamp.time_since_epoch());
+            detail::putU64(out + 52, static_cast<std::uint64_t>(nanoseconds.count()));
+            detail::putU64(out + 60, value.version);
+        }
+
+        static bool read(const std::uint8_t *in, TelemetrySnapshot &value)
+        {
+            const auto nanoseconds = std::chrono::nanoseconds(static_cast<std::int64_t>(detail::getU64(in + 52)));
+            value.timestamp = std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(nanoseconds));
+            value.version = detail::getU64(in + 60);
+            return WireTraits<Location>::read(in, value.location) &&
+                   WireTraits<SignalQuality>::read(in + 24, value.gpsQuality) &&
+                   WireTraits<SignalQuality>::read(in + 25, value.linkQuality) &&
+                   WireTraits<FlightState>::read(in + 26, value.flightState) &&
+                   WireTraits<CommandStatus>::read(in + 27, value.commandStatus) &&
+                   WireTraits<Location>::read(in + 28, value.destination);
+        }
+    };
+
+    // Every type with a wire encoding
+    using WireTypes = std::tuple<Location, SignalQuality, FlightState, CommandStatus, FlightControllerStatus,
+                                 CurrentMission, safetyState, TelemetrySnapshot>;
+
+    template <typename T>
+    inline constexpr std::size_t kFrameSize = kHeaderSize + WireTraits<T>::kPayloadSize + kCrcSize;
+
+    /**
+     * @brief Frame size for a type id, 0 for an unknown id. Lets a reader split a byte stream.
+     */
+    constexpr std::size_t frameSize(std::uint8_t typeId)
+    {
+        return [typeId]<typename... Ts>(std::type_identity<std::tuple<Ts...>>)
+        {
+            std::size_t size = 0;
+            ((size = WireTraits<Ts>::kTypeId == typeId ? kFrameSize<Ts> : size), ...);
+            return size;
+        }(std::type_identity<WireTypes>{});
+    }
+
+    static_assert(frameSize(WireTraits<Location>::kTypeId) == 30 && frameSize(0) == 0);
+
+    /**
+     * @brief Writes one frame holding @p value to the start of @p out.
+     * @return Number of bytes written, kFrameSize<T>.
+     */
+    template <typename T>
+    std::expected<std::size_t, WireError> encode(const T &value, std::span<std::uint8_t> out)
+    {
+        constexpr std::size_t size = kFrameSize<T>;
+        if (out.size() < size)
+        {
+            return std::unexpected(WireError::BUFFER_TOO_SMALL);
+        }
+        out[0] = kVersion;
+        out[1] = WireTraits<T>::kTypeId;
+        WireTraits<T>::write(value, out.data() + kHeaderSize);
+        detail::putU32(out.data() + size - kCrcSize, crc32(out.first(size - kCrcSize)));
+        return size;
+    }
+
+    /**
+     * @brief Type id of the frame at the start of @p in, without validating the rest.
+     */
+    inline std::expected<std::uint8_t, WireError> peekType(std::span<const std::uint8_t> in)
+    {
+        if (in.size() < kHeaderSize)
+        {
+            return std::unexpected(WireError::BUFFER_TOO_SMALL);
+        }
+        if (in[0] != kVersion)
+        {
+            return std::unexpected(WireError::UNSUPPORTED_VERSION);
+        }
+        return in[1];
+    }
+
+    /**
+     * @brief Reads the frame at the start of @p in, which must hold a T.
+     */
+    template <typename T>
+    std::expected<T, WireError> decode(std::span<const std::uint8_t> in)
+    {
+        constexpr std::size_t size = kFrameSize<T>;
+        const auto type = peekType(in);
+        if (!type)
+        {
+            return std::unexpected(type.error());
+        }
+        if (*type != WireTraits<T>::kTypeId)
+        {
+            return std::unexpected(WireError::WRONG_TYPE);
+        }
+        if (in.size() < size)
+        {
+            return std::unexpected(WireError::BUFFER_TOO_SMALL);
+        }
+        if (crc32(in.first(size - kCrcSize)) != detail::getU32(in.data() + size - kCrcSize))
+        {
+            return std::unexpected(WireError::CRC_MISMATCH);
+        }
+        T value{};
+        if (!WireTraits<T>::read(in.data() + kHeaderSize, value))
+        {
+            return std::unexpected(WireError::INVALID_VALUE);
+        }
+        return value;
+    }
+}
+
+#endif // WIRE_CODEC_HPP
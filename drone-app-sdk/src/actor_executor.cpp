@@ -0,0 +1,51 @@
+#include "actor_executor.hpp"
+
+ActorExecutor::ActorExecutor()
+    : m_thread([this]()
+               { run(); })
+{
+}
+
+ActorExecutor::~ActorExecutor()
+{
+    m_stopping.store(true, std::memory_order_release);
+    m_posted.fetch_add(1, std::memory_order_release);
+    m_posted.notify_one();
+    m_thread.join();
+}
+
+void ActorExecutor::post(std::move_only_function<void()> message)
+{
+    m_inbox.push(std::move(message));
+    // Only wakes the actor when it sleeps, a no-op otherwise
+    m_posted.fetch_add(1, std::memory_order_release);
+    m_posted.notify_one();
+}
+
+void ActorExecutor::run()
+{
+    std::move_only_function<void()> message;
+    while (true)
+    {
+        // Read before draining: a message pushed after the drain changes it, so wait() returns
+        const std::uint64_t posted = m_posted.load(std::memory_order_acquire);
+        while (m_inbox.tryPop(message))
+        {
+            message();
+            message = nullptr;
+            m_processed.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (m_stopping.load(std::memory_order_acquire))
+        {
+            // Messages posted before the destructor ran are in the inbox by now
+            while (m_inbox.tryPop(message))
+            {
+                message();
+                message = nullptr;
+                m_processed.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        m_posted.wait(posted, std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,132 @@
+#include "callback_executor.hpp"
+
+#include <algorithm>
+
+CallbackExecutor::Mailbox::Mailbox(DeliveryOptions options)
+{
+    m_stats.name = std::move(options.name);
+    m_stats.policy = options.policy;
+    m_stats.capacity = std::max<std::size_t>(options.capacity, 1);
+}
+
+void CallbackExecutor::Mailbox::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_spaceCondition.notify_all();
+}
+
+SubscriberQueueStats CallbackExecutor::Mailbox::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool CallbackExecutor::Mailbox::queued(std::size_t depth)
+{
+    m_stats.depth = depth;
+    m_stats.highWaterMark = std::max(m_stats.highWaterMark, depth);
+    if (m_scheduled)
+    {
+        return false;
+    }
+    m_scheduled = true;
+    return true;
+}
+
+bool CallbackExecutor::Mailbox::taken(std::size_t depth)
+{
+    m_stats.depth = depth;
+    ++m_stats.delivered;
+    if (depth == 0)
+    {
+        m_scheduled = false;
+        return false;
+    }
+    return true;
+}
+
+CallbackExecutor::CallbackExecutor(std::size_t threadCount)
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(threadCount, 1); ++i)
+    {
+        m_workers.emplace_back([this]()
+                               { workerLoop(); });
+    }
+}
+
+CallbackExecutor::~CallbackExecutor()
+{
+    std::vector<std::shared_ptr<Mailbox>> mailboxes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        mailboxes = m_mailboxes;
+    }
+    m_readyCondition.notify_all();
+    for (auto &mailbox : mailboxes)
+    {
+        mailbox->close(); // Release publishers waiting under BLOCK
+    }
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+std::vector<SubscriberQueueStats> CallbackExecutor::queueStats() const
+{
+    std::vector<std::shared_ptr<Mailbox>> mailboxes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        mailboxes = m_mailboxes;
+    }
+
+    std::vector<SubscriberQueueStats> stats;
+    stats.reserve(mailboxes.size());
+    for (const auto &mailbox : mailboxes)
+    {
+        stats.push_back(mailbox->stats());
+    }
+    return stats;
+}
+
+void CallbackExecutor::schedule(std::shared_ptr<Mailbox> mailbox)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.push_back(std::move(mailbox));
+    }
+    m_readyCondition.notify_one();
+}
+
+void CallbackExecutor::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_readyCondition.wait(lock, [this]()
+                              { return m_stopping || !m_ready.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+
+        std::shared_ptr<Mailbox> mailbox = std::move(m_ready.front());
+        m_ready.pop_front();
+        lock.unlock();
+
+        // One event per turn, then requeue behind the other subscribers
+        const bool more = mailbox->deliverNext();
+
+        lock.lock();
+        if (more)
+        {
+            m_ready.push_back(std::move(mailbox));
+            m_readyCondition.notify_one();
+        }
+    }
+}
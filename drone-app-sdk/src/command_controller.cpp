@@ -10,45 +10,114 @@ void CommandController::start(drone_sdk::Location home)
 
 drone_sdk::FlightControllerStatus CommandController::hover()
 {
-    // Command the flight controller to hover at the current location
-    return m_flightControllerHandler.goTo(m_currentLocation);
+    return hoverAsync().get();
 }
 
 drone_sdk::FlightControllerStatus CommandController::abortMission()
 {
-    // Abort mission by notifying the state machine and flight controller
-    return m_flightControllerHandler.goHome();
+    return abortMissionAsync().get();
 }
 
 drone_sdk::FlightControllerStatus CommandController::goTo(const drone_sdk::Location &newLocation)
+{
+    return goToAsync(newLocation).get();
+}
+
+std::future<drone_sdk::FlightControllerStatus> CommandController::goToAsync(const drone_sdk::Location &location)
+{
+    m_destinations.cancel(); // A new mission makes a waiting destination update obsolete
+    return dispatch([this, location](Done done)
+                    { flyTo(location, std::move(done)); });
+}
+
+void CommandController::goToAsync(const drone_sdk::Location &location, Completion done)
+{
+    m_destinations.cancel();
+    dispatch([this, location](Done flown)
+             { flyTo(location, std::move(flown)); },
+             std::move(done));
+}
+
+std::future<drone_sdk::FlightControllerStatus> CommandController::abortMissionAsync()
+{
+    // Abort mission by sending the drone home
+    m_destinations.cancel();
+    return dispatch([this](Done done)
+                    { m_flightControllerHandler.goHome(recorded(drone_sdk::RecordedCommand::GO_HOME, m_homebase, std::move(done))); });
+}
+
+void CommandController::abortMissionAsync(Completion done)
+{
+    m_destinations.cancel();
+    dispatch([this](Done sent)
+             { m_flightControllerHandler.goHome(recorded(drone_sdk::RecordedCommand::GO_HOME, m_homebase, std::move(sent))); },
+             std::move(done));
+}
+
+std::future<drone_sdk::FlightControllerStatus> CommandController::hoverAsync()
+{
+    // Hover where the drone is when the command is given, not when the worker gets to it
+    const drone_sdk::Location here = m_currentLocation.load();
+    m_destinations.cancel();
+    return dispatch([this, here](Done done)
+                    { m_flightControllerHandler.goTo(here, recorded(drone_sdk::RecordedCommand::GOTO, here, std::move(done))); });
+}
+
+void CommandController::hoverAsync(Completion done)
+{
+    const drone_sdk::Location here = m_currentLocation.load();
+    m_destinations.cancel();
+    dispatch([this, here](Done sent)
+             { m_flightControllerHandler.goTo(here, recorded(drone_sdk::RecordedCommand::GOTO, here, std::move(sent))); },
+             std::move(done));
+}
+
+void CommandController::flyTo(const drone_sdk::Location &newLocation, Done done)
 {
     if (m_onLand)
     {
-        drone_sdk::FlightControllerStatus flightStatus = takingOff(newLocation);
-        if (flightStatus != drone_sdk::FlightControllerStatus::SUCCESS)
-        {
-            return flightStatus;
-        }
+        takingOff(newLocation, [this, newLocation, done = std::move(done)](drone_sdk::FlightControllerStatus flightStatus) mutable
+                  {
+                      if (flightStatus != drone_sdk::FlightControllerStatus::SUCCESS)
+                      {
+                          done(flightStatus);
+                          return;
+                      }
+                      m_flightControllerHandler.goTo(newLocation, recorded(drone_sdk::RecordedCommand::GOTO, newLocation, std::move(done))); });
+        return;
     }
-    return m_flightControllerHandler.goTo(newLocation);
+    m_flightControllerHandler.goTo(newLocation, recorded(drone_sdk::RecordedCommand::GOTO, newLocation, std::move(done)));
 }
 
 drone_sdk::FlightControllerStatus CommandController::path(drone_sdk::Location firstPoint)
 {
     m_onPath = true;
-    return m_flightControllerHandler.goTo(firstPoint);
+    m_destinations.cancel();
+    return dispatch([this, firstPoint](Done done)
+                    { m_flightControllerHandler.goTo(firstPoint, recorded(drone_sdk::RecordedCommand::GOTO, firstPoint, std::move(done))); })
+        .get();
 }
 
 void CommandController::handleDestinationChange(drone_sdk::Location newDestination)
 {
-    m_flightControllerHandler.goTo(newDestination);
+    // Called from the state machines, which must not wait on the flight controller.
+    // Bursts collapse into the newest destination, sent at most at the command rate.
+    m_destinations.submit(newDestination);
 }
 
 void CommandController::handleCommandState(drone_sdk::CommandStatus commandState)
 {
     if (commandState == drone_sdk::CommandStatus::MISSION_ABORT)
     {
-        m_flightControllerHandler.land();
+        // Land where the drone is when the abort is given, as hoverAsync() does
+        const drone_sdk::Location here = m_currentLocation.load();
+        m_destinations.cancel();
+        m_worker.post([this, here]()
+                      {
+                          m_flightControllerHandler.land();
+                          // The handler reports no result for a landing, recorded once sent
+                          recordCommand(drone_sdk::RecordedCommand::LAND, drone_sdk::FlightControllerStatus::SUCCESS, here);
+                      });
     }
     // Finished doing the path
     if (commandState == drone_sdk::CommandStatus::IDLE && m_onPath)
@@ -57,18 +126,48 @@ void CommandController::handleCommandState(drone_sdk::CommandStatus commandState
     }
 }
 
-drone_sdk::FlightControllerStatus CommandController::takingOff(drone_sdk::Location location)
+void CommandController::takingOff(drone_sdk::Location location, Done done)
 {
-    drone_sdk::FlightControllerStatus flightStatus = m_flightControllerHandler.arm();
+    m_flightControllerHandler.arm(
+        [this, location, done = std::move(done)](drone_sdk::FlightControllerStatus flightStatus) mutable
+        {
+            recordCommand(drone_sdk::RecordedCommand::ARM, flightStatus);
+            if (flightStatus == drone_sdk::FlightControllerStatus::SUCCESS)
+            {
+                m_flightControllerHandler.takeOff(location, recorded(drone_sdk::RecordedCommand::TAKEOFF, location, std::move(done)));
+            }
+            else
+            {
+                done(flightStatus);
+            }
+        });
+}
 
-    if (flightStatus == drone_sdk::FlightControllerStatus::SUCCESS)
-    {
-        return m_flightControllerHandler.takeOff(location);
-    }
-    else
+void CommandController::dispatch(Command command, Done done)
+{
+    m_worker.post([command = std::move(command), done = std::move(done)]() mutable
+                  { command(std::move(done)); });
+}
+
+std::future<drone_sdk::FlightControllerStatus> CommandController::dispatch(Command command)
+{
+    std::promise<drone_sdk::FlightControllerStatus> promise;
+    std::future<drone_sdk::FlightControllerStatus> result = promise.get_future();
+    dispatch(std::move(command), [promise = std::move(promise)](drone_sdk::FlightControllerStatus status) mutable
+             { promise.set_value(status); });
+    return result;
+}
+
+CommandController::Done CommandController::recorded(drone_sdk::RecordedCommand command, const drone_sdk::Location &target, Done done)
+{
+    return [this, command, target, done = std::move(done)](drone_sdk::FlightControllerStatus status) mutable
     {
-        return flightStatus;
-    }
+        recordCommand(command, status, target);
+        if (done)
+        {
+            done(status);
+        }
+    };
 }
 
 void CommandController::onCommandStateChanged(drone_sdk::CommandStatus commandState)
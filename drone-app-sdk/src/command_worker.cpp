@@ -0,0 +1,79 @@
+#include "command_worker.hpp"
+
+CommandWorker::CommandWorker()
+    : m_thread([this]()
+               { run(); })
+{
+}
+
+CommandWorker::~CommandWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void CommandWorker::post(std::move_only_function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void CommandWorker::postAt(Clock::time_point due, std::move_only_function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_delayed.emplace(due, std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+std::size_t CommandWorker::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_delayed.size();
+}
+
+void CommandWorker::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        // Due delayed jobs join the queue behind what was posted before they became due
+        const Clock::time_point now = Clock::now();
+        while (!m_delayed.empty() && (m_stopping || m_delayed.begin()->first <= now))
+        {
+            m_jobs.push_back(std::move(m_delayed.begin()->second));
+            m_delayed.erase(m_delayed.begin());
+        }
+
+        if (m_jobs.empty())
+        {
+            if (m_stopping)
+            {
+                return; // Everything queued has run
+            }
+            if (m_delayed.empty())
+            {
+                m_condition.wait(lock);
+            }
+            else
+            {
+                m_condition.wait_until(lock, m_delayed.begin()->first);
+            }
+            continue;
+        }
+
+        std::move_only_function<void()> job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
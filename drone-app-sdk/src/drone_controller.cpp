@@ -1,5 +1,8 @@
 #include "drone_controller.hpp"
+#include "path_simplifier.hpp"
 #include <iostream>
+#include <memory>
+#include <utility>
 
 DroneController::DroneController()
     : m_stateMachineManager(), m_commandController()
@@ -9,20 +12,298 @@ DroneController::DroneController()
 #else
     m_hwMonitor.start();
 #endif
+    connectComponents();
+}
+
+DroneController::DroneController(FleetRuntime &fleet)
+    : m_stateMachineManager(), m_commandController()
+{
+#ifdef DEBUG_MODE
+    (void)fleet; // The mock monitor is driven by runMockData()
+#else
+    m_hwMonitor.start(fleet);
+#endif
+    connectComponents();
+}
+
+void DroneController::connectComponents()
+{
+    // From here on the state machines are only touched by messages to m_actor
+    m_actor.call([this]()
+                 { wireStateMachines(); })
+        .get();
 
-    m_stateMachineManager.start();
-    m_commandController.start(m_stateMachineManager.getHome());
     m_hwMonitor.subscribeToGpsUpdates([this](const drone_sdk::Location &location, const drone_sdk::SignalQuality &signalQuality)
                                       {
-                                          m_stateMachineManager.handleGpsUpdate(location, signalQuality);
+                                          updateTelemetry([&location, signalQuality](drone_sdk::TelemetrySnapshot &snapshot)
+                                                          {
+                                                              snapshot.location = location;
+                                                              snapshot.gpsQuality = signalQuality; });
+                                          if (const auto history = m_history.load(std::memory_order_acquire))
+                                          {
+                                              history->append(std::chrono::steady_clock::now(), location);
+                                          }
+                                          m_actor.post([this, location, signalQuality]()
+                                                       { m_stateMachineManager.handleGpsUpdate(location, signalQuality); });
                                           m_commandController.updateCurrentLocation(location); });
     m_hwMonitor.subscribeToLinkUpdates([this](const drone_sdk::SignalQuality &signalQuality)
-                                       { m_stateMachineManager.handleLinkUpdate(signalQuality); });
+                                       {
+                                           updateTelemetry([signalQuality](drone_sdk::TelemetrySnapshot &snapshot)
+                                                           { snapshot.linkQuality = signalQuality; });
+                                           m_actor.post([this, signalQuality]()
+                                                        { m_stateMachineManager.handleLinkUpdate(signalQuality); }); });
+}
+
+void DroneController::wireStateMachines()
+{
+    m_stateMachineManager.start();
+    m_commandController.start(m_stateMachineManager.getHome());
+    m_stateMachineManager.setFlightRecorder(&m_recorder);
+    m_commandController.setFlightRecorder(&m_recorder);
+
+    // Keep the telemetry snapshot current, each source only touches its own fields.
+    // Entering an abort or emergency landing dumps the flight recorder, on its own thread
+    m_stateMachineManager.subscribeToFlightState([this](drone_sdk::FlightTransition transition)
+                                                 {
+                                                     updateTelemetry([state = transition.to](drone_sdk::TelemetrySnapshot &snapshot)
+                                                                     { snapshot.flightState = state; });
+                                                     if (transition.to == drone_sdk::FlightState::EMERGENCY_LAND)
+                                                     {
+                                                         m_recorder.requestDump();
+                                                     } });
+    m_stateMachineManager.subscribeToCommandState([this](drone_sdk::CommandTransition transition)
+                                                  {
+                                                      updateTelemetry([status = transition.to](drone_sdk::TelemetrySnapshot &snapshot)
+                                                                      { snapshot.commandStatus = status; });
+                                                      if (transition.to == drone_sdk::CommandStatus::MISSION_ABORT)
+                                                      {
+                                                          m_recorder.requestDump();
+                                                      }
+                                                      handleCommandState(transition); });
+    m_stateMachineManager.subscribeToCurrentDestination([this](drone_sdk::Location destination)
+                                                        {
+                                                            updateTelemetry([destination](drone_sdk::TelemetrySnapshot &snapshot)
+                                                                            { snapshot.destination = destination; });
+                                                            m_commandController.handleDestinationChange(destination); });
+}
+
+void DroneController::setArrivalRadius(double radiusMeters)
+{
+    m_actor.post([this, radiusMeters]()
+                 { m_stateMachineManager.setArrivalRadius(radiusMeters); });
+}
+
+void DroneController::setPathSimplification(double toleranceMeters)
+{
+    m_pathTolerance = toleranceMeters;
+}
+
+void DroneController::setGeofence(std::shared_ptr<const drone_sdk::Geofence> geofence)
+{
+    m_stateMachineManager.setGeofence(std::move(geofence));
+}
+
+void DroneController::setLocationHistory(std::shared_ptr<drone_sdk::LocationHistory> history)
+{
+    m_history.store(std::move(history), std::memory_order_release);
+}
+
+void DroneController::setRetryPolicy(const drone_sdk::RetryPolicy &policy)
+{
+    m_commandController.setRetryPolicy(policy);
+}
+
+drone_sdk::RetryMetrics DroneController::retryMetrics() const
+{
+    return m_commandController.retryMetrics();
+}
+
+void DroneController::setCommandRate(double rateHz)
+{
+    m_commandController.setCommandRate(rateHz);
+}
+
+CoalescerStats DroneController::destinationCommandStats() const
+{
+    return m_commandController.destinationStats();
+}
+
+std::uint64_t DroneController::suppressedStateEvents() const
+{
+    return m_stateMachineManager.suppressedStateEvents();
+}
+
+void DroneController::setFlightRecorderDirectory(const std::string &directory)
+{
+    m_recorder.setDumpDirectory(directory);
+}
+
+void DroneController::dumpFlightRecorder(const std::string &filename) const
+{
+    m_recorder.dump(filename);
+}
+
+drone_sdk::FlightControllerStatus DroneController::enqueueMission(drone_sdk::Mission mission)
+{
+    const drone_sdk::FlightControllerStatus status = prepareMission(mission);
+    if (status != drone_sdk::FlightControllerStatus::SUCCESS)
+    {
+        return status;
+    }
+    m_missions.pushBack(std::move(mission));
+    startIfIdle();
+    return drone_sdk::FlightControllerStatus::SUCCESS;
+}
+
+drone_sdk::FlightControllerStatus DroneController::insertMissionFront(drone_sdk::Mission mission)
+{
+    const drone_sdk::FlightControllerStatus status = prepareMission(mission);
+    if (status != drone_sdk::FlightControllerStatus::SUCCESS)
+    {
+        return status;
+    }
+    m_missions.pushFront(std::move(mission));
+    startIfIdle();
+    return drone_sdk::FlightControllerStatus::SUCCESS;
+}
+
+// Waits so that the mission has started when enqueueMission() returns
+void DroneController::startIfIdle()
+{
+    m_actor.call([this]()
+                 {
+                     if (m_stateMachineManager.getCommandState() == drone_sdk::CommandStatus::IDLE)
+                     {
+                         startNextMission();
+                     } })
+        .get();
+}
+
+drone_sdk::FlightControllerStatus DroneController::appendWaypoints(std::span<const drone_sdk::Location> waypoints)
+{
+    return m_actor.call([this, waypoints]()
+                        { return m_stateMachineManager.appendWaypoints(waypoints); })
+        .get();
+}
+
+drone_sdk::FlightControllerStatus DroneController::replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+{
+    return m_actor.call([this, fromIndex, waypoints]()
+                        { return m_stateMachineManager.replaceRemaining(fromIndex, waypoints); })
+        .get();
+}
+
+drone_sdk::FlightControllerStatus DroneController::truncatePath(std::size_t endIndex)
+{
+    return m_actor.call([this, endIndex]()
+                        { return m_stateMachineManager.truncatePath(endIndex); })
+        .get();
+}
+
+void DroneController::clearMissions()
+{
+    m_missions.clear();
+}
+
+std::size_t DroneController::queuedMissions() const
+{
+    return m_missions.size();
+}
+
+// Does the work of a hand-off up front, so starting a queued mission is just sending it
+drone_sdk::FlightControllerStatus DroneController::prepareMission(drone_sdk::Mission &mission)
+{
+    switch (mission.type)
+    {
+    case drone_sdk::CurrentMission::GOTO:
+        // The leg leading to it is only known once the previous mission is done
+        return m_stateMachineManager.checkGeofence({&mission.destination, 1}, std::nullopt);
+    case drone_sdk::CurrentMission::PATH:
+        if (mission.path.empty())
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+        mission.path = drone_sdk::simplifyPath(std::move(mission.path), m_pathTolerance);
+        return m_stateMachineManager.checkGeofence(mission.path, std::nullopt);
+    default:
+        return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+    }
+}
+
+drone_sdk::FlightControllerStatus DroneController::startMission(drone_sdk::Mission mission)
+{
+    drone_sdk::Location first = mission.destination;
+    drone_sdk::FlightControllerStatus status = drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+    if (mission.type == drone_sdk::CurrentMission::PATH)
+    {
+        if (mission.path.empty())
+        {
+            return status;
+        }
+        first = mission.path.front();
+        status = m_stateMachineManager.newPathTask(std::move(mission.path));
+    }
+    else
+    {
+        status = m_stateMachineManager.newTask(drone_sdk::CurrentMission::GOTO, first, std::nullopt);
+    }
+
+    // Usually called from a state machine callback, which must not wait on the flight controller
+    if (status == drone_sdk::FlightControllerStatus::SUCCESS)
+    {
+        m_commandController.goToAsync(first, [](drone_sdk::FlightControllerStatus commandStatus)
+                                      {
+                                          if (commandStatus != drone_sdk::FlightControllerStatus::SUCCESS)
+                                          {
+                                              std::cerr << "Error: queued mission command failed" << std::endl;
+                                          } });
+    }
+    return status;
+}
+
+void DroneController::handleCommandState(const drone_sdk::CommandTransition &transition)
+{
+    if (transition.from != drone_sdk::CommandStatus::BUSY || transition.to != drone_sdk::CommandStatus::IDLE)
+    {
+        return;
+    }
+    // Hover, home and aborted missions hold the queue until the operator adds to it again
+    const drone_sdk::CurrentMission completed = m_stateMachineManager.getCurrentMission();
+    if (completed == drone_sdk::CurrentMission::GOTO || completed == drone_sdk::CurrentMission::PATH)
+    {
+        // Not from within the emission: the subscribers after this one would hear of the next
+        // mission before this completion, and be left on IDLE while the drone flies
+        m_actor.post([this]()
+                     {
+                         if (m_stateMachineManager.getCommandState() == drone_sdk::CommandStatus::IDLE)
+                         {
+                             startNextMission();
+                         } });
+    }
+}
+
+void DroneController::startNextMission()
+{
+    while (auto next = m_missions.pop())
+    {
+        startMission(std::move(*next));
+        // Once the state machine took the mission it is flying, even if a command failed
+        if (m_stateMachineManager.getCommandState() == drone_sdk::CommandStatus::BUSY)
+        {
+            return;
+        }
+        std::cerr << "Error: queued mission rejected, starting the next one" << std::endl;
+    }
+}
+
+drone_sdk::TelemetrySnapshot DroneController::snapshot() const
+{
+    return m_telemetry.load();
 }
 
 DroneController::~DroneController()
 {
-    m_hwMonitor.stop(); // Clean up resources
+    m_hwMonitor.stop(); // Clean up resources, m_actor then runs the updates already sent
 }
 
 drone_sdk::FlightControllerStatus DroneController::goTo(const drone_sdk::Location &location)
@@ -31,11 +312,13 @@ drone_sdk::FlightControllerStatus DroneController::goTo(const drone_sdk::Locatio
     try
     {
         // Attempt to assign a new task in the state machine manager
-        machineStat = m_stateMachineManager.newTask(
-            drone_sdk::CurrentMission::GOTO,
-            location,    // Single destination passed as an optional parameter
-            std::nullopt // pathDestinations is not used, so pass std::nullopt
-        );
+        machineStat = m_actor.call([this, &location]()
+                                   { return m_stateMachineManager.newTask(
+                                         drone_sdk::CurrentMission::GOTO,
+                                         location,    // Single destination passed as an optional parameter
+                                         std::nullopt // pathDestinations is not used, so pass std::nullopt
+                                     ); })
+                          .get();
 
         if (machineStat != drone_sdk::FlightControllerStatus::SUCCESS)
         {
@@ -65,17 +348,100 @@ drone_sdk::FlightControllerStatus DroneController::goTo(const drone_sdk::Locatio
     }
 }
 
+std::future<drone_sdk::FlightControllerStatus> DroneController::goToAsync(const drone_sdk::Location &location)
+{
+    auto promise = std::make_shared<std::promise<drone_sdk::FlightControllerStatus>>();
+    auto result = promise->get_future();
+    goToAsync(location, [promise](drone_sdk::FlightControllerStatus status)
+              { promise->set_value(status); });
+    return result;
+}
+
+void DroneController::goToAsync(const drone_sdk::Location &location, CommandController::Completion done)
+{
+    m_actor.post([this, location, done = std::move(done)]() mutable
+                 {
+                     const drone_sdk::FlightControllerStatus status =
+                         m_stateMachineManager.newTask(drone_sdk::CurrentMission::GOTO, location, std::nullopt);
+                     if (status != drone_sdk::FlightControllerStatus::SUCCESS)
+                     {
+                         done(status);
+                         return;
+                     }
+                     m_commandController.goToAsync(location, std::move(done)); });
+}
+
+std::future<drone_sdk::FlightControllerStatus> DroneController::abortMissionAsync()
+{
+    auto promise = std::make_shared<std::promise<drone_sdk::FlightControllerStatus>>();
+    auto result = promise->get_future();
+    abortMissionAsync([promise](drone_sdk::FlightControllerStatus status)
+                      { promise->set_value(status); });
+    return result;
+}
+
+void DroneController::abortMissionAsync(CommandController::Completion done)
+{
+    m_actor.post([this, done = std::move(done)]() mutable
+                 {
+                     const drone_sdk::FlightControllerStatus status =
+                         m_stateMachineManager.newTask(drone_sdk::CurrentMission::EMERGENCY, drone_sdk::Location{}, std::nullopt);
+                     if (status != drone_sdk::FlightControllerStatus::SUCCESS)
+                     {
+                         done(status);
+                         return;
+                     }
+                     m_commandController.abortMissionAsync(std::move(done)); });
+}
+
+std::future<drone_sdk::FlightControllerStatus> DroneController::hoverAsync()
+{
+    auto promise = std::make_shared<std::promise<drone_sdk::FlightControllerStatus>>();
+    auto result = promise->get_future();
+    hoverAsync([promise](drone_sdk::FlightControllerStatus status)
+               { promise->set_value(status); });
+    return result;
+}
+
+void DroneController::hoverAsync(CommandController::Completion done)
+{
+    m_actor.post([this, done = std::move(done)]() mutable
+                 {
+                     const drone_sdk::FlightControllerStatus status =
+                         m_stateMachineManager.newTask(drone_sdk::CurrentMission::HOVER, drone_sdk::Location{}, std::nullopt);
+                     if (status != drone_sdk::FlightControllerStatus::SUCCESS)
+                     {
+                         done(status);
+                         return;
+                     }
+                     m_commandController.hoverAsync(std::move(done)); });
+}
+
 drone_sdk::FlightControllerStatus DroneController::path(std::queue<drone_sdk::Location> path)
+{
+    return this->path(drone_sdk::Path::fromQueue(std::move(path)));
+}
+
+drone_sdk::FlightControllerStatus DroneController::path(drone_sdk::Path path)
+{
+    return startPath(drone_sdk::simplifyPath(std::move(path), m_pathTolerance));
+}
+
+drone_sdk::FlightControllerStatus DroneController::startPath(drone_sdk::Path path)
 {
 
     drone_sdk::FlightControllerStatus machineStat = drone_sdk::FlightControllerStatus::UNKNOWN_ERROR;
+    if (path.empty())
+    {
+        return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+    }
+    const drone_sdk::Location firstPoint = path.front(); // The path itself moves to the state machine
     try
     {
         // Attempt to assign a new task in the state machine manager
-        machineStat = m_stateMachineManager.newTask(
-            drone_sdk::CurrentMission::PATH,
-            std::nullopt,
-            path);
+        machineStat = m_actor.call([this, &path]()
+                                   { return m_stateMachineManager.newPathTask(std::move(path)); })
+                          .get();
 
         if (machineStat != drone_sdk::FlightControllerStatus::SUCCESS)
         {
@@ -84,7 +450,7 @@ drone_sdk::FlightControllerStatus DroneController::path(std::queue<drone_sdk::Lo
         }
 
         // If the state machine task was successful, proceed with the command controller
-        machineStat = m_commandController.goTo(path.front());
+        machineStat = m_commandController.goTo(firstPoint);
 
         if (machineStat != drone_sdk::FlightControllerStatus::SUCCESS)
         {
@@ -110,11 +476,13 @@ drone_sdk::FlightControllerStatus DroneController::abortMission()
     try
     {
         // Attempt to assign an abort mission task in the state machine manager
-        machineStat = m_stateMachineManager.newTask(
-            drone_sdk::CurrentMission::EMERGENCY,
-            drone_sdk::Location{}, // Empty location for abort mission
-            std::nullopt           // pathDestinations is not used, so pass std::nullopt
-        );
+        machineStat = m_actor.call([this]()
+                                   { return m_stateMachineManager.newTask(
+                                         drone_sdk::CurrentMission::EMERGENCY,
+                                         drone_sdk::Location{}, // Empty location for abort mission
+                                         std::nullopt           // pathDestinations is not used, so pass std::nullopt
+                                     ); })
+                          .get();
 
         if (machineStat != drone_sdk::FlightControllerStatus::SUCCESS)
         {
@@ -150,11 +518,13 @@ drone_sdk::FlightControllerStatus DroneController::hover()
     try
     {
         // Attempt to assign a hover task in the state machine manager
-        machineStat = m_stateMachineManager.newTask(
-            drone_sdk::CurrentMission::HOVER,
-            drone_sdk::Location{}, // Empty location for hover
-            std::nullopt           // pathDestinations is not used, so pass std::nullopt
-        );
+        machineStat = m_actor.call([this]()
+                                   { return m_stateMachineManager.newTask(
+                                         drone_sdk::CurrentMission::HOVER,
+                                         drone_sdk::Location{}, // Empty location for hover
+                                         std::nullopt           // pathDestinations is not used, so pass std::nullopt
+                                     ); })
+                          .get();
 
         if (machineStat != drone_sdk::FlightControllerStatus::SUCCESS)
         {
@@ -184,13 +554,23 @@ drone_sdk::FlightControllerStatus DroneController::hover()
     }
 }
 
-void DroneController::subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback)
+void DroneController::subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
+{
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToGpsSignalState(std::move(callback)); })
+        .get();
+}
+void DroneController::subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
 {
-    m_stateMachineManager.subscribeToGpsSignalState(callback);
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToLinkSignalState(std::move(callback)); })
+        .get();
 }
-void DroneController::subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback)
+void DroneController::subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback)
 {
-    m_stateMachineManager.subscribeToLinkSignalState(callback);
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToGeofenceState(std::move(callback)); })
+        .get();
 }
 
 void DroneController::subscribeToGpsLocation(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback)
@@ -198,18 +578,24 @@ void DroneController::subscribeToGpsLocation(std::function<void(const drone_sdk:
     m_hwMonitor.subscribeToGpsUpdates(callback);
 }
 
-void DroneController::subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback)
+void DroneController::subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback)
 {
-    m_stateMachineManager.subscribeToFlightState(callback);
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToFlightState(std::move(callback)); })
+        .get();
 }
 
-void DroneController::subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback)
+void DroneController::subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback)
 {
-    m_stateMachineManager.subscribeToCommandState(callback);
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToCommandState(std::move(callback)); })
+        .get();
 }
 void DroneController::subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback)
 {
-    m_stateMachineManager.subscribeToWaypoint(callback);
+    m_actor.call([this, &callback]()
+                 { m_stateMachineManager.subscribeToWaypoint(std::move(callback)); })
+        .get();
 }
 
 #ifdef DEBUG_MODE
@@ -218,8 +604,7 @@ void DroneController::subscribeToWaypoint(std::function<void(drone_sdk::Location
 void DroneController::loadMockGpsData(const std::queue<drone_sdk::Location> &locations,
                                       const std::queue<drone_sdk::SignalQuality> &qualities)
 {
-    m_hwMonitor.loadMockGpsData(locations);
-    m_hwMonitor.loadMockLinkData(qualities);
+    m_hwMonitor.loadMockGpsData(locations, qualities);
 }
 
 void DroneController::loadMockLinkData(const std::queue<drone_sdk::SignalQuality> &qualities)
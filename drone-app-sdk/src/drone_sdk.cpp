@@ -1,10 +1,29 @@
 #include "drone_sdk.hpp"
 
 DroneSDK::DroneSDK()
-    : m_DroneController(std::make_unique<DroneController>()) // Initialize DroneController
+    : m_callbacks(std::make_unique<CallbackDelivery>()),
+      m_DroneController(std::make_unique<DroneController>()) // Initialize DroneController
 {
 }
 
+DroneSDK::DroneSDK(FleetRuntime &fleet)
+    : m_callbacks(std::make_unique<CallbackDelivery>()),
+      m_DroneController(std::make_unique<DroneController>(fleet))
+{
+}
+
+DroneSDK &DroneSDK::operator=(DroneSDK &&other) noexcept
+{
+    if (this != &other)
+    {
+        // The old controller's threads may still be delivering through the old executor
+        m_DroneController.reset();
+        m_DroneController = std::move(other.m_DroneController);
+        m_callbacks = std::move(other.m_callbacks);
+    }
+    return *this;
+}
+
 drone_sdk::FlightControllerStatus DroneSDK::goTo(const drone_sdk::Location &location)
 {
     return m_DroneController->goTo(location);
@@ -20,32 +39,162 @@ drone_sdk::FlightControllerStatus DroneSDK::hover()
     return m_DroneController->hover();
 }
 
+std::future<drone_sdk::FlightControllerStatus> DroneSDK::goToAsync(const drone_sdk::Location &location)
+{
+    return m_DroneController->goToAsync(location);
+}
+
+void DroneSDK::goToAsync(const drone_sdk::Location &location, std::function<void(drone_sdk::FlightControllerStatus)> done)
+{
+    m_DroneController->goToAsync(location, std::move(done));
+}
+
+std::future<drone_sdk::FlightControllerStatus> DroneSDK::abortMissionAsync()
+{
+    return m_DroneController->abortMissionAsync();
+}
+
+void DroneSDK::abortMissionAsync(std::function<void(drone_sdk::FlightControllerStatus)> done)
+{
+    m_DroneController->abortMissionAsync(std::move(done));
+}
+
+std::future<drone_sdk::FlightControllerStatus> DroneSDK::hoverAsync()
+{
+    return m_DroneController->hoverAsync();
+}
+
+void DroneSDK::hoverAsync(std::function<void(drone_sdk::FlightControllerStatus)> done)
+{
+    m_DroneController->hoverAsync(std::move(done));
+}
+
 drone_sdk::FlightControllerStatus DroneSDK::path(std::queue<drone_sdk::Location> locations)
 {
-    return m_DroneController->path(locations);
+    return m_DroneController->path(std::move(locations));
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::path(drone_sdk::Path path)
+{
+    return m_DroneController->path(std::move(path));
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::appendWaypoints(std::span<const drone_sdk::Location> waypoints)
+{
+    return m_DroneController->appendWaypoints(waypoints);
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+{
+    return m_DroneController->replaceRemaining(fromIndex, waypoints);
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::truncatePath(std::size_t endIndex)
+{
+    return m_DroneController->truncatePath(endIndex);
+}
+
+void DroneSDK::setArrivalRadius(double radiusMeters)
+{
+    m_DroneController->setArrivalRadius(radiusMeters);
+}
+
+void DroneSDK::setPathSimplification(double toleranceMeters)
+{
+    m_DroneController->setPathSimplification(toleranceMeters);
+}
+
+void DroneSDK::setGeofence(std::shared_ptr<const drone_sdk::Geofence> geofence)
+{
+    m_DroneController->setGeofence(std::move(geofence));
+}
+
+void DroneSDK::setLocationHistory(std::shared_ptr<drone_sdk::LocationHistory> history)
+{
+    m_DroneController->setLocationHistory(std::move(history));
+}
+
+void DroneSDK::setRetryPolicy(const drone_sdk::RetryPolicy &policy)
+{
+    m_DroneController->setRetryPolicy(policy);
+}
+
+drone_sdk::RetryMetrics DroneSDK::retryMetrics() const
+{
+    return m_DroneController->retryMetrics();
+}
+
+void DroneSDK::setCommandRate(double rateHz)
+{
+    m_DroneController->setCommandRate(rateHz);
 }
 
-void DroneSDK::subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback)
+CoalescerStats DroneSDK::destinationCommandStats() const
+{
+    return m_DroneController->destinationCommandStats();
+}
+
+std::uint64_t DroneSDK::suppressedStateEvents() const
+{
+    return m_DroneController->suppressedStateEvents();
+}
+
+void DroneSDK::setFlightRecorderDirectory(const std::string &directory)
+{
+    m_DroneController->setFlightRecorderDirectory(directory);
+}
+
+void DroneSDK::dumpFlightRecorder(const std::string &filename) const
+{
+    m_DroneController->dumpFlightRecorder(filename);
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::enqueueMission(drone_sdk::Mission mission)
+{
+    return m_DroneController->enqueueMission(std::move(mission));
+}
+
+drone_sdk::FlightControllerStatus DroneSDK::insertMissionFront(drone_sdk::Mission mission)
+{
+    return m_DroneController->insertMissionFront(std::move(mission));
+}
+
+void DroneSDK::clearMissions()
+{
+    m_DroneController->clearMissions();
+}
+
+std::size_t DroneSDK::queuedMissions() const
+{
+    return m_DroneController->queuedMissions();
+}
+
+void DroneSDK::subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
 {
     m_DroneController->subscribeToGpsSignalState(callback);
 }
 
-void DroneSDK::subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback)
+void DroneSDK::subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
 {
     m_DroneController->subscribeToLinkSignalState(callback);
 }
 
+void DroneSDK::subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback)
+{
+    m_DroneController->subscribeToGeofenceState(callback);
+}
+
 void DroneSDK::subscribeToGpsLocation(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback)
 {
     m_DroneController->subscribeToGpsLocation(callback);
 }
 
-void DroneSDK::subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback)
+void DroneSDK::subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback)
 {
     m_DroneController->subscribeToFlightState(callback);
 }
 
-void DroneSDK::subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback)
+void DroneSDK::subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback)
 {
     m_DroneController->subscribeToCommandState(callback);
 }
@@ -54,3 +203,91 @@ void DroneSDK::subscribeToWaypoint(std::function<void(drone_sdk::Location)> call
 {
     m_DroneController->subscribeToWaypoint(callback);
 }
+
+void DroneSDK::subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "gpsSignalState";
+    }
+    m_DroneController->subscribeToGpsSignalState(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "linkSignalState";
+    }
+    m_DroneController->subscribeToLinkSignalState(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToGeofenceState(std::function<void(drone_sdk::SafetyTransition)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "geofenceState";
+    }
+    m_DroneController->subscribeToGeofenceState(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToGpsLocation(std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "gpsLocation";
+    }
+    m_DroneController->subscribeToGpsLocation(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "flightState";
+    }
+    m_DroneController->subscribeToFlightState(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "commandState";
+    }
+    m_DroneController->subscribeToCommandState(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+void DroneSDK::subscribeToWaypoint(std::function<void(drone_sdk::Location)> callback, DeliveryOptions options)
+{
+    if (options.name.empty())
+    {
+        options.name = "waypoint";
+    }
+    m_DroneController->subscribeToWaypoint(callbackExecutor().wrap(std::move(callback), std::move(options)));
+}
+
+drone_sdk::TelemetrySnapshot DroneSDK::snapshot() const
+{
+    return m_DroneController->snapshot();
+}
+
+std::vector<SubscriberQueueStats> DroneSDK::callbackQueueStats() const
+{
+    std::lock_guard<std::mutex> lock(m_callbacks->mutex);
+    if (!m_callbacks->executor)
+    {
+        return {};
+    }
+    return m_callbacks->executor->queueStats();
+}
+
+CallbackExecutor &DroneSDK::callbackExecutor()
+{
+    std::lock_guard<std::mutex> lock(m_callbacks->mutex);
+    if (!m_callbacks->executor)
+    {
+        m_callbacks->executor = std::make_unique<CallbackExecutor>();
+    }
+    return *m_callbacks->executor;
+}
@@ -0,0 +1,256 @@
+#include "fleet_runtime.hpp"
+
+#include <algorithm>
+
+FleetRuntime::FleetRuntime(std::size_t workerCount, Clock::duration tickResolution, std::size_t wheelSlots)
+    : m_wheel(std::max<std::size_t>(wheelSlots, 1)),
+      m_epoch(Clock::now()),
+      m_resolution(std::max(tickResolution, Clock::duration(1)))
+{
+    m_timerThread = std::thread([this]()
+                                { timerLoop(); });
+    for (std::size_t i = 0; i < std::max<std::size_t>(workerCount, 1); ++i)
+    {
+        m_workers.emplace_back([this]()
+                               { workerLoop(); });
+    }
+}
+
+FleetRuntime::~FleetRuntime()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_timerCondition.notify_all();
+    m_workCondition.notify_all();
+
+    m_timerThread.join();
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+FleetRuntime::TaskId FleetRuntime::schedulePeriodic(DeadlineScheduler &scheduler, std::function<void()> task)
+{
+    auto entry = std::make_shared<Task>();
+    entry->scheduler = &scheduler;
+    entry->work = std::move(task);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entry->id = m_nextId++;
+    m_tasks.emplace(entry->id, entry);
+    arm(entry);
+    return entry->id;
+}
+
+FleetRuntime::TaskId FleetRuntime::registerTriggered(std::function<void()> task)
+{
+    auto entry = std::make_shared<Task>();
+    entry->work = std::move(task);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entry->id = m_nextId++;
+    m_tasks.emplace(entry->id, entry);
+    return entry->id;
+}
+
+void FleetRuntime::trigger(TaskId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_tasks.find(id);
+    if (it == m_tasks.end())
+    {
+        return;
+    }
+
+    const TaskPtr &task = it->second;
+    if (task->running)
+    {
+        task->rerun = true;
+    }
+    else if (!task->queued)
+    {
+        enqueue(task);
+    }
+}
+
+void FleetRuntime::cancel(TaskId id)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_tasks.find(id);
+    if (it == m_tasks.end())
+    {
+        return;
+    }
+
+    TaskPtr task = it->second;
+    m_tasks.erase(it);
+    task->cancelled = true;
+
+    if (task->armed)
+    {
+        auto &slot = m_wheel[task->dueTick % m_wheel.size()];
+        slot.erase(std::remove(slot.begin(), slot.end(), task), slot.end());
+        task->armed = false;
+        --m_armedCount;
+    }
+
+    // A task may cancel itself from its own body, only wait for runs on other threads
+    m_idleCondition.wait(lock, [&task]()
+                         { return !task->running || task->runner == std::this_thread::get_id(); });
+}
+
+std::size_t FleetRuntime::taskCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tasks.size();
+}
+
+void FleetRuntime::arm(const TaskPtr &task)
+{
+    if (m_armedCount == 0)
+    {
+        // The wheel was idle and nothing is waiting in it, jump straight to the present
+        m_currentTick = std::max(m_currentTick, elapsedTicks(Clock::now()));
+    }
+
+    const std::uint64_t dueTick = tickAt(task->scheduler->nextDeadline());
+    if (dueTick <= m_currentTick)
+    {
+        enqueue(task);
+        return;
+    }
+
+    task->dueTick = dueTick;
+    task->armed = true;
+    m_wheel[dueTick % m_wheel.size()].push_back(task);
+    if (m_armedCount++ == 0)
+    {
+        m_timerCondition.notify_one();
+    }
+}
+
+void FleetRuntime::enqueue(const TaskPtr &task)
+{
+    task->queued = true;
+    m_ready.push_back(task);
+    m_workCondition.notify_one();
+}
+
+std::uint64_t FleetRuntime::tickAt(Clock::time_point deadline) const
+{
+    if (deadline <= m_epoch)
+    {
+        return 0;
+    }
+    // Round up, a task must never fire before its deadline
+    return static_cast<std::uint64_t>((deadline - m_epoch + m_resolution - Clock::duration(1)) / m_resolution);
+}
+
+std::uint64_t FleetRuntime::elapsedTicks(Clock::time_point now) const
+{
+    if (now <= m_epoch)
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>((now - m_epoch) / m_resolution);
+}
+
+void FleetRuntime::timerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping)
+    {
+        if (m_armedCount == 0)
+        {
+            m_timerCondition.wait(lock, [this]()
+                                  { return m_stopping || m_armedCount > 0; });
+            continue;
+        }
+
+        const Clock::time_point nextTickTime = m_epoch + m_resolution * static_cast<Clock::rep>(m_currentTick + 1);
+        m_timerCondition.wait_until(lock, nextTickTime, [this, nextTickTime]()
+                                    { return m_stopping || Clock::now() >= nextTickTime; });
+
+        // Fire every slot the clock has passed, one slot per tick
+        const std::uint64_t nowTick = elapsedTicks(Clock::now());
+        while (m_currentTick < nowTick && m_armedCount > 0)
+        {
+            ++m_currentTick;
+            auto &slot = m_wheel[m_currentTick % m_wheel.size()];
+            for (auto it = slot.begin(); it != slot.end();)
+            {
+                if ((*it)->dueTick <= m_currentTick)
+                {
+                    (*it)->armed = false;
+                    --m_armedCount;
+                    enqueue(*it);
+                    it = slot.erase(it);
+                }
+                else
+                {
+                    ++it; // Due in a later round of the wheel
+                }
+            }
+        }
+        m_currentTick = std::max(m_currentTick, nowTick);
+    }
+}
+
+void FleetRuntime::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_workCondition.wait(lock, [this]()
+                             { return m_stopping || !m_ready.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+
+        TaskPtr task = std::move(m_ready.front());
+        m_ready.pop_front();
+        task->queued = false;
+        if (task->cancelled)
+        {
+            continue;
+        }
+
+        task->running = true;
+        task->runner = std::this_thread::get_id();
+        lock.unlock();
+        runTask(task);
+        lock.lock();
+        task->running = false;
+
+        if (!task->cancelled)
+        {
+            if (task->rerun)
+            {
+                task->rerun = false;
+                enqueue(task);
+            }
+            else if (task->scheduler != nullptr)
+            {
+                arm(task);
+            }
+        }
+        m_idleCondition.notify_all();
+    }
+}
+
+void FleetRuntime::runTask(const TaskPtr &task)
+{
+    if (task->scheduler == nullptr)
+    {
+        task->work();
+        return;
+    }
+
+    task->scheduler->beginTick(Clock::now());
+    task->work();
+    task->scheduler->endTick(Clock::now());
+}
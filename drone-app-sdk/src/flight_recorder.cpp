@@ -0,0 +1,185 @@
+#include "flight_recorder.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace drone_sdk
+{
+    namespace
+    {
+        std::atomic<std::uint64_t> nextRecorderId{0}; ///< Tells apart the dumps of the drones of a process.
+    }
+
+    FlightRecorder::FlightRecorder(std::size_t capacity)
+        : m_id(nextRecorderId.fetch_add(1, std::memory_order_relaxed)),
+          m_slots(capacity == 0 ? throw std::invalid_argument("Flight recorder capacity must not be 0")
+                                : std::bit_ceil(capacity)),
+          m_mask(m_slots.size() - 1),
+          m_directory(std::filesystem::temp_directory_path().string()),
+          m_dumper([this]()
+                   { runDumper(); })
+    {
+    }
+
+    FlightRecorder::~FlightRecorder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_dumper.join();
+    }
+
+    std::vector<FlightRecord> FlightRecorder::snapshot(std::uint64_t *dropped) const
+    {
+        const std::uint64_t end = m_next.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > m_slots.size() ? end - m_slots.size() : 0;
+
+        std::vector<FlightRecord> records;
+        records.reserve(static_cast<std::size_t>(end - begin));
+        std::array<std::uint64_t, kWords> words;
+        for (std::uint64_t index = begin; index < end; ++index)
+        {
+            const Slot &slot = m_slots[index & m_mask];
+            const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2)
+            {
+                continue; // Still being written, or already overwritten by a newer record
+            }
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+            FlightRecord &record = records.emplace_back();
+            std::memcpy(static_cast<void *>(&record), words.data(), sizeof(record));
+        }
+        if (dropped)
+        {
+            *dropped = end - records.size();
+        }
+        return records;
+    }
+
+    void FlightRecorder::dump(const std::string &filename) const
+    {
+        write(filename, "wb");
+    }
+
+    void FlightRecorder::write(const std::string &filename, const char *mode) const
+    {
+        FlightRecorderFileHeader header;
+        const std::vector<FlightRecord> records = snapshot(&header.dropped);
+        header.count = records.size();
+
+        std::FILE *file = std::fopen(filename.c_str(), mode);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot create flight recorder dump " + filename);
+        }
+        const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                             std::fwrite(records.data(), sizeof(FlightRecord), records.size(), file) == records.size();
+        const bool closed = std::fclose(file) == 0;
+        if (!written || !closed)
+        {
+            throw std::runtime_error("Cannot write flight recorder dump " + filename);
+        }
+    }
+
+    std::vector<FlightRecord> FlightRecorder::load(const std::string &filename)
+    {
+        std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::fopen(filename.c_str(), "rb"), &std::fclose);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open flight recorder dump " + filename);
+        }
+        FlightRecorderFileHeader header;
+        if (std::fread(&header, sizeof(header), 1, file.get()) != 1 ||
+            header.magic != FlightRecorderFileHeader::kMagic ||
+            header.version != FlightRecorderFileHeader::kVersion ||
+            header.recordSize != sizeof(FlightRecord))
+        {
+            throw std::runtime_error("Not a supported flight recorder dump: " + filename);
+        }
+        std::vector<FlightRecord> records(static_cast<std::size_t>(header.count));
+        if (std::fread(records.data(), sizeof(FlightRecord), records.size(), file.get()) != records.size())
+        {
+            throw std::runtime_error("Flight recorder dump truncated: " + filename);
+        }
+        return records;
+    }
+
+    void FlightRecorder::setDumpDirectory(const std::string &directory)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directory = directory;
+    }
+
+    void FlightRecorder::requestDump()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_dumpRequested = true;
+        }
+        m_wake.notify_one();
+    }
+
+    std::string FlightRecorder::lastDump() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lastDump;
+    }
+
+    void FlightRecorder::runDumper()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [this]()
+                        { return m_dumpRequested || m_stopping; });
+            if (!m_dumpRequested)
+            {
+                return;
+            }
+            m_dumpRequested = false;
+            // Wall clock first so the dumps sort by time. The recorder id and its dump count keep
+            // apart the dumps of one process; another process may pick the same name, which the
+            // exclusive create below turns into an error rather than an overwrite.
+            const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count();
+            const std::string filename =
+                (std::filesystem::path(m_directory) /
+                 ("flight_recorder_" + std::to_string(now) + "_" + std::to_string(m_id) + "_" +
+                  std::to_string(m_dumps.load(std::memory_order_relaxed)) + ".bin"))
+                    .string();
+
+            lock.unlock();
+            bool written = true;
+            try
+            {
+                write(filename, "wbx");
+            }
+            catch (const std::exception &e)
+            {
+                written = false;
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+            lock.lock();
+
+            if (written)
+            {
+                m_lastDump = filename;
+                m_dumps.fetch_add(1, std::memory_order_release);
+            }
+        }
+    }
+}
@@ -0,0 +1,338 @@
+#include "geofence.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace drone_sdk
+{
+    namespace
+    {
+        /**
+         * Visits the grid cells a segment passes through, in order (Amanatides and Woo), with
+         * coordinates in cells. Stops and returns true as soon as visit(row, column) does.
+         */
+        template <typename Visit>
+        bool walkCells(double x0, double y0, double x1, double y1, Visit &&visit)
+        {
+            auto column = static_cast<std::int64_t>(std::floor(x0));
+            auto row = static_cast<std::int64_t>(std::floor(y0));
+            const auto lastColumn = static_cast<std::int64_t>(std::floor(x1));
+            const auto lastRow = static_cast<std::int64_t>(std::floor(y1));
+
+            const double dx = x1 - x0;
+            const double dy = y1 - y0;
+            const std::int64_t stepX = dx > 0 ? 1 : -1;
+            const std::int64_t stepY = dy > 0 ? 1 : -1;
+            constexpr double kNever = std::numeric_limits<double>::infinity();
+            double nextX = dx != 0 ? (static_cast<double>(dx > 0 ? column + 1 : column) - x0) / dx : kNever;
+            double nextY = dy != 0 ? (static_cast<double>(dy > 0 ? row + 1 : row) - y0) / dy : kNever;
+            const double deltaX = dx != 0 ? 1.0 / std::fabs(dx) : kNever;
+            const double deltaY = dy != 0 ? 1.0 / std::fabs(dy) : kNever;
+
+            if (visit(row, column))
+            {
+                return true;
+            }
+            for (std::int64_t steps = std::llabs(lastColumn - column) + std::llabs(lastRow - row); steps > 0; --steps)
+            {
+                // Rounding must not step past the last cell on either axis
+                if (row == lastRow || (column != lastColumn && nextX < nextY))
+                {
+                    column += stepX;
+                    nextX += deltaX;
+                }
+                else
+                {
+                    row += stepY;
+                    nextY += deltaY;
+                }
+                if (visit(row, column))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Twice the signed area of the triangle a, b, c in the longitude/latitude plane
+        double orientation(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        }
+
+        bool segmentsIntersect(double ax, double ay, double bx, double by,
+                               double cx, double cy, double dx, double dy)
+        {
+            if (std::max(ax, bx) < std::min(cx, dx) || std::max(cx, dx) < std::min(ax, bx) ||
+                std::max(ay, by) < std::min(cy, dy) || std::max(cy, dy) < std::min(ay, by))
+            {
+                return false;
+            }
+            const double o1 = orientation(ax, ay, bx, by, cx, cy);
+            const double o2 = orientation(ax, ay, bx, by, dx, dy);
+            const double o3 = orientation(cx, cy, dx, dy, ax, ay);
+            const double o4 = orientation(cx, cy, dx, dy, bx, by);
+            return o1 * o2 <= 0.0 && o3 * o4 <= 0.0;
+        }
+    }
+
+    Geofence::Geofence(double cellDegrees) : m_cellDegrees(cellDegrees)
+    {
+        if (!(cellDegrees > 0.0))
+        {
+            throw std::invalid_argument("Geofence cell size must be positive");
+        }
+    }
+
+    std::size_t Geofence::addNoFlyZone(GeofenceZone zone)
+    {
+        if (zone.boundary.size() < 3)
+        {
+            throw std::invalid_argument("A no-fly zone needs at least three vertices");
+        }
+
+        Zone added;
+        added.floorMeters = zone.floorMeters;
+        added.ceilingMeters = zone.ceilingMeters;
+        added.latitudes.reserve(zone.boundary.size());
+        added.longitudes.reserve(zone.boundary.size());
+        for (const Location &vertex : zone.boundary)
+        {
+            added.latitudes.push_back(vertex.latitude);
+            added.longitudes.push_back(vertex.longitude);
+        }
+        const auto [minLat, maxLat] = std::minmax_element(added.latitudes.begin(), added.latitudes.end());
+        const auto [minLon, maxLon] = std::minmax_element(added.longitudes.begin(), added.longitudes.end());
+        added.minLatitude = *minLat;
+        added.maxLatitude = *maxLat;
+        added.minLongitude = *minLon;
+        added.maxLongitude = *maxLon;
+
+        // Cells crossed by the boundary need the polygon test, the others are all in or all out
+        const std::int64_t firstRow = cellIndex(added.minLatitude);
+        const std::int64_t firstColumn = cellIndex(added.minLongitude);
+        const auto rows = static_cast<std::size_t>(cellIndex(added.maxLatitude) - firstRow + 1);
+        const auto columns = static_cast<std::size_t>(cellIndex(added.maxLongitude) - firstColumn + 1);
+        std::vector<bool> boundary(rows * columns, false);
+        const std::size_t vertices = added.latitudes.size();
+        for (std::size_t i = 0, j = vertices - 1; i < vertices; j = i++)
+        {
+            walkCells(added.longitudes[j] / m_cellDegrees, added.latitudes[j] / m_cellDegrees,
+                      added.longitudes[i] / m_cellDegrees, added.latitudes[i] / m_cellDegrees,
+                      [&](std::int64_t row, std::int64_t column)
+                      {
+                          boundary[static_cast<std::size_t>(row - firstRow) * columns + static_cast<std::size_t>(column - firstColumn)] = true;
+                          return false;
+                      });
+        }
+
+        const auto index = static_cast<std::uint32_t>(m_zones.size());
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            for (std::size_t c = 0; c < columns; ++c)
+            {
+                const std::int64_t row = firstRow + static_cast<std::int64_t>(r);
+                const std::int64_t column = firstColumn + static_cast<std::int64_t>(c);
+                if (boundary[r * columns + c])
+                {
+                    m_cells[cellKey(row, column)].push_back({index, false});
+                }
+                else if (contains(added, (static_cast<double>(row) + 0.5) * m_cellDegrees,
+                                  (static_cast<double>(column) + 0.5) * m_cellDegrees))
+                {
+                    m_cells[cellKey(row, column)].push_back({index, true});
+                }
+            }
+        }
+
+        m_zones.push_back(std::move(added));
+        return index;
+    }
+
+    bool Geofence::violates(const Location &point) const
+    {
+        if (point.altitude > m_altitudeCeiling)
+        {
+            return true;
+        }
+        const auto *entries = cell(cellIndex(point.latitude), cellIndex(point.longitude));
+        if (entries == nullptr)
+        {
+            return false;
+        }
+        for (const CellEntry &entry : *entries)
+        {
+            const Zone &zone = m_zones[entry.zone];
+            if (inBand(zone, point.altitude, point.altitude) &&
+                (entry.inside || contains(zone, point.latitude, point.longitude)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Geofence::violates(const Location &from, const Location &to) const
+    {
+        return legViolates(from, to, false);
+    }
+
+    bool Geofence::legViolates(const Location &from, const Location &to, bool leaving) const
+    {
+        // Altitude is linear along the leg, so the ceiling is checked at the ends
+        if ((!leaving && violates(from)) || violates(to))
+        {
+            return true;
+        }
+        // Leaving, the leg may cross the zones its start is in but no other
+        const std::vector<std::uint32_t> left = leaving ? zonesAt(from) : std::vector<std::uint32_t>{};
+
+        const double low = std::min(from.altitude, to.altitude);
+        const double high = std::max(from.altitude, to.altitude);
+        std::vector<std::uint32_t> tested; // Zones span several cells, test each once
+        return walkCells(from.longitude / m_cellDegrees, from.latitude / m_cellDegrees,
+                         to.longitude / m_cellDegrees, to.latitude / m_cellDegrees,
+                         [&](std::int64_t row, std::int64_t column)
+                         {
+                             const auto *entries = cell(row, column);
+                             if (entries == nullptr)
+                             {
+                                 return false;
+                             }
+                             for (const CellEntry &entry : *entries)
+                             {
+                                 const Zone &zone = m_zones[entry.zone];
+                                 if (!inBand(zone, low, high) ||
+                                     std::find(left.begin(), left.end(), entry.zone) != left.end())
+                                 {
+                                     continue;
+                                 }
+                                 if (entry.inside)
+                                 {
+                                     return true;
+                                 }
+                                 if (std::find(tested.begin(), tested.end(), entry.zone) != tested.end())
+                                 {
+                                     continue;
+                                 }
+                                 tested.push_back(entry.zone);
+                                 // Climbing or descending through the band above or below the zone counts too
+                                 if (contains(zone, from.latitude, from.longitude) || crossesBoundary(zone, from, to))
+                                 {
+                                     return true;
+                                 }
+                             }
+                             return false;
+                         });
+    }
+
+    std::optional<std::size_t> Geofence::firstViolation(std::span<const Location> waypoints,
+                                                        const std::optional<Location> &start) const
+    {
+        if (waypoints.empty())
+        {
+            return std::nullopt;
+        }
+        if (start ? legViolates(*start, waypoints.front(), violates(*start)) : violates(waypoints.front()))
+        {
+            return 0;
+        }
+        for (std::size_t i = 1; i < waypoints.size(); ++i)
+        {
+            if (violates(waypoints[i - 1], waypoints[i]))
+            {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::vector<std::uint32_t> Geofence::zonesAt(const Location &point) const
+    {
+        std::vector<std::uint32_t> zones;
+        const auto *entries = cell(cellIndex(point.latitude), cellIndex(point.longitude));
+        if (entries == nullptr)
+        {
+            return zones;
+        }
+        for (const CellEntry &entry : *entries)
+        {
+            const Zone &zone = m_zones[entry.zone];
+            if (inBand(zone, point.altitude, point.altitude) &&
+                (entry.inside || contains(zone, point.latitude, point.longitude)))
+            {
+                zones.push_back(entry.zone);
+            }
+        }
+        return zones;
+    }
+
+    std::int64_t Geofence::cellIndex(double degrees) const
+    {
+        return static_cast<std::int64_t>(std::floor(degrees / m_cellDegrees));
+    }
+
+    std::uint64_t Geofence::cellKey(std::int64_t row, std::int64_t column)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) |
+               static_cast<std::uint32_t>(column);
+    }
+
+    const std::vector<Geofence::CellEntry> *Geofence::cell(std::int64_t row, std::int64_t column) const
+    {
+        const auto found = m_cells.find(cellKey(row, column));
+        return found == m_cells.end() ? nullptr : &found->second;
+    }
+
+    bool Geofence::inBand(const Zone &zone, double lowMeters, double highMeters)
+    {
+        return lowMeters <= zone.ceilingMeters && highMeters >= zone.floorMeters;
+    }
+
+    // Crossing number test in the longitude/latitude plane
+    bool Geofence::contains(const Zone &zone, double latitude, double longitude)
+    {
+        if (latitude < zone.minLatitude || latitude > zone.maxLatitude ||
+            longitude < zone.minLongitude || longitude > zone.maxLongitude)
+        {
+            return false;
+        }
+        const double *lat = zone.latitudes.data();
+        const double *lon = zone.longitudes.data();
+        const std::size_t vertices = zone.latitudes.size();
+        bool inside = false;
+        for (std::size_t i = 0, j = vertices - 1; i < vertices; j = i++)
+        {
+            if ((lat[i] > latitude) != (lat[j] > latitude) &&
+                longitude < (lon[j] - lon[i]) * (latitude - lat[i]) / (lat[j] - lat[i]) + lon[i])
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    bool Geofence::crossesBoundary(const Zone &zone, const Location &from, const Location &to)
+    {
+        if (std::max(from.latitude, to.latitude) < zone.minLatitude || std::min(from.latitude, to.latitude) > zone.maxLatitude ||
+            std::max(from.longitude, to.longitude) < zone.minLongitude || std::min(from.longitude, to.longitude) > zone.maxLongitude)
+        {
+            return false;
+        }
+        const double *lat = zone.latitudes.data();
+        const double *lon = zone.longitudes.data();
+        const std::size_t vertices = zone.latitudes.size();
+        for (std::size_t i = 0, j = vertices - 1; i < vertices; j = i++)
+        {
+            if (segmentsIntersect(from.longitude, from.latitude, to.longitude, to.latitude,
+                                  lon[j], lat[j], lon[i], lat[i]))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
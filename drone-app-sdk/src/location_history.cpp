@@ -0,0 +1,401 @@
+#include "location_history.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace drone_sdk
+{
+    namespace
+    {
+        class BitWriter
+        {
+        public:
+            BitWriter(std::vector<std::uint64_t> &words, std::size_t &bits) : m_words(words), m_bits(bits) {}
+
+            // Appends the low @p count bits of @p value, count up to 64
+            void write(std::uint64_t value, unsigned count)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+                if (count < 64)
+                {
+                    value &= (std::uint64_t{1} << count) - 1;
+                }
+                const auto offset = static_cast<unsigned>(m_bits % 64);
+                if (offset == 0)
+                {
+                    m_words.push_back(0);
+                }
+                const unsigned space = 64 - offset;
+                if (count <= space)
+                {
+                    m_words.back() |= value << (space - count);
+                }
+                else
+                {
+                    m_words.back() |= value >> (count - space);
+                    m_words.push_back(value << (64 - (count - space)));
+                }
+                m_bits += count;
+            }
+
+        private:
+            std::vector<std::uint64_t> &m_words;
+            std::size_t &m_bits;
+        };
+
+        class BitReader
+        {
+        public:
+            explicit BitReader(const std::vector<std::uint64_t> &words) : m_words(words.data()) {}
+
+            std::uint64_t read(unsigned count)
+            {
+                if (count == 0)
+                {
+                    return 0;
+                }
+                const std::size_t index = m_position / 64;
+                const auto offset = static_cast<unsigned>(m_position % 64);
+                const unsigned space = 64 - offset;
+                m_position += count;
+                if (count <= space)
+                {
+                    return (m_words[index] << offset) >> (64 - count);
+                }
+                const unsigned rest = count - space;
+                const std::uint64_t high = (m_words[index] << offset) >> offset;
+                return (high << rest) | (m_words[index + 1] >> (64 - rest));
+            }
+
+        private:
+            const std::uint64_t *m_words;
+            std::size_t m_position = 0;
+        };
+
+        // Differences wrap instead of overflowing, the decoder wraps back the same way
+        std::int64_t wrappingSub(std::int64_t a, std::int64_t b)
+        {
+            return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+        }
+
+        std::int64_t wrappingAdd(std::int64_t a, std::int64_t b)
+        {
+            return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+        }
+
+        // Delta of deltas with the variable length prefixes of the Gorilla paper, zigzag coded
+        void writeDelta(BitWriter &writer, std::int64_t delta)
+        {
+            const std::uint64_t zigzag = (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+            if (zigzag == 0)
+            {
+                writer.write(0b0, 1);
+            }
+            else if (zigzag < (std::uint64_t{1} << 7))
+            {
+                writer.write(0b10, 2);
+                writer.write(zigzag, 7);
+            }
+            else if (zigzag < (std::uint64_t{1} << 9))
+            {
+                writer.write(0b110, 3);
+                writer.write(zigzag, 9);
+            }
+            else if (zigzag < (std::uint64_t{1} << 12))
+            {
+                writer.write(0b1110, 4);
+                writer.write(zigzag, 12);
+            }
+            else if (zigzag < (std::uint64_t{1} << 32))
+            {
+                writer.write(0b11110, 5);
+                writer.write(zigzag, 32);
+            }
+            else
+            {
+                writer.write(0b11111, 5);
+                writer.write(zigzag, 64);
+            }
+        }
+
+        std::int64_t readDelta(BitReader &reader)
+        {
+            constexpr unsigned kWidths[] = {0, 7, 9, 12, 32, 64};
+            unsigned ones = 0;
+            while (ones < 5 && reader.read(1) == 1)
+            {
+                ++ones;
+            }
+            const std::uint64_t zigzag = reader.read(kWidths[ones]);
+            return static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+        }
+
+        /**
+         * XOR with the previous value: '0' if unchanged, '10' and the meaningful bits if they
+         * fit the previous window, '11', the window and the meaningful bits otherwise.
+         */
+        void writeXor(BitWriter &writer, std::uint64_t previous, std::uint64_t value, int &leading, int &trailing)
+        {
+            const std::uint64_t bits = previous ^ value;
+            if (bits == 0)
+            {
+                writer.write(0b0, 1);
+                return;
+            }
+            const int lead = std::min(std::countl_zero(bits), 31);
+            const int trail = std::countr_zero(bits);
+            if (leading >= 0 && lead >= leading && trail >= trailing)
+            {
+                writer.write(0b10, 2);
+                writer.write(bits >> trailing, static_cast<unsigned>(64 - leading - trailing));
+                return;
+            }
+            const int meaningful = 64 - lead - trail;
+            writer.write(0b11, 2);
+            writer.write(static_cast<std::uint64_t>(lead), 5);
+            writer.write(static_cast<std::uint64_t>(meaningful - 1), 6);
+            writer.write(bits >> trail, static_cast<unsigned>(meaningful));
+            leading = lead;
+            trailing = trail;
+        }
+
+        std::uint64_t readXor(BitReader &reader, std::uint64_t previous, int &leading, int &trailing)
+        {
+            if (reader.read(1) == 0)
+            {
+                return previous;
+            }
+            if (reader.read(1) == 1)
+            {
+                leading = static_cast<int>(reader.read(5));
+                const int meaningful = static_cast<int>(reader.read(6)) + 1;
+                trailing = 64 - leading - meaningful;
+            }
+            const std::uint64_t bits = reader.read(static_cast<unsigned>(64 - leading - trailing));
+            return previous ^ (bits << trailing);
+        }
+    }
+
+    LocationHistory::LocationHistory(const Options &options) : m_options(options)
+    {
+        if (!(options.degreesStep > 0.0) || !(options.metersStep > 0.0) ||
+            options.timeStep <= std::chrono::steady_clock::duration::zero() || options.samplesPerBlock == 0)
+        {
+            throw std::invalid_argument("LocationHistory steps must be positive");
+        }
+    }
+
+    void LocationHistory::append(std::chrono::steady_clock::time_point timestamp, const Location &location)
+    {
+        std::int64_t tick = timestamp.time_since_epoch() / m_options.timeStep;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_sealedSamples + m_open.count > 0)
+        {
+            tick = std::max(tick, m_state.tick);
+        }
+        encode(m_open, tick, location);
+        if (m_open.count == m_options.samplesPerBlock)
+        {
+            m_sealedSamples += m_open.count;
+            m_sealedBytes += (m_open.bits + 7) / 8;
+            m_blocks.push_back(std::make_shared<const Block>(std::exchange(m_open, Block{})));
+        }
+    }
+
+    std::size_t LocationHistory::size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_sealedSamples + m_open.count;
+    }
+
+    std::size_t LocationHistory::compressedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_sealedBytes + (m_open.bits + 7) / 8;
+    }
+
+    void LocationHistory::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks.clear();
+        m_open = Block{};
+        m_state = EncoderState{};
+        m_sealedSamples = 0;
+        m_sealedBytes = 0;
+    }
+
+    void LocationHistory::forEach(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                                  const std::function<void(const LocationSample &)> &visit) const
+    {
+        const std::int64_t firstTick = begin.time_since_epoch() / m_options.timeStep;
+        const std::int64_t lastTick = end.time_since_epoch() / m_options.timeStep;
+        if (firstTick > lastTick)
+        {
+            return;
+        }
+
+        // Collect the overlapping blocks under the lock, decode them without it
+        std::vector<std::shared_ptr<const Block>> blocks;
+        Block open;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = std::partition_point(m_blocks.begin(), m_blocks.end(), [firstTick](const auto &block)
+                                           { return block->lastTick < firstTick; });
+            for (; it != m_blocks.end() && (*it)->firstTick <= lastTick; ++it)
+            {
+                blocks.push_back(*it);
+            }
+            if (m_open.count > 0 && m_open.lastTick >= firstTick && m_open.firstTick <= lastTick)
+            {
+                open = m_open;
+            }
+        }
+
+        for (const auto &block : blocks)
+        {
+            decode(*block, firstTick, lastTick, visit);
+        }
+        decode(open, firstTick, lastTick, visit);
+    }
+
+    std::vector<LocationSample> LocationHistory::range(std::chrono::steady_clock::time_point begin,
+                                                       std::chrono::steady_clock::time_point end) const
+    {
+        std::vector<LocationSample> samples;
+        forEach(begin, end, [&samples](const LocationSample &sample)
+                { samples.push_back(sample); });
+        return samples;
+    }
+
+    std::vector<LocationSample> LocationHistory::downsample(std::chrono::steady_clock::time_point begin,
+                                                            std::chrono::steady_clock::time_point end,
+                                                            std::chrono::steady_clock::duration interval) const
+    {
+        if (interval <= std::chrono::steady_clock::duration::zero())
+        {
+            throw std::invalid_argument("Downsampling interval must be positive");
+        }
+        std::vector<LocationSample> samples;
+        auto nextInterval = begin;
+        forEach(begin, end, [&](const LocationSample &sample)
+                {
+                    if (sample.timestamp >= nextInterval)
+                    {
+                        samples.push_back(sample);
+                        nextInterval = begin + ((sample.timestamp - begin) / interval + 1) * interval;
+                    } });
+        return samples;
+    }
+
+    void LocationHistory::encode(Block &block, std::int64_t tick, const Location &location)
+    {
+        const double coordinates[3] = {location.latitude, location.longitude, location.altitude};
+        const double steps[3] = {m_options.degreesStep, m_options.degreesStep, m_options.metersStep};
+        std::int64_t values[3];
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            values[axis] = m_options.encoding == Encoding::QUANTIZED
+                               ? std::llround(coordinates[axis] / steps[axis])
+                               : std::bit_cast<std::int64_t>(coordinates[axis]);
+        }
+
+        BitWriter writer(block.words, block.bits);
+        if (block.count == 0)
+        {
+            // Every block starts from raw values so it decodes on its own
+            writer.write(static_cast<std::uint64_t>(tick), 64);
+            for (const std::int64_t value : values)
+            {
+                writer.write(static_cast<std::uint64_t>(value), 64);
+            }
+            m_state = EncoderState{};
+            block.firstTick = tick;
+        }
+        else
+        {
+            const std::int64_t tickDelta = wrappingSub(tick, m_state.tick);
+            writeDelta(writer, wrappingSub(tickDelta, m_state.tickDelta));
+            m_state.tickDelta = tickDelta;
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                if (m_options.encoding == Encoding::QUANTIZED)
+                {
+                    const std::int64_t delta = wrappingSub(values[axis], m_state.values[axis]);
+                    writeDelta(writer, wrappingSub(delta, m_state.valueDeltas[axis]));
+                    m_state.valueDeltas[axis] = delta;
+                }
+                else
+                {
+                    writeXor(writer, static_cast<std::uint64_t>(m_state.values[axis]), static_cast<std::uint64_t>(values[axis]),
+                             m_state.leading[axis], m_state.trailing[axis]);
+                }
+            }
+        }
+        m_state.tick = tick;
+        std::copy(std::begin(values), std::end(values), m_state.values);
+        block.lastTick = tick;
+        ++block.count;
+    }
+
+    void LocationHistory::decode(const Block &block, std::int64_t firstTick, std::int64_t lastTick,
+                                 const std::function<void(const LocationSample &)> &visit) const
+    {
+        BitReader reader(block.words);
+        EncoderState state;
+        const double steps[3] = {m_options.degreesStep, m_options.degreesStep, m_options.metersStep};
+        for (std::size_t i = 0; i < block.count; ++i)
+        {
+            if (i == 0)
+            {
+                state.tick = static_cast<std::int64_t>(reader.read(64));
+                for (std::int64_t &value : state.values)
+                {
+                    value = static_cast<std::int64_t>(reader.read(64));
+                }
+            }
+            else
+            {
+                state.tickDelta = wrappingAdd(state.tickDelta, readDelta(reader));
+                state.tick = wrappingAdd(state.tick, state.tickDelta);
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    if (m_options.encoding == Encoding::QUANTIZED)
+                    {
+                        state.valueDeltas[axis] = wrappingAdd(state.valueDeltas[axis], readDelta(reader));
+                        state.values[axis] = wrappingAdd(state.values[axis], state.valueDeltas[axis]);
+                    }
+                    else
+                    {
+                        state.values[axis] = static_cast<std::int64_t>(
+                            readXor(reader, static_cast<std::uint64_t>(state.values[axis]), state.leading[axis], state.trailing[axis]));
+                    }
+                }
+            }
+
+            if (state.tick > lastTick)
+            {
+                return;
+            }
+            if (state.tick < firstTick)
+            {
+                continue;
+            }
+            double coordinates[3];
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                coordinates[axis] = m_options.encoding == Encoding::QUANTIZED
+                                        ? static_cast<double>(state.values[axis]) * steps[axis]
+                                        : std::bit_cast<double>(state.values[axis]);
+            }
+            visit({std::chrono::steady_clock::time_point(state.tick * m_options.timeStep),
+                   Location(coordinates[0], coordinates[1], coordinates[2])});
+        }
+    }
+}
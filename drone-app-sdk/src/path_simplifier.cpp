@@ -0,0 +1,132 @@
+#include "path_simplifier.hpp"
+#include "location_batch.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace drone_sdk
+{
+    namespace
+    {
+        // Waypoints in local meters, one array per axis
+        struct LocalPoints
+        {
+            LocationBatch::Column x;
+            LocationBatch::Column y;
+            LocationBatch::Column z;
+        };
+
+        // Equirectangular projection around the first waypoint, accurate for mission sized paths
+        LocalPoints project(std::span<const Location> waypoints)
+        {
+            LocalPoints points;
+            points.x.resize(waypoints.size());
+            points.y.resize(waypoints.size());
+            points.z.resize(waypoints.size());
+            batch::toEnu(columns(waypoints), waypoints.front(), points.x, points.y, points.z);
+            return points;
+        }
+
+        /**
+         * Squared distances of the points strictly between first and last to the segment
+         * first-last, written into distances. Kept free of branches for vectorization.
+         */
+        void segmentDistances(const LocalPoints &points, std::size_t first, std::size_t last, std::vector<double> &distances)
+        {
+            const double ax = points.x[first];
+            const double ay = points.y[first];
+            const double az = points.z[first];
+            const double dx = points.x[last] - ax;
+            const double dy = points.y[last] - ay;
+            const double dz = points.z[last] - az;
+            const double lengthSquared = dx * dx + dy * dy + dz * dz;
+            // A closed segment degenerates to the distance from its start point
+            const double inverseLength = lengthSquared > 0.0 ? 1.0 / lengthSquared : 0.0;
+
+            const double *px = points.x.data();
+            const double *py = points.y.data();
+            const double *pz = points.z.data();
+            double *out = distances.data();
+            for (std::size_t i = first + 1; i < last; ++i)
+            {
+                const double vx = px[i] - ax;
+                const double vy = py[i] - ay;
+                const double vz = pz[i] - az;
+                const double t = std::clamp((vx * dx + vy * dy + vz * dz) * inverseLength, 0.0, 1.0);
+                const double ex = vx - t * dx;
+                const double ey = vy - t * dy;
+                const double ez = vz - t * dz;
+                out[i] = ex * ex + ey * ey + ez * ez;
+            }
+        }
+    }
+
+    std::vector<std::size_t> douglasPeucker(std::span<const Location> waypoints, double toleranceMeters)
+    {
+        std::vector<std::size_t> kept;
+        if (waypoints.size() <= 2)
+        {
+            for (std::size_t i = 0; i < waypoints.size(); ++i)
+            {
+                kept.push_back(i);
+            }
+            return kept;
+        }
+
+        const LocalPoints points = project(waypoints);
+        const double toleranceSquared = toleranceMeters * toleranceMeters;
+        std::vector<double> distances(waypoints.size(), 0.0);
+        std::vector<bool> keep(waypoints.size(), false);
+        keep.front() = true;
+        keep.back() = true;
+
+        std::vector<std::pair<std::size_t, std::size_t>> segments;
+        segments.emplace_back(0, waypoints.size() - 1);
+        while (!segments.empty())
+        {
+            const auto [first, last] = segments.back();
+            segments.pop_back();
+            if (last - first < 2)
+            {
+                continue;
+            }
+
+            segmentDistances(points, first, last, distances);
+            const auto farthest = std::max_element(distances.begin() + static_cast<std::ptrdiff_t>(first + 1),
+                                                   distances.begin() + static_cast<std::ptrdiff_t>(last));
+            if (*farthest > toleranceSquared)
+            {
+                const auto split = static_cast<std::size_t>(farthest - distances.begin());
+                keep[split] = true;
+                segments.emplace_back(split, last);
+                segments.emplace_back(first, split);
+            }
+        }
+
+        for (std::size_t i = 0; i < keep.size(); ++i)
+        {
+            if (keep[i])
+            {
+                kept.push_back(i);
+            }
+        }
+        return kept;
+    }
+
+    Path simplifyPath(Path path, double toleranceMeters)
+    {
+        if (toleranceMeters <= 0.0 || path.size() <= 2)
+        {
+            return path;
+        }
+
+        std::vector<std::size_t> route = douglasPeucker(path.remaining(), toleranceMeters);
+        const std::size_t offset = path.position();
+        for (std::size_t &index : route)
+        {
+            index += offset;
+        }
+        path.setRoute(std::move(route));
+        return path;
+    }
+}
@@ -0,0 +1,227 @@
+#include "state_machines/drone_state_machine.hpp"
+
+#include <chrono>
+
+namespace dronestatemachine
+{
+    namespace
+    {
+        bool sameStates(const DroneStatus &lhs, const DroneStatus &rhs)
+        {
+            return lhs.command == rhs.command && lhs.flight == rhs.flight && lhs.gps == rhs.gps &&
+                   lhs.link == rhs.link && lhs.geofence == rhs.geofence;
+        }
+
+        template <typename State>
+        void notifyChange(drone_sdk::Signal<void(drone_sdk::StateTransition<State>)> &signal, State from, State to,
+                          std::chrono::steady_clock::time_point now, drone_sdk::FlightRecorder *recorder,
+                          drone_sdk::StateRegion region)
+        {
+            if (from != to)
+            {
+                // Recorded before the subscribers run, they may dump the recorder
+                if (recorder)
+                {
+                    recorder->recordTransition(region, from, to);
+                }
+                signal({from, to, now});
+            }
+        }
+    }
+
+    DroneStateMachine::DroneStateMachine() = default;
+
+    void DroneStateMachine::handleGpsSignal(drone_sdk::SignalQuality quality)
+    {
+        handleSafetyEvent(safety::GpsSignal{quality});
+    }
+
+    void DroneStateMachine::handleLinkSignal(drone_sdk::SignalQuality quality)
+    {
+        handleSafetyEvent(safety::LinkSignal{quality});
+    }
+
+    void DroneStateMachine::handleGeofence(bool violated)
+    {
+        handleSafetyEvent(safety::GeofenceCheck{violated});
+    }
+
+    void DroneStateMachine::handleGpsLocationUpdate(const drone_sdk::Location &location)
+    {
+        m_currLocation = location;
+        if (m_status.command == drone_sdk::CommandStatus::IDLE || !m_route.arrived(m_currLocation))
+        {
+            return;
+        }
+        switch (m_currMission)
+        {
+        case drone_sdk::CurrentMission::GOTO:
+        case drone_sdk::CurrentMission::HOME:
+        case drone_sdk::CurrentMission::EMERGENCY:
+            completeTask();
+            break;
+        case drone_sdk::CurrentMission::PATH:
+            advancePath();
+            break;
+        default:
+            break;
+        }
+    }
+
+    drone_sdk::FlightControllerStatus DroneStateMachine::handleTaskAssigned(
+        drone_sdk::CurrentMission newMission,
+        const std::optional<drone_sdk::Location> &singleDestination,
+        const std::optional<std::queue<drone_sdk::Location>> &pathDestinations)
+    {
+        // The task is taken before it is validated, as the command state machine does
+        notify(dispatch(cmd::TaskAssigned{}));
+        m_currMission = newMission;
+
+        if (singleDestination && pathDestinations)
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+        switch (newMission)
+        {
+        case drone_sdk::CurrentMission::GOTO:
+            if (!singleDestination)
+            {
+                return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+            }
+            m_route.setDestination(*singleDestination);
+            break;
+        case drone_sdk::CurrentMission::HOME:
+            m_route.setDestination(m_home);
+            break;
+        case drone_sdk::CurrentMission::HOVER:
+            if (singleDestination || pathDestinations)
+            {
+                return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+            }
+            m_route.setDestination(m_currLocation);
+            completeTask();
+            break;
+        case drone_sdk::CurrentMission::PATH:
+            if (!pathDestinations || pathDestinations->empty())
+            {
+                return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+            }
+            m_route.startPath(drone_sdk::Path::fromQueue(*pathDestinations));
+            break;
+        default:
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+        notify(dispatch(MissionStarted{newMission}));
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    drone_sdk::FlightControllerStatus DroneStateMachine::handlePathAssigned(drone_sdk::Path path)
+    {
+        if (path.empty())
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+
+        notify(dispatch(cmd::TaskAssigned{}));
+        m_currMission = drone_sdk::CurrentMission::PATH;
+        m_route.startPath(std::move(path));
+        notify(dispatch(MissionStarted{m_currMission}));
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    drone_sdk::FlightControllerStatus DroneStateMachine::appendWaypoints(std::span<const drone_sdk::Location> waypoints)
+    {
+        return replaceRemaining(m_route.path().waypoints().size(), waypoints);
+    }
+
+    drone_sdk::FlightControllerStatus DroneStateMachine::replaceRemaining(std::size_t fromIndex, std::span<const drone_sdk::Location> waypoints)
+    {
+        if (m_currMission != drone_sdk::CurrentMission::PATH || m_status.command != drone_sdk::CommandStatus::BUSY ||
+            !m_route.canReplace(fromIndex))
+        {
+            return drone_sdk::FlightControllerStatus::INVALID_COMMAND;
+        }
+        m_route.replaceRemaining(fromIndex, waypoints);
+        return drone_sdk::FlightControllerStatus::SUCCESS;
+    }
+
+    drone_sdk::FlightControllerStatus DroneStateMachine::truncatePath(std::size_t endIndex)
+    {
+        return replaceRemaining(endIndex, {});
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToCommandState(const CommandStateSignal::slot_type &subscriber)
+    {
+        return m_commandSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToFlightState(const FlightStateSignal::slot_type &subscriber)
+    {
+        return m_flightSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToGpsState(const SafetyStateSignal::slot_type &subscriber)
+    {
+        return m_gpsSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToLinkState(const SafetyStateSignal::slot_type &subscriber)
+    {
+        return m_linkSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToGeofenceState(const SafetyStateSignal::slot_type &subscriber)
+    {
+        return m_geofenceSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToPathWaypoint(const LocationSignal::slot_type &subscriber)
+    {
+        return m_waypointSignal.connect(subscriber);
+    }
+
+    drone_sdk::Connection DroneStateMachine::subscribeToCurrentDestination(const LocationSignal::slot_type &subscriber)
+    {
+        return m_destinationSignal.connect(subscriber);
+    }
+
+    void DroneStateMachine::notify(const DroneStatus &before)
+    {
+        // Most events, GPS and link samples above all, change nothing
+        if (sameStates(before, m_status))
+        {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto now = m_clock ? m_clock->now() : std::chrono::steady_clock::now();
+        using drone_sdk::StateRegion;
+        notifyChange(m_flightSignal, before.flight, m_status.flight, now, m_recorder, StateRegion::FLIGHT);
+        notifyChange(m_commandSignal, before.command, m_status.command, now, m_recorder, StateRegion::COMMAND);
+        notifyChange(m_gpsSignal, before.gps, m_status.gps, now, m_recorder, StateRegion::GPS);
+        notifyChange(m_linkSignal, before.link, m_status.link, now, m_recorder, StateRegion::LINK);
+        notifyChange(m_geofenceSignal, before.geofence, m_status.geofence, now, m_recorder, StateRegion::GEOFENCE);
+    }
+
+    void DroneStateMachine::completeTask()
+    {
+        notify(dispatch(cmd::TaskCompleted{}));
+    }
+
+    void DroneStateMachine::advancePath()
+    {
+        // A simplified path reaches the waypoints it skipped along with the next kept one
+        for (std::size_t index = m_route.legBegin(); index < m_route.legEnd(); ++index)
+        {
+            m_waypointSignal(m_route.path().waypoints()[index]);
+        }
+        if (m_route.advance())
+        {
+            m_destinationSignal(m_route.destination());
+        }
+        else
+        {
+            completeTask();
+        }
+    }
+
+} // namespace dronestatemachine
@@ -0,0 +1,156 @@
+#include "telemetry_replay.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace drone_sdk
+{
+    namespace
+    {
+        constexpr std::uint64_t kFnvPrime = 0x100000001b3;
+
+        void hashByte(std::uint64_t &digest, std::uint8_t byte)
+        {
+            digest = (digest ^ byte) * kFnvPrime;
+        }
+    }
+
+    TelemetryReplay::TelemetryReplay()
+    {
+        m_manager.setClock(&m_clock);
+        const auto recorder = [this](StateRegion region)
+        {
+            return [this, region](auto transition)
+            {
+                recordTransition(region, static_cast<std::uint8_t>(transition.from), static_cast<std::uint8_t>(transition.to),
+                                 transition.timestamp);
+            };
+        };
+        m_manager.subscribeToFlightState(recorder(StateRegion::FLIGHT));
+        m_manager.subscribeToCommandState(recorder(StateRegion::COMMAND));
+        m_manager.subscribeToGpsSignalState(recorder(StateRegion::GPS));
+        m_manager.subscribeToLinkSignalState(recorder(StateRegion::LINK));
+        m_manager.subscribeToGeofenceState(recorder(StateRegion::GEOFENCE));
+    }
+
+    void TelemetryReplay::schedule(std::chrono::steady_clock::time_point when, Action action)
+    {
+        m_actions.push_back({when, std::move(action)});
+    }
+
+    ReplayResult TelemetryReplay::run(std::span<const TelemetrySample> samples, const ReplayOptions &options)
+    {
+        if (options.mode == ReplayOptions::Mode::SCALED && !(options.speed > 0.0))
+        {
+            throw std::invalid_argument("Replay speed must be positive");
+        }
+        if (!std::is_sorted(samples.begin(), samples.end(), [](const TelemetrySample &lhs, const TelemetrySample &rhs)
+                            { return lhs.timestamp < rhs.timestamp; }))
+        {
+            throw std::invalid_argument("Replayed samples must be in time order");
+        }
+        std::vector<ScheduledAction> actions = std::move(m_actions);
+        m_actions.clear();
+        std::stable_sort(actions.begin(), actions.end(), [](const ScheduledAction &lhs, const ScheduledAction &rhs)
+                         { return lhs.when < rhs.when; });
+
+        ReplayResult result;
+        if (samples.empty() && actions.empty())
+        {
+            return result;
+        }
+        const auto first = std::min(samples.empty() ? actions.front().when : samples.front().timestamp,
+                                    actions.empty() ? samples.front().timestamp : actions.front().when);
+        const auto last = std::max(samples.empty() ? actions.back().when : samples.back().timestamp,
+                                   actions.empty() ? samples.back().timestamp : actions.back().when);
+        const auto wallStart = std::chrono::steady_clock::now();
+
+        // Moves the virtual clock to @p time, waiting for the wall clock to catch up when scaled
+        const auto reach = [this, &options, first, wallStart](std::chrono::steady_clock::time_point time)
+        {
+            m_clock.advanceTo(time);
+            if (options.mode == ReplayOptions::Mode::SCALED)
+            {
+                const std::chrono::duration<double> offset = time - first;
+                std::this_thread::sleep_until(
+                    wallStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset / options.speed));
+            }
+        };
+
+        m_result = &result;
+        auto action = actions.begin();
+        const auto runActions = [&](std::chrono::steady_clock::time_point until)
+        {
+            for (; action != actions.end() && action->when <= until; ++action)
+            {
+                reach(action->when);
+                action->action(m_manager);
+            }
+        };
+        for (const TelemetrySample &sample : samples)
+        {
+            runActions(sample.timestamp);
+            reach(sample.timestamp);
+            if (sample.source == TelemetrySource::GPS)
+            {
+                m_manager.handleGpsUpdate(sample.location, sample.quality);
+            }
+            else
+            {
+                m_manager.handleLinkUpdate(sample.quality);
+            }
+            ++result.samples;
+        }
+        runActions(last);
+        m_result = nullptr;
+
+        result.simulated = last - first;
+        result.elapsed = std::chrono::steady_clock::now() - wallStart;
+        return result;
+    }
+
+    std::vector<TelemetrySample> TelemetryReplay::fromRecords(std::span<const FlightRecord> records)
+    {
+        std::vector<TelemetrySample> samples;
+        for (const FlightRecord &record : records)
+        {
+            if (record.kind != RecordKind::GPS_SAMPLE && record.kind != RecordKind::LINK_SAMPLE)
+            {
+                continue;
+            }
+            TelemetrySample &sample = samples.emplace_back();
+            sample.timestamp = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(record.timestamp));
+            sample.source = record.kind == RecordKind::GPS_SAMPLE ? TelemetrySource::GPS : TelemetrySource::LINK;
+            sample.quality = static_cast<SignalQuality>(record.from);
+            sample.location = record.location;
+        }
+        return samples;
+    }
+
+    std::vector<TelemetrySample> TelemetryReplay::load(const std::string &filename)
+    {
+        return fromRecords(FlightRecorder::load(filename));
+    }
+
+    void TelemetryReplay::recordTransition(StateRegion region, std::uint8_t from, std::uint8_t to,
+                                           std::chrono::steady_clock::time_point timestamp)
+    {
+        if (!m_result)
+        {
+            return; // The manager was driven directly, outside of run()
+        }
+        ++m_result->transitions;
+        hashByte(m_result->digest, static_cast<std::uint8_t>(region));
+        hashByte(m_result->digest, from);
+        hashByte(m_result->digest, to);
+        // Byte by byte, so the digest does not depend on the byte order of the host
+        const auto nanoseconds = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count());
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            hashByte(m_result->digest, static_cast<std::uint8_t>(nanoseconds >> shift));
+        }
+    }
+}
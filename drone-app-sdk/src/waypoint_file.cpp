@@ -0,0 +1,149 @@
+#include "waypoint_file.hpp"
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace drone_sdk
+{
+    // The records are used in place, so Location must match the on-disk layout exactly
+    static_assert(std::endian::native == std::endian::little, "Waypoint files are little endian");
+    static_assert(std::is_trivially_copyable_v<Location> && std::is_standard_layout_v<Location>);
+    static_assert(sizeof(Location) == 3 * sizeof(double), "Location must be three packed doubles");
+    static_assert(sizeof(WaypointFileHeader) == 24 && sizeof(WaypointFileHeader) % alignof(Location) == 0);
+
+    std::shared_ptr<MappedWaypointFile> MappedWaypointFile::open(const std::string &filename)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open waypoint file " + filename);
+        }
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(WaypointFileHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("Waypoint file too short: " + filename);
+        }
+
+        const auto length = static_cast<std::size_t>(info.st_size);
+        void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (mapping == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map waypoint file " + filename);
+        }
+
+        // Constructed here so that the mapping is released if validation fails
+        std::shared_ptr<MappedWaypointFile> file(new MappedWaypointFile(mapping, length));
+
+        WaypointFileHeader header;
+        std::memcpy(static_cast<void *>(&header), mapping, sizeof(header));
+        if (header.magic != WaypointFileHeader::kMagic || header.version != WaypointFileHeader::kVersion ||
+            header.recordSize != sizeof(Location))
+        {
+            throw std::runtime_error("Not a supported waypoint file: " + filename);
+        }
+        if (header.count > (length - sizeof(WaypointFileHeader)) / sizeof(Location))
+        {
+            throw std::runtime_error("Waypoint file truncated: " + filename);
+        }
+
+        const auto *records = reinterpret_cast<const Location *>(static_cast<const unsigned char *>(mapping) + sizeof(WaypointFileHeader));
+        file->m_waypoints = std::span<const Location>(records, static_cast<std::size_t>(header.count));
+
+        // Missions read the waypoints front to back: read ahead and drop pages once passed
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+        return file;
+    }
+
+    MappedWaypointFile::MappedWaypointFile(void *mapping, std::size_t length)
+        : m_mapping(mapping), m_length(length)
+    {
+    }
+
+    MappedWaypointFile::~MappedWaypointFile()
+    {
+        ::munmap(m_mapping, m_length);
+    }
+
+    Path loadPathFile(const std::string &filename)
+    {
+        auto file = MappedWaypointFile::open(filename);
+        const auto waypoints = file->waypoints();
+        return Path(std::move(file), waypoints);
+    }
+
+    WaypointFileWriter::WaypointFileWriter(const std::string &filename)
+        : m_file(std::fopen(filename.c_str(), "wb"))
+    {
+        if (m_file == nullptr)
+        {
+            throw std::runtime_error("Cannot create waypoint file " + filename);
+        }
+
+        // Placeholder header, the count is filled in by close()
+        WaypointFileHeader header;
+        if (std::fwrite(&header, sizeof(header), 1, m_file) != 1)
+        {
+            std::fclose(m_file);
+            throw std::runtime_error("Cannot write waypoint file " + filename);
+        }
+    }
+
+    WaypointFileWriter::~WaypointFileWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (const std::exception &)
+        {
+            // Nothing sensible left to do while unwinding
+        }
+    }
+
+    void WaypointFileWriter::append(const Location &waypoint)
+    {
+        append(std::span<const Location>(&waypoint, 1));
+    }
+
+    void WaypointFileWriter::append(std::span<const Location> waypoints)
+    {
+        if (m_file == nullptr)
+        {
+            throw std::runtime_error("Waypoint file already closed");
+        }
+        if (std::fwrite(waypoints.data(), sizeof(Location), waypoints.size(), m_file) != waypoints.size())
+        {
+            throw std::runtime_error("Cannot write waypoint file");
+        }
+        m_count += waypoints.size();
+    }
+
+    void WaypointFileWriter::close()
+    {
+        if (m_file == nullptr)
+        {
+            return;
+        }
+
+        WaypointFileHeader header;
+        header.count = m_count;
+        const bool ok = std::fseek(m_file, 0, SEEK_SET) == 0 &&
+                        std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+        const bool closed = std::fclose(m_file) == 0;
+        m_file = nullptr;
+        if (!ok || !closed)
+        {
+            throw std::runtime_error("Cannot finalize waypoint file");
+        }
+    }
+}
@@ -2,32 +2,38 @@
 #define MOCK_FLIGHT_CONTROLLER_HANDLER_HPP
 
 #include "icd.hpp" // For drone_sdk::FlightControllerStatus
+#include "retry_policy.hpp" // For drone_sdk::RetryPolicy
 
 class MockFlightControllerHandler
 {
 public:
-    MockFlightControllerHandler() = default;
+    using Done = drone_sdk::Retrier::Done;
+
+    explicit MockFlightControllerHandler(drone_sdk::Retrier::Schedule schedule = {})
+    {
+        (void)schedule; // Mocked commands complete at once, nothing is retried
+    }
 
     // Simulated command to arm the flight controller
-    drone_sdk::FlightControllerStatus arm()
+    void arm(Done done)
     {
         // Mocked response
-        return returnVal;
+        done(returnVal);
     }
 
     // Simulated command to disarm the flight controller
-    drone_sdk::FlightControllerStatus disarm()
+    void disarm(Done done)
     {
         // Mocked response
-        return returnVal;
+        done(returnVal);
     }
 
     // Simulated command to take off
-    drone_sdk::FlightControllerStatus takeOff(const drone_sdk::Location &location)
+    void takeOff(const drone_sdk::Location &location, Done done)
     {
         // Mocked response
         (void)location;
-        return returnVal;
+        done(returnVal);
     }
 
     // Simulated command to land
@@ -37,24 +43,34 @@ public:
     }
 
     // Simulated command to return to home location
-    drone_sdk::FlightControllerStatus goHome()
+    void goHome(Done done)
     {
         // Mocked response
-        return returnVal;
+        done(returnVal);
     }
 
     // Simulated command to go to a specific location
-    drone_sdk::FlightControllerStatus goTo(drone_sdk::Location location)
+    void goTo(drone_sdk::Location location, Done done)
     {
         // Mocked response
         (void)location;
-        return returnVal;
+        done(returnVal);
     }
     void setUpReturnVal(drone_sdk::FlightControllerStatus newVal)
     {
         returnVal = newVal;
     }
 
+    void setRetryPolicy(const drone_sdk::RetryPolicy &policy)
+    {
+        (void)policy; // Mocked commands never fail transiently
+    }
+
+    drone_sdk::RetryMetrics retryMetrics() const
+    {
+        return {};
+    }
+
 private:
     drone_sdk::FlightControllerStatus returnVal = drone_sdk::FlightControllerStatus::SUCCESS;
 };
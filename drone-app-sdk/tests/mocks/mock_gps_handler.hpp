@@ -2,7 +2,7 @@
 #ifndef MOCK_GPS_HANDLER_HPP
 #define MOCK_GPS_HANDLER_HPP
 
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include "icd.hpp"
 
 class MockGpsHandler {
@@ -11,10 +11,10 @@ public:
     ~MockGpsHandler() = default;
 
     // Define the signal type using ICD types (drone_sdk::Location, drone_sdk::SignalQuality)
-    using GpsUpdateSignal = boost::signals2::signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
+    using GpsUpdateSignal = drone_sdk::Signal<void(drone_sdk::Location, drone_sdk::SignalQuality)>;
 
     // Subscribe to GPS update signals
-    boost::signals2::connection subscribe(const GpsUpdateSignal::slot_type& slot) {
+    drone_sdk::Connection subscribe(const GpsUpdateSignal::slot_type& slot) {
         return m_gpsUpdateSignal.connect(slot);
     }
 
@@ -69,10 +69,12 @@ public:
         m_linkHandler.subscribe(slot);
     }
 
-    // Load a set of mock GPS data into the queue
-    void loadMockGpsData(const std::queue<drone_sdk::Location> &gpsData)
+    // Load a set of mock GPS data into the queue, a fix without a quality has NO_SIGNAL
+    void loadMockGpsData(const std::queue<drone_sdk::Location> &gpsData,
+                         const std::queue<drone_sdk::SignalQuality> &signalQualities = {})
     {
         m_mockGpsData = gpsData;
+        m_mockSignalQuality = signalQualities;
     }
 
     // Load a set of mock Link data into the queue
@@ -89,7 +91,12 @@ private:
         {
             // Get the next Location and SignalQuality
             drone_sdk::Location location = m_mockGpsData.front();
-            drone_sdk::SignalQuality signalQuality = m_mockSignalQuality.front();
+            drone_sdk::SignalQuality signalQuality = drone_sdk::SignalQuality::NO_SIGNAL;
+            if (!m_mockSignalQuality.empty())
+            {
+                signalQuality = m_mockSignalQuality.front();
+                m_mockSignalQuality.pop();
+            }
 
             m_mockGpsData.pop();
 
@@ -2,7 +2,7 @@
 #ifndef MOCK_LINK_HANDLER_HPP
 #define MOCK_LINK_HANDLER_HPP
 
-#include <boost/signals2.hpp>
+#include "signal.hpp"
 #include "icd.hpp"
 
 class MockLinkHandler {
@@ -11,10 +11,10 @@ public:
     ~MockLinkHandler() = default;
 
     // Define the signal type using ICD types (drone_sdk::SignalQuality)
-    using LinkUpdateSignal = boost::signals2::signal<void(drone_sdk::SignalQuality)>;
+    using LinkUpdateSignal = drone_sdk::Signal<void(drone_sdk::SignalQuality)>;
 
     // Subscribe to Link update signals
-    boost::signals2::connection subscribe(const LinkUpdateSignal::slot_type& slot) {
+    drone_sdk::Connection subscribe(const LinkUpdateSignal::slot_type& slot) {
         return m_linkUpdateSignal.connect(slot);
     }
 
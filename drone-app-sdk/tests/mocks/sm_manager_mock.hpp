@@ -27,22 +27,22 @@ public:
         m_mockLinkUpdateCallback = std::move(callback);
     }
 
-    void subscribeToFlightState(std::function<void(drone_sdk::FlightState)> callback)
+    void subscribeToFlightState(std::function<void(drone_sdk::FlightTransition)> callback)
     {
         m_mockFlightStateCallback = std::move(callback);
     }
 
-    void subscribeToGpsSignalState(std::function<void(drone_sdk::safetyState)> callback)
+    void subscribeToGpsSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
     {
         m_mockGpsSignalStateCallback = std::move(callback);
     }
 
-    void subscribeToLinkSignalState(std::function<void(drone_sdk::safetyState)> callback)
+    void subscribeToLinkSignalState(std::function<void(drone_sdk::SafetyTransition)> callback)
     {
         m_mockLinkSignalStateCallback = std::move(callback);
     }
 
-    void subscribeToCommandState(std::function<void(drone_sdk::CommandStatus)> callback)
+    void subscribeToCommandState(std::function<void(drone_sdk::CommandTransition)> callback)
     {
         m_mockCommandStateCallback = std::move(callback);
     }
@@ -108,10 +108,10 @@ private:
     // Mock callback functions
     std::function<void(const drone_sdk::Location &, const drone_sdk::SignalQuality)> m_mockGpsUpdateCallback;
     std::function<void(drone_sdk::SignalQuality)> m_mockLinkUpdateCallback;
-    std::function<void(drone_sdk::FlightState)> m_mockFlightStateCallback;
-    std::function<void(drone_sdk::safetyState)> m_mockGpsSignalStateCallback;
-    std::function<void(drone_sdk::safetyState)> m_mockLinkSignalStateCallback;
-    std::function<void(drone_sdk::CommandStatus)> m_mockCommandStateCallback;
+    std::function<void(drone_sdk::FlightTransition)> m_mockFlightStateCallback;
+    std::function<void(drone_sdk::SafetyTransition)> m_mockGpsSignalStateCallback;
+    std::function<void(drone_sdk::SafetyTransition)> m_mockLinkSignalStateCallback;
+    std::function<void(drone_sdk::CommandTransition)> m_mockCommandStateCallback;
     std::function<void(drone_sdk::Location)> m_mockWaypointCallback;
     std::function<void(drone_sdk::Location)> m_mockCurrentDestinationCallback;
 };
@@ -0,0 +1,128 @@
+#include "actor_executor.hpp"
+#include "mpsc_inbox.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Test: with several producers nothing is lost and each producer's elements keep their order
+TEST(MpscInboxTest, KeepsPerProducerOrder)
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    MpscInbox<std::pair<int, int>> inbox;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducers; ++producer)
+    {
+        producers.emplace_back([&inbox, producer]()
+                               {
+                                   for (int i = 0; i < kPerProducer; ++i)
+                                   {
+                                       inbox.push({producer, i});
+                                   } });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    std::pair<int, int> element;
+    while (received < kProducers * kPerProducer)
+    {
+        if (!inbox.tryPop(element))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(element.second, next[static_cast<std::size_t>(element.first)]);
+        ++next[static_cast<std::size_t>(element.first)];
+        ++received;
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_FALSE(inbox.tryPop(element));
+}
+
+// Test: messages run one at a time on one thread, a call returns its result
+TEST(ActorExecutorTest, RunsMessagesToCompletion)
+{
+    ActorExecutor actor;
+    int counter = 0; // Only touched by the actor, no lock
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+
+    std::vector<std::thread> senders;
+    for (int sender = 0; sender < 4; ++sender)
+    {
+        senders.emplace_back([&]()
+                             {
+                                 for (int i = 0; i < 1000; ++i)
+                                 {
+                                     actor.post([&]()
+                                                {
+                                                    overlapped = overlapped || running.fetch_add(1) != 0;
+                                                    ++counter;
+                                                    running.fetch_sub(1); });
+                                 } });
+    }
+    for (auto &sender : senders)
+    {
+        sender.join();
+    }
+
+    std::thread::id actorThread;
+    const int seen = actor.call([&]()
+                                {
+                                    actorThread = std::this_thread::get_id();
+                                    return counter; })
+                         .get();
+    EXPECT_EQ(seen, 4000); // Sent after all the posts, so it runs after them
+    EXPECT_FALSE(overlapped);
+    EXPECT_NE(actorThread, std::this_thread::get_id());
+    EXPECT_GE(actor.processed(), 4000u); // The call counts once it returned
+}
+
+// Test: a call made by a message runs inline instead of waiting for itself
+TEST(ActorExecutorTest, CallFromActorDoesNotDeadlock)
+{
+    ActorExecutor actor;
+    auto outer = actor.call([&actor]()
+                            {
+                                EXPECT_TRUE(actor.onActorThread());
+                                return actor.call([]()
+                                                  { return 5; })
+                                           .get() +
+                                       1; });
+    ASSERT_EQ(outer.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(outer.get(), 6);
+    EXPECT_FALSE(actor.onActorThread());
+}
+
+// Test: an exception reaches the caller, messages still waiting run before destruction ends
+TEST(ActorExecutorTest, ExceptionsAndShutdown)
+{
+    std::atomic<int> ran{0};
+    {
+        ActorExecutor actor;
+        auto failing = actor.call([]() -> int
+                                  { throw std::runtime_error("boom"); });
+        EXPECT_THROW(failing.get(), std::runtime_error);
+
+        std::promise<void> release;
+        actor.post([gate = release.get_future()]() mutable
+                   { gate.wait(); });
+        for (int i = 0; i < 10; ++i)
+        {
+            actor.post([&ran]()
+                       { ++ran; });
+        }
+        release.set_value();
+    }
+    EXPECT_EQ(ran.load(), 10);
+}
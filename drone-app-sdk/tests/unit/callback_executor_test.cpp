@@ -0,0 +1,209 @@
+#include "callback_executor.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Poll until a condition holds or the timeout expires
+    template <typename Predicate>
+    bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = 2000ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+}
+
+class CallbackExecutorTest : public ::testing::Test
+{
+protected:
+    std::mutex mutex;
+    std::vector<int> received;
+    std::atomic<bool> release{false};
+
+    CallbackExecutor executor; // Declared last so that its threads stop before the state above goes away
+
+    void TearDown() override
+    {
+        release = true; // Never leave a worker stuck in a gated subscriber
+    }
+
+    // A subscriber that holds its first event until the test releases it
+    std::function<void(int)> gatedSubscriber(DeliveryOptions options)
+    {
+        return executor.wrap(std::function<void(int)>([this](int value)
+                                                      {
+            while (!release) {
+                std::this_thread::sleep_for(1ms);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(value); }),
+                             std::move(options));
+    }
+
+    std::vector<int> receivedValues()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received;
+    }
+};
+
+// Test: events arrive in publish order on another thread
+TEST_F(CallbackExecutorTest, DeliversInOrderOffThePublisherThread)
+{
+    const auto publisher = std::this_thread::get_id();
+    std::atomic<bool> sameThread{false};
+    auto callback = executor.wrap(std::function<void(int)>([&](int value)
+                                                           {
+        sameThread = sameThread || std::this_thread::get_id() == publisher;
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(value); }),
+                                  DeliveryOptions{});
+
+    for (int i = 0; i < 10; ++i)
+    {
+        callback(i);
+    }
+    ASSERT_TRUE(waitFor([this]()
+                        { return receivedValues().size() == 10; }));
+
+    EXPECT_EQ(receivedValues(), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_FALSE(sameThread);
+}
+
+// Test: DROP_OLDEST keeps the newest events when the subscriber falls behind
+TEST_F(CallbackExecutorTest, DropOldest)
+{
+    auto callback = gatedSubscriber({OverflowPolicy::DROP_OLDEST, 2, "drop"});
+
+    callback(0); // Taken by the worker and held there
+    ASSERT_TRUE(waitFor([this]()
+                        { return executor.queueStats()[0].depth == 0; }));
+    for (int i = 1; i <= 5; ++i)
+    {
+        callback(i);
+    }
+    release = true;
+    ASSERT_TRUE(waitFor([this]()
+                        { return receivedValues().size() == 3; }));
+
+    EXPECT_EQ(receivedValues(), (std::vector<int>{0, 4, 5}));
+    SubscriberQueueStats stats = executor.queueStats()[0];
+    EXPECT_EQ(stats.name, "drop");
+    EXPECT_EQ(stats.dropped, 3u);
+    EXPECT_EQ(stats.highWaterMark, 2u);
+}
+
+// Test: COALESCE_LATEST keeps the oldest queued events and the latest value
+TEST_F(CallbackExecutorTest, CoalesceLatest)
+{
+    auto callback = gatedSubscriber({OverflowPolicy::COALESCE_LATEST, 2, "coalesce"});
+
+    callback(0);
+    ASSERT_TRUE(waitFor([this]()
+                        { return executor.queueStats()[0].depth == 0; }));
+    for (int i = 1; i <= 5; ++i)
+    {
+        callback(i);
+    }
+    release = true;
+    ASSERT_TRUE(waitFor([this]()
+                        { return receivedValues().size() == 3; }));
+
+    EXPECT_EQ(receivedValues(), (std::vector<int>{0, 1, 5}));
+    EXPECT_EQ(executor.queueStats()[0].coalesced, 3u);
+}
+
+// Test: BLOCK makes the publisher wait instead of losing events
+TEST_F(CallbackExecutorTest, BlockWaitsForRoom)
+{
+    auto callback = gatedSubscriber({OverflowPolicy::BLOCK, 1, "block"});
+
+    callback(0);
+    ASSERT_TRUE(waitFor([this]()
+                        { return executor.queueStats()[0].depth == 0; }));
+    callback(1);
+
+    std::atomic<bool> published{false};
+    std::thread publisher([&]()
+                          {
+        callback(2);
+        published = true; });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(published);
+
+    release = true;
+    publisher.join();
+    ASSERT_TRUE(waitFor([this]()
+                        { return receivedValues().size() == 3; }));
+
+    EXPECT_EQ(receivedValues(), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(executor.queueStats()[0].blocked, 1u);
+}
+
+// Test: a slow subscriber does not hold up another one
+TEST_F(CallbackExecutorTest, SlowSubscriberIsolated)
+{
+    CallbackExecutor pool(2);
+    std::atomic<bool> slowRelease{false};
+    std::atomic<int> fastCalls{0};
+
+    auto slow = pool.wrap(std::function<void()>([&slowRelease]()
+                                                {
+        while (!slowRelease) {
+            std::this_thread::sleep_for(1ms);
+        } }),
+                          DeliveryOptions{});
+    auto fast = pool.wrap(std::function<void()>([&fastCalls]()
+                                                { ++fastCalls; }),
+                          DeliveryOptions{});
+
+    slow();
+    for (int i = 0; i < 5; ++i)
+    {
+        fast();
+    }
+
+    EXPECT_TRUE(waitFor([&fastCalls]()
+                        { return fastCalls == 5; }));
+    slowRelease = true;
+}
+
+// Test: destroying the executor releases publishers blocked on a full queue
+TEST(CallbackExecutorShutdownTest, ReleasesBlockedPublisher)
+{
+    std::atomic<bool> release{false};
+    std::thread publisher;
+    {
+        CallbackExecutor executor;
+        auto callback = executor.wrap(std::function<void()>([&release]()
+                                                            {
+            while (!release) {
+                std::this_thread::sleep_for(1ms);
+            } }),
+                                      DeliveryOptions{OverflowPolicy::BLOCK, 1, ""});
+        callback();
+        ASSERT_TRUE(waitFor([&executor]()
+                            { return executor.queueStats()[0].depth == 0; }));
+        callback();
+        publisher = std::thread([callback]()
+                                { callback(); });
+        std::this_thread::sleep_for(10ms);
+        release = true;
+    }
+    publisher.join();
+}
@@ -0,0 +1,102 @@
+#include "command_coalescer.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Collects what the coalescer sends, in order
+    struct Sink
+    {
+        std::mutex mutex;
+        std::vector<int> sent;
+
+        void operator()(const int &setpoint)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sent.push_back(setpoint);
+        }
+
+        std::vector<int> values()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return sent;
+        }
+    };
+
+    void waitForWorker(CommandWorker &worker)
+    {
+        while (worker.pending() > 0)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        worker.submit([]() {}).get();
+    }
+}
+
+// Test: a burst collapses into the newest setpoint and the rest are reported superseded
+TEST(CommandCoalescerTest, BurstKeepsLatest)
+{
+    Sink sink;
+    CommandWorker worker;
+    CommandCoalescer<int> coalescer(worker, std::ref(sink), 20.0);
+
+    coalescer.submit(0); // Sent right away
+    waitForWorker(worker);
+    for (int i = 1; i <= 100; ++i)
+    {
+        coalescer.submit(i);
+    }
+    waitForWorker(worker);
+
+    EXPECT_EQ(sink.values(), (std::vector<int>{0, 100}));
+    const auto stats = coalescer.stats();
+    EXPECT_EQ(stats.submitted, 101u);
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.superseded, 99u);
+}
+
+// Test: sends are spaced by at least the period, without delaying other commands
+TEST(CommandCoalescerTest, RateLimitDoesNotBlockWorker)
+{
+    Sink sink;
+    CommandWorker worker;
+    CommandCoalescer<int> coalescer(worker, std::ref(sink), 5.0); // 200 ms period
+
+    coalescer.submit(1);
+    waitForWorker(worker);
+    const auto start = std::chrono::steady_clock::now();
+    coalescer.submit(2);
+
+    auto other = worker.submit([]()
+                               { return 7; });
+    EXPECT_EQ(other.wait_for(100ms), std::future_status::ready);
+    EXPECT_EQ(sink.values(), (std::vector<int>{1}));
+
+    waitForWorker(worker);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 150ms);
+    EXPECT_EQ(sink.values(), (std::vector<int>{1, 2}));
+}
+
+// Test: a cancelled setpoint is never sent
+TEST(CommandCoalescerTest, CancelDropsPending)
+{
+    Sink sink;
+    CommandWorker worker;
+    CommandCoalescer<int> coalescer(worker, std::ref(sink), 5.0);
+
+    coalescer.submit(1);
+    waitForWorker(worker);
+    coalescer.submit(2);
+    coalescer.cancel();
+    waitForWorker(worker);
+
+    EXPECT_EQ(sink.values(), (std::vector<int>{1}));
+    EXPECT_EQ(coalescer.stats().superseded, 1u);
+}
@@ -49,3 +49,18 @@ TEST_F(CommandControllerTest, TestabbortMission)
     EXPECT_EQ(status, FlightControllerStatus::SUCCESS); // Verify response
     // Additional checks for mock state machine interactions
 }
+
+// Test: asynchronous commands deliver their status through a future or a callback
+TEST_F(CommandControllerTest, AsyncCommands)
+{
+    Location destination(10.0, 20.0, 30.0);
+
+    std::future<FlightControllerStatus> flight = controller.goToAsync(destination);
+    std::promise<FlightControllerStatus> hovered;
+    controller.hoverAsync([&hovered](FlightControllerStatus status)
+                          { hovered.set_value(status); });
+
+    EXPECT_EQ(flight.get(), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(hovered.get_future().get(), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(controller.abortMissionAsync().get(), FlightControllerStatus::SUCCESS);
+}
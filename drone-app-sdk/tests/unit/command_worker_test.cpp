@@ -0,0 +1,107 @@
+#include "command_worker.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Test: jobs run in submission order on one thread that is not the caller's
+TEST(CommandWorkerTest, RunsJobsInOrder)
+{
+    CommandWorker worker;
+    std::vector<int> order;
+    std::thread::id workerThread;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        worker.post([&order, i]()
+                    { order.push_back(i); });
+    }
+    auto done = worker.submit([&workerThread]()
+                              { workerThread = std::this_thread::get_id();
+                                return 7; });
+
+    EXPECT_EQ(done.get(), 7);
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_NE(workerThread, std::this_thread::get_id());
+}
+
+// Test: submitting does not wait for a slow job ahead in the queue
+TEST(CommandWorkerTest, SubmitDoesNotBlock)
+{
+    CommandWorker worker;
+    std::promise<void> release;
+    worker.post([gate = release.get_future()]() mutable
+                { gate.wait(); });
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = worker.submit([]()
+                                { return 1; });
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(result.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+    release.set_value();
+    EXPECT_EQ(result.get(), 1);
+}
+
+// Test: completion callbacks get the result, exceptions reach the future
+TEST(CommandWorkerTest, CallbacksAndExceptions)
+{
+    CommandWorker worker;
+    std::promise<int> seen;
+    worker.submit([]()
+                  { return 3; },
+                  [&seen](int value)
+                  { seen.set_value(value); });
+    auto failing = worker.submit([]() -> int
+                                 { throw std::runtime_error("no link"); });
+
+    EXPECT_EQ(seen.get_future().get(), 3);
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+// Test: jobs still queued at destruction run before the worker stops
+TEST(CommandWorkerTest, DrainsOnDestruction)
+{
+    std::atomic<int> ran{0};
+    {
+        CommandWorker worker;
+        for (int i = 0; i < 100; ++i)
+        {
+            worker.post([&ran]()
+                        { ++ran; });
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
+
+// Test: a delayed job waits for its time while later posted jobs run
+TEST(CommandWorkerTest, DelayedJobsDoNotHoldUpOthers)
+{
+    CommandWorker worker;
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&mutex, &order](int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(value);
+    };
+
+    worker.postAt(CommandWorker::Clock::now() + std::chrono::milliseconds(50), [&record]()
+                  { record(1); });
+    worker.post([&record]()
+                { record(2); });
+    worker.submit([]() {}).get();
+    EXPECT_EQ(worker.pending(), 1u);
+
+    while (worker.pending() > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    worker.submit([]() {}).get();
+    EXPECT_EQ(order, (std::vector<int>{2, 1}));
+}
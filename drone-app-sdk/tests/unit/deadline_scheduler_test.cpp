@@ -0,0 +1,110 @@
+#include "deadline_scheduler.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+class DeadlineSchedulerTest : public ::testing::Test
+{
+protected:
+    using Clock = DeadlineScheduler::Clock;
+
+    DeadlineScheduler scheduler{100ms};
+    Clock::time_point start = Clock::now();
+
+    void SetUp() override
+    {
+        scheduler.reset(start);
+    }
+
+    // Run one tick that wakes up 'lateness' after its deadline and works for 'work'
+    void runTick(Clock::duration lateness, Clock::duration work)
+    {
+        const auto begin = scheduler.nextDeadline() + lateness;
+        scheduler.beginTick(begin);
+        scheduler.endTick(begin + work);
+    }
+};
+
+// Test: the first deadline is the start time
+TEST_F(DeadlineSchedulerTest, FirstDeadlineIsStart)
+{
+    EXPECT_EQ(scheduler.nextDeadline(), start);
+    EXPECT_TRUE(scheduler.isDue(start));
+    EXPECT_FALSE(scheduler.isDue(start - 1ms));
+}
+
+// Test: the time spent in a tick does not stretch the period
+TEST_F(DeadlineSchedulerTest, WorkDoesNotDrift)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        runTick(2ms, 30ms);
+    }
+
+    EXPECT_EQ(scheduler.nextDeadline(), start + 50 * 100ms);
+    EXPECT_EQ(scheduler.stats().ticks, 50u);
+    EXPECT_EQ(scheduler.stats().missedDeadlines, 0u);
+}
+
+// Test: rate conversion
+TEST_F(DeadlineSchedulerTest, PeriodFromRate)
+{
+    EXPECT_EQ(DeadlineScheduler::periodFromRate(50.0), std::chrono::duration_cast<Clock::duration>(20ms));
+    EXPECT_EQ(DeadlineScheduler::periodFromRate(5.0), std::chrono::duration_cast<Clock::duration>(200ms));
+    EXPECT_THROW(DeadlineScheduler::periodFromRate(0.0), std::invalid_argument);
+    EXPECT_THROW(DeadlineScheduler::periodFromRate(-10.0), std::invalid_argument);
+    EXPECT_THROW(DeadlineScheduler::periodFromRate(std::nan("")), std::invalid_argument);
+    EXPECT_THROW(DeadlineScheduler::periodFromRate(HUGE_VAL), std::invalid_argument);
+}
+
+// Test: an overrunning tick skips the missed deadlines and keeps the phase
+TEST_F(DeadlineSchedulerTest, OverrunSkipsMissedDeadlines)
+{
+    runTick(0ms, 250ms); // Ends 150 ms past its period, deadlines at 100 ms and 200 ms are gone
+
+    PollingStats stats = scheduler.stats();
+    EXPECT_EQ(stats.missedDeadlines, 2u);
+    EXPECT_EQ(stats.lastOverrun, 150ms);
+    EXPECT_EQ(stats.maxOverrun, 150ms);
+    EXPECT_EQ(scheduler.nextDeadline(), start + 300ms);
+}
+
+// Test: a tick that ends exactly on the next deadline misses nothing
+TEST_F(DeadlineSchedulerTest, EndingOnDeadlineIsNotMissed)
+{
+    runTick(0ms, 100ms);
+
+    EXPECT_EQ(scheduler.stats().missedDeadlines, 0u);
+    EXPECT_EQ(scheduler.stats().lastOverrun, 0ms);
+    EXPECT_EQ(scheduler.nextDeadline(), start + 100ms);
+}
+
+// Test: jitter statistics follow the wake-up lateness
+TEST_F(DeadlineSchedulerTest, JitterStatistics)
+{
+    runTick(1ms, 0ms);
+    runTick(5ms, 0ms);
+    runTick(3ms, 0ms);
+
+    PollingStats stats = scheduler.stats();
+    EXPECT_EQ(stats.lastJitter, 3ms);
+    EXPECT_EQ(stats.maxJitter, 5ms);
+    EXPECT_EQ(stats.meanJitter, 3ms);
+}
+
+// Test: reset clears the statistics
+TEST_F(DeadlineSchedulerTest, ResetClearsStatistics)
+{
+    runTick(4ms, 500ms);
+    scheduler.reset(start);
+
+    PollingStats stats = scheduler.stats();
+    EXPECT_EQ(stats.ticks, 0u);
+    EXPECT_EQ(stats.missedDeadlines, 0u);
+    EXPECT_EQ(stats.maxJitter, 0ms);
+    EXPECT_EQ(scheduler.nextDeadline(), start);
+}
@@ -4,7 +4,11 @@
 #include <gtest/gtest.h>
 #include "drone_controller.hpp"
 #include "mock_hw_monitor.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <string>
 // TestObserver class to track the subscription callback calls
 class TestObserver
 {
@@ -91,20 +95,20 @@ protected:
     void InitSubscriptions(TestObserver &observer)
     {
         // Subscribe the observer functions to the DroneController signals
-        m_droneController.subscribeToGpsSignalState([&observer](drone_sdk::safetyState state)
-                                                    { observer.onGpsSignalStateUpdate(state); });
+        m_droneController.subscribeToGpsSignalState([&observer](drone_sdk::SafetyTransition transition)
+                                                    { observer.onGpsSignalStateUpdate(transition.to); });
 
-        m_droneController.subscribeToLinkSignalState([&observer](drone_sdk::safetyState state)
-                                                     { observer.onLinkSignalStateUpdate(state); });
+        m_droneController.subscribeToLinkSignalState([&observer](drone_sdk::SafetyTransition transition)
+                                                     { observer.onLinkSignalStateUpdate(transition.to); });
 
         m_droneController.subscribeToGpsLocation([&observer](const drone_sdk::Location &location, const drone_sdk::SignalQuality &quality)
                                                  { observer.onGpsLocationUpdate(location, quality); });
 
-        m_droneController.subscribeToFlightState([&observer](drone_sdk::FlightState state)
-                                                 { observer.onFlightStateUpdate(state); });
+        m_droneController.subscribeToFlightState([&observer](drone_sdk::FlightTransition transition)
+                                                 { observer.onFlightStateUpdate(transition.to); });
 
-        m_droneController.subscribeToCommandState([&observer](drone_sdk::CommandStatus status)
-                                                  { observer.onCommandStateUpdate(status); });
+        m_droneController.subscribeToCommandState([&observer](drone_sdk::CommandTransition transition)
+                                                  { observer.onCommandStateUpdate(transition.to); });
 
         m_droneController.subscribeToWaypoint([&observer](drone_sdk::Location location)
                                               { observer.onWaypointUpdate(location); });
@@ -127,7 +131,7 @@ TEST_F(DroneControllerSelfLoadingTest, InitSubscriptionsTest)
     gpsQualities.push(drone_sdk::SignalQuality::EXCELLENT);
     linkQualities.push(drone_sdk::SignalQuality::EXCELLENT);
     locations.push({1, 2.5, 3});
-    gpsQualities.push(drone_sdk::SignalQuality::EXCELLENT);
+    gpsQualities.push(drone_sdk::SignalQuality::NO_SIGNAL);
     linkQualities.push(drone_sdk::SignalQuality::NO_SIGNAL);
     
     m_droneController.loadMockGpsData(locations, gpsQualities);
@@ -152,6 +156,112 @@ TEST_F(DroneControllerSelfLoadingTest, InitSubscriptionsTest)
     
 }
 
+// Test case to verify that the snapshot follows the telemetry
+TEST_F(DroneControllerSelfLoadingTest, SnapshotTest)
+{
+    drone_sdk::TelemetrySnapshot initial = m_droneController.snapshot();
+    EXPECT_EQ(initial.flightState, drone_sdk::FlightState::LANDED);
+    EXPECT_EQ(initial.commandStatus, drone_sdk::CommandStatus::IDLE);
+#ifdef DEBUG_MODE
+    std::queue<drone_sdk::Location> locations;
+    std::queue<drone_sdk::SignalQuality> gpsQualities;
+    std::queue<drone_sdk::SignalQuality> linkQualities;
+    locations.push({1, 2, 3});
+    gpsQualities.push(drone_sdk::SignalQuality::GOOD);
+    linkQualities.push(drone_sdk::SignalQuality::FAIR);
+
+    m_droneController.loadMockGpsData(locations, gpsQualities);
+    m_droneController.loadMockLinkData(linkQualities);
+    m_droneController.runMockData();
+#endif
+    std::this_thread::sleep_for(std::chrono::milliseconds(250)); // Wait for mock updates to propagate
+    m_droneController.stopMockData();
+
+    drone_sdk::TelemetrySnapshot snapshot = m_droneController.snapshot();
+    EXPECT_EQ(snapshot.location, drone_sdk::Location(1, 2, 3));
+    EXPECT_EQ(snapshot.linkQuality, drone_sdk::SignalQuality::FAIR);
+    EXPECT_GT(snapshot.version, initial.version);
+    EXPECT_GT(snapshot.timestamp, initial.timestamp);
+}
+
+// Test case to verify that queued missions are validated up front and started when idle
+TEST_F(DroneControllerSelfLoadingTest, MissionQueueTest)
+{
+    TestObserver observer;
+    InitSubscriptions(observer);
+
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::followPath(drone_sdk::Path{})),
+              drone_sdk::FlightControllerStatus::INVALID_COMMAND);
+    EXPECT_EQ(m_droneController.queuedMissions(), 0u);
+
+    // Idle, so the first mission starts right away
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::goTo({1, 2, 10})), drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.queuedMissions(), 0u);
+    EXPECT_EQ(observer.m_lastCommandStatus, drone_sdk::CommandStatus::BUSY);
+
+    // Busy, so the next ones wait
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::goTo({1, 3, 10})), drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::followPath({{1, 4, 10}, {1, 5, 10}})),
+              drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.insertMissionFront(drone_sdk::Mission::goTo({2, 2, 10})), drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.queuedMissions(), 3u);
+
+    // Rejected by the geofence before being queued
+    auto geofence = std::make_shared<drone_sdk::Geofence>();
+    geofence->setAltitudeCeiling(50.0);
+    m_droneController.setGeofence(geofence);
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::goTo({1, 6, 80})), drone_sdk::FlightControllerStatus::GEOFENCE_VIOLATION);
+    EXPECT_EQ(m_droneController.queuedMissions(), 3u);
+
+    m_droneController.clearMissions();
+    EXPECT_EQ(m_droneController.queuedMissions(), 0u);
+}
+
+// Test case to verify that completing a mission starts the next queued one, after every subscriber heard of the completion
+TEST_F(DroneControllerSelfLoadingTest, MissionQueueHandOffTest)
+{
+    TestObserver observer;
+    InitSubscriptions(observer);
+
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::goTo({1, 2, 10})), drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.enqueueMission(drone_sdk::Mission::goTo({1, 3, 10})), drone_sdk::FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_droneController.queuedMissions(), 1u);
+
+#ifdef DEBUG_MODE
+    // Reaching the first destination completes the first mission
+    std::queue<drone_sdk::Location> locations;
+    std::queue<drone_sdk::SignalQuality> gpsQualities;
+    locations.push({1, 2, 10});
+    gpsQualities.push(drone_sdk::SignalQuality::GOOD);
+    m_droneController.loadMockGpsData(locations, gpsQualities);
+    m_droneController.runMockData();
+#endif
+
+    // The flight controller gets the destination of the next mission
+    const std::string filename = (std::filesystem::temp_directory_path() / "mission_queue_hand_off.bin").string();
+    bool commanded = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!commanded && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        m_droneController.dumpFlightRecorder(filename);
+        for (const auto &record : drone_sdk::FlightRecorder::load(filename))
+        {
+            commanded = commanded || (record.kind == drone_sdk::RecordKind::COMMAND &&
+                                      record.code == static_cast<std::uint8_t>(drone_sdk::RecordedCommand::GOTO) &&
+                                      record.location == drone_sdk::Location(1, 3, 10));
+        }
+    }
+    std::remove(filename.c_str());
+    m_droneController.stopMockData();
+
+    EXPECT_TRUE(commanded);
+    EXPECT_EQ(m_droneController.queuedMissions(), 0u);
+    EXPECT_EQ(m_droneController.snapshot().commandStatus, drone_sdk::CommandStatus::BUSY);
+    // The completion reached the subscriber before the start of the next mission
+    EXPECT_EQ(observer.m_lastCommandStatus, drone_sdk::CommandStatus::BUSY);
+}
+
 // Test case to verify that the command goto basic
 //TEST_F(DroneControllerSelfLoadingTest, GoToTest)
 //{
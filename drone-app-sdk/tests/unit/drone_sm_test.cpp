@@ -0,0 +1,290 @@
+#include "state_machines/drone_state_machine.hpp"
+#include "icd.hpp"
+#include "path.hpp"
+
+#include <gtest/gtest.h>
+#include <queue>
+#include <vector>
+
+using namespace drone_sdk;
+using dronestatemachine::DroneStateMachine;
+
+// Test: a GOTO takes off, flies and hovers once the destination is reached
+TEST(DroneStateMachineTest, GotoMission)
+{
+    DroneStateMachine sm;
+    std::vector<FlightState> flight;
+    std::vector<CommandStatus> command;
+    sm.subscribeToFlightState([&flight](FlightTransition transition)
+                              { flight.push_back(transition.to); });
+    sm.subscribeToCommandState([&command](CommandTransition transition)
+                               { command.push_back(transition.to); });
+
+    EXPECT_EQ(sm.handleTaskAssigned(CurrentMission::GOTO, Location{1.0, 1.0, 10.0}), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::BUSY);
+    EXPECT_EQ(sm.getFlightState(), FlightState::AIRBORNE);
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+    EXPECT_EQ(sm.getFlightState(), FlightState::HOVER);
+
+    EXPECT_EQ(flight, (std::vector<FlightState>{FlightState::TAKEOFF, FlightState::AIRBORNE, FlightState::HOVER}));
+    EXPECT_EQ(command, (std::vector<CommandStatus>{CommandStatus::BUSY, CommandStatus::IDLE}));
+
+    // Further samples at the destination change nothing
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    EXPECT_EQ(command.size(), 2u);
+}
+
+// Test: one GPS loss aborts the mission and lands the drone within the same event
+TEST(DroneStateMachineTest, SafetyLossAbortsAndLands)
+{
+    DroneStateMachine sm;
+    sm.setHomebase({0.0, 0.0, 5.0});
+    sm.handleTaskAssigned(CurrentMission::GOTO, Location{1.0, 1.0, 10.0});
+    sm.handleGpsLocationUpdate({0.5, 0.5, 10.0});
+
+    sm.handleGpsSignal(SignalQuality::NO_SIGNAL);
+    EXPECT_EQ(sm.getGpsState(), safetyState::GPS_NOT_HEALTHY);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::MISSION_ABORT);
+    EXPECT_EQ(sm.getFlightState(), FlightState::EMERGENCY_LAND);
+
+    // The drone heads down where it was, at the home altitude, and reaching it ends the abort
+    sm.handleGpsLocationUpdate({0.5, 0.5, 10.0});
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::MISSION_ABORT);
+    sm.handleGpsLocationUpdate({0.5, 0.5, 5.0});
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+}
+
+// Test: a safety loss while idle only changes the safety state
+TEST(DroneStateMachineTest, SafetyLossWhileIdle)
+{
+    DroneStateMachine sm;
+    int linkUpdates = 0;
+    sm.subscribeToLinkState([&linkUpdates](SafetyTransition)
+                            { ++linkUpdates; });
+
+    sm.handleLinkSignal(SignalQuality::NO_SIGNAL);
+    sm.handleLinkSignal(SignalQuality::NO_SIGNAL);
+    EXPECT_EQ(sm.getLinkState(), safetyState::NOT_CONNECTED);
+    EXPECT_EQ(linkUpdates, 1);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+    EXPECT_EQ(sm.getFlightState(), FlightState::LANDED);
+
+    sm.handleGeofence(true);
+    EXPECT_EQ(sm.getGeofenceState(), safetyState::GEOFENCE_VIOLATED);
+    sm.handleGeofence(false);
+    EXPECT_EQ(sm.getGeofenceState(), safetyState::GEOFENCE_CLEAR);
+}
+
+// Test: a PATH reports each waypoint and can only be edited while it runs
+TEST(DroneStateMachineTest, PathMission)
+{
+    DroneStateMachine sm;
+    std::vector<Location> waypoints;
+    sm.subscribeToPathWaypoint([&waypoints](Location waypoint)
+                               { waypoints.push_back(waypoint); });
+
+    std::queue<Location> path;
+    path.push({1.0, 1.0, 10.0});
+    path.push({2.0, 2.0, 10.0});
+    ASSERT_EQ(sm.handleTaskAssigned(CurrentMission::PATH, std::nullopt, path), FlightControllerStatus::SUCCESS);
+
+    const Location extra{3.0, 3.0, 10.0};
+    EXPECT_EQ(sm.appendWaypoints({&extra, 1}), FlightControllerStatus::SUCCESS);
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    sm.handleGpsLocationUpdate({2.0, 2.0, 10.0});
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::BUSY);
+    sm.handleGpsLocationUpdate(extra);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+    EXPECT_EQ(waypoints.size(), 3u);
+
+    EXPECT_EQ(sm.appendWaypoints({&extra, 1}), FlightControllerStatus::INVALID_COMMAND);
+}
+
+// Test: subscribers get each real transition once, with the state it left
+TEST(DroneStateMachineTest, NotifiesTransitionsOnly)
+{
+    DroneStateMachine sm;
+    std::vector<FlightTransition> flight;
+    sm.subscribeToFlightState([&flight](FlightTransition transition)
+                              { flight.push_back(transition); });
+
+    // Healthy samples change nothing
+    for (int i = 0; i < 100; ++i)
+    {
+        sm.handleGpsSignal(SignalQuality::GOOD);
+        sm.handleLinkSignal(SignalQuality::EXCELLENT);
+    }
+    EXPECT_TRUE(flight.empty());
+    EXPECT_EQ(sm.suppressedEvents(), 200u);
+
+    sm.handleTaskAssigned(CurrentMission::GOTO, Location{1.0, 1.0, 10.0});
+    sm.handleTaskAssigned(CurrentMission::GOTO, Location{2.0, 2.0, 10.0});
+    ASSERT_EQ(flight.size(), 2u);
+    EXPECT_EQ(flight[0].from, FlightState::LANDED);
+    EXPECT_EQ(flight[0].to, FlightState::TAKEOFF);
+    EXPECT_EQ(flight[1].from, FlightState::TAKEOFF);
+    EXPECT_EQ(flight[1].to, FlightState::AIRBORNE);
+    EXPECT_LE(flight[0].timestamp, flight[1].timestamp);
+
+    // The second GOTO re-entered AIRBORNE and BUSY, nothing to report
+    EXPECT_EQ(sm.suppressedEvents(), 202u);
+}
+
+// Test: a GOTO completes on a GPS fix inside the arrival radius, not only on an exact match
+TEST(DroneStateMachineTest, GotoArrivesWithinRadius)
+{
+    DroneStateMachine sm;
+    sm.setArrivalRadius(3.0);
+    ASSERT_EQ(sm.handleTaskAssigned(CurrentMission::GOTO, Location{32.0, 34.0, 50.0}), FlightControllerStatus::SUCCESS);
+
+    sm.handleGpsLocationUpdate({32.0001, 34.0, 50.0}); // About 11 m short
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::BUSY);
+
+    sm.handleGpsLocationUpdate({32.00001, 34.00001, 50.8}); // About 1.7 m off
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+}
+
+// Test: a PATH handed over as a Path is flown waypoint by waypoint until the mission completes
+TEST(DroneStateMachineTest, PathMissionConsumesWaypoints)
+{
+    DroneStateMachine sm;
+    std::vector<Location> waypoints;
+    std::vector<Location> destinations;
+    sm.subscribeToPathWaypoint([&waypoints](Location waypoint)
+                               { waypoints.push_back(waypoint); });
+    sm.subscribeToCurrentDestination([&destinations](Location destination)
+                                     { destinations.push_back(destination); });
+
+    ASSERT_EQ(sm.handlePathAssigned(Path{{1.0, 1.0, 10.0}, {2.0, 2.0, 10.0}, {3.0, 3.0, 10.0}}), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::BUSY);
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    sm.handleGpsLocationUpdate({2.0, 2.0, 10.0});
+    EXPECT_EQ(destinations, (std::vector<Location>{{2.0, 2.0, 10.0}, {3.0, 3.0, 10.0}}));
+
+    sm.handleGpsLocationUpdate({3.0, 3.0, 10.0});
+    EXPECT_EQ(waypoints, (std::vector<Location>{{1.0, 1.0, 10.0}, {2.0, 2.0, 10.0}, {3.0, 3.0, 10.0}}));
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+}
+
+// Test: an empty path is rejected without starting a mission, through either API
+TEST(DroneStateMachineTest, EmptyPathRejected)
+{
+    DroneStateMachine sm;
+
+    EXPECT_EQ(sm.handlePathAssigned(Path{}), FlightControllerStatus::INVALID_COMMAND);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+    EXPECT_EQ(sm.getFlightState(), FlightState::LANDED);
+
+    EXPECT_EQ(sm.handleTaskAssigned(CurrentMission::PATH, std::nullopt, std::queue<Location>{}), FlightControllerStatus::INVALID_COMMAND);
+}
+
+// Test: the queue API drives a PATH mission the same way
+TEST(DroneStateMachineTest, QueuePathMission)
+{
+    DroneStateMachine sm;
+    std::vector<Location> destinations;
+    sm.subscribeToCurrentDestination([&destinations](Location destination)
+                                     { destinations.push_back(destination); });
+
+    std::queue<Location> path;
+    path.push({1.0, 1.0, 10.0});
+    path.push({2.0, 2.0, 10.0});
+    ASSERT_EQ(sm.handleTaskAssigned(CurrentMission::PATH, std::nullopt, path), FlightControllerStatus::SUCCESS);
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    EXPECT_EQ(destinations, (std::vector<Location>{{2.0, 2.0, 10.0}}));
+}
+
+// Test: a routed path flies only the route but still reports every waypoint it passes
+TEST(DroneStateMachineTest, RoutedPathReportsSkippedWaypoints)
+{
+    DroneStateMachine sm;
+    std::vector<Location> waypoints;
+    std::vector<Location> destinations;
+    sm.subscribeToPathWaypoint([&waypoints](Location waypoint)
+                               { waypoints.push_back(waypoint); });
+    sm.subscribeToCurrentDestination([&destinations](Location destination)
+                                     { destinations.push_back(destination); });
+
+    Path path{{1.0, 1.0, 10.0}, {1.5, 1.5, 10.0}, {2.0, 2.0, 10.0}, {3.0, 3.0, 10.0}};
+    path.setRoute({0, 2, 3});
+    ASSERT_EQ(sm.handlePathAssigned(std::move(path)), FlightControllerStatus::SUCCESS);
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    EXPECT_EQ(waypoints.size(), 1u);
+    EXPECT_EQ(destinations, (std::vector<Location>{{2.0, 2.0, 10.0}}));
+
+    sm.handleGpsLocationUpdate({2.0, 2.0, 10.0});
+    EXPECT_EQ(waypoints, (std::vector<Location>{{1.0, 1.0, 10.0}, {1.5, 1.5, 10.0}, {2.0, 2.0, 10.0}}));
+    EXPECT_EQ(destinations.back(), Location(3.0, 3.0, 10.0));
+
+    sm.handleGpsLocationUpdate({3.0, 3.0, 10.0});
+    EXPECT_EQ(waypoints.size(), 4u);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+}
+
+// Test: the running path can be extended, replaced and cut without restarting the mission
+TEST(DroneStateMachineTest, EditRunningPath)
+{
+    DroneStateMachine sm;
+    int commandUpdates = 0;
+    std::vector<Location> waypoints;
+    std::vector<Location> destinations;
+    sm.subscribeToCommandState([&commandUpdates](CommandTransition)
+                               { ++commandUpdates; });
+    sm.subscribeToPathWaypoint([&waypoints](Location waypoint)
+                               { waypoints.push_back(waypoint); });
+    sm.subscribeToCurrentDestination([&destinations](Location destination)
+                                     { destinations.push_back(destination); });
+
+    const std::vector<Location> more{{3.0, 3.0, 10.0}, {4.0, 4.0, 10.0}};
+    EXPECT_EQ(sm.appendWaypoints(more), FlightControllerStatus::INVALID_COMMAND); // No PATH mission
+
+    ASSERT_EQ(sm.handlePathAssigned(Path{{1.0, 1.0, 10.0}, {2.0, 2.0, 10.0}}), FlightControllerStatus::SUCCESS);
+    const int commandChanges = commandUpdates;
+
+    EXPECT_EQ(sm.appendWaypoints(more), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(sm.replaceRemaining(0, more), FlightControllerStatus::INVALID_COMMAND); // Already reached
+    const std::vector<Location> detour{{5.0, 5.0, 10.0}};
+    EXPECT_EQ(sm.replaceRemaining(3, detour), FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(sm.getPath().waypoints().size(), 4u);
+
+    // Nothing signalled, nothing redirected
+    EXPECT_EQ(commandUpdates, commandChanges);
+    EXPECT_TRUE(destinations.empty());
+
+    sm.handleGpsLocationUpdate({1.0, 1.0, 10.0});
+    sm.handleGpsLocationUpdate({2.0, 2.0, 10.0});
+    EXPECT_EQ(destinations.back(), Location(3.0, 3.0, 10.0));
+    EXPECT_EQ(sm.truncatePath(3), FlightControllerStatus::SUCCESS);
+
+    sm.handleGpsLocationUpdate({3.0, 3.0, 10.0});
+    EXPECT_EQ(waypoints.size(), 3u);
+    EXPECT_EQ(sm.getCommandState(), CommandStatus::IDLE);
+    EXPECT_EQ(sm.appendWaypoints(more), FlightControllerStatus::INVALID_COMMAND); // Mission over
+}
+
+// Test: the geofence region breaches and clears on its own, reporting each change once
+TEST(DroneStateMachineTest, GeofenceBreachAndClear)
+{
+    DroneStateMachine sm;
+    std::vector<safetyState> changes;
+    sm.subscribeToGeofenceState([&changes](SafetyTransition transition)
+                                { changes.push_back(transition.to); });
+    EXPECT_EQ(sm.getGeofenceState(), safetyState::GEOFENCE_CLEAR);
+
+    sm.handleGeofence(false);
+    sm.handleGeofence(true);
+    sm.handleGeofence(true);
+    EXPECT_EQ(sm.getGeofenceState(), safetyState::GEOFENCE_VIOLATED);
+    EXPECT_EQ(sm.getGpsState(), safetyState::GPS_HEALTH); // Other regions untouched
+    EXPECT_EQ(sm.getLinkState(), safetyState::CONNECTED);
+
+    sm.handleGeofence(false);
+    EXPECT_EQ(sm.getGeofenceState(), safetyState::GEOFENCE_CLEAR);
+    EXPECT_EQ(changes, (std::vector<safetyState>{safetyState::GEOFENCE_VIOLATED, safetyState::GEOFENCE_CLEAR}));
+}
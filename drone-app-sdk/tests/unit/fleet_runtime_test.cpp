@@ -0,0 +1,204 @@
+#include "fleet_runtime.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Poll until a condition holds or the timeout expires
+    template <typename Predicate>
+    bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = 2000ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+}
+
+class FleetRuntimeTest : public ::testing::Test
+{
+protected:
+    FleetRuntime runtime{2};
+};
+
+// Test: the worker pool has the requested size
+TEST_F(FleetRuntimeTest, WorkerCount)
+{
+    EXPECT_EQ(runtime.workerCount(), 2u);
+    EXPECT_EQ(runtime.taskCount(), 0u);
+}
+
+// Test: a periodic task runs on its deadline grid and records the ticks
+TEST_F(FleetRuntimeTest, PeriodicTaskRuns)
+{
+    DeadlineScheduler scheduler(10ms);
+    scheduler.reset(FleetRuntime::Clock::now());
+    std::atomic<int> runs{0};
+
+    const auto id = runtime.schedulePeriodic(scheduler, [&runs]()
+                                             { ++runs; });
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs >= 5; }));
+    runtime.cancel(id);
+
+    EXPECT_GE(scheduler.stats().ticks, 5u);
+    EXPECT_EQ(runtime.taskCount(), 0u);
+}
+
+// Test: a periodic task never fires before its deadline
+TEST_F(FleetRuntimeTest, PeriodicTaskWaitsForDeadline)
+{
+    DeadlineScheduler scheduler(1s);
+    const auto start = FleetRuntime::Clock::now() + 200ms;
+    scheduler.reset(start);
+    std::atomic<bool> early{false};
+    std::atomic<int> runs{0};
+
+    const auto id = runtime.schedulePeriodic(scheduler, [&]()
+                                             {
+        early = early || FleetRuntime::Clock::now() < start;
+        ++runs; });
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs >= 1; }));
+    runtime.cancel(id);
+
+    EXPECT_FALSE(early);
+    EXPECT_EQ(runs, 1);
+}
+
+// Test: a triggered task runs once per trigger
+TEST_F(FleetRuntimeTest, TriggeredTaskRuns)
+{
+    std::atomic<int> runs{0};
+    const auto id = runtime.registerTriggered([&runs]()
+                                              { ++runs; });
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(runs, 0);
+
+    runtime.trigger(id);
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs == 1; }));
+    runtime.trigger(id);
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs == 2; }));
+    runtime.cancel(id);
+}
+
+// Test: a trigger that arrives while the task runs causes exactly one more run
+TEST_F(FleetRuntimeTest, TriggerWhileRunningReruns)
+{
+    std::atomic<int> runs{0};
+    std::atomic<bool> release{false};
+    const auto id = runtime.registerTriggered([&]()
+                                              {
+        ++runs;
+        while (runs == 1 && !release) {
+            std::this_thread::yield();
+        } });
+
+    runtime.trigger(id);
+    ASSERT_TRUE(waitFor([&runs]()
+                        { return runs == 1; }));
+    runtime.trigger(id);
+    runtime.trigger(id);
+    runtime.trigger(id);
+    release = true;
+
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs == 2; }));
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(runs, 2);
+    runtime.cancel(id);
+}
+
+// Test: a task never runs on two workers at once
+TEST_F(FleetRuntimeTest, TaskDoesNotOverlapItself)
+{
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+    std::atomic<int> runs{0};
+    const auto id = runtime.registerTriggered([&]()
+                                              {
+        const int now = ++active;
+        maxActive = std::max(maxActive.load(), now);
+        std::this_thread::sleep_for(1ms);
+        --active;
+        ++runs; });
+
+    for (int i = 0; i < 200; ++i)
+    {
+        runtime.trigger(id);
+    }
+    EXPECT_TRUE(waitFor([&runs]()
+                        { return runs >= 1; }));
+    runtime.cancel(id);
+
+    EXPECT_EQ(maxActive, 1);
+}
+
+// Test: after cancel() returns the task does not run anymore
+TEST_F(FleetRuntimeTest, CancelStopsTask)
+{
+    DeadlineScheduler scheduler(2ms);
+    scheduler.reset(FleetRuntime::Clock::now());
+    std::atomic<int> runs{0};
+
+    const auto id = runtime.schedulePeriodic(scheduler, [&runs]()
+                                             { ++runs; });
+    ASSERT_TRUE(waitFor([&runs]()
+                        { return runs >= 2; }));
+    runtime.cancel(id);
+
+    const int afterCancel = runs;
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(runs, afterCancel);
+}
+
+// Test: many periodic tasks share a small pool
+TEST_F(FleetRuntimeTest, ManyTasksShareThePool)
+{
+    constexpr int kTasks = 100;
+    std::vector<std::unique_ptr<DeadlineScheduler>> schedulers;
+    std::vector<std::atomic<int>> runs(kTasks);
+    std::vector<FleetRuntime::TaskId> ids;
+
+    const auto start = FleetRuntime::Clock::now();
+    for (int i = 0; i < kTasks; ++i)
+    {
+        schedulers.push_back(std::make_unique<DeadlineScheduler>(20ms));
+        schedulers.back()->reset(start);
+        ids.push_back(runtime.schedulePeriodic(*schedulers.back(), [&runs, i]()
+                                               { ++runs[static_cast<std::size_t>(i)]; }));
+    }
+    EXPECT_EQ(runtime.taskCount(), static_cast<std::size_t>(kTasks));
+
+    EXPECT_TRUE(waitFor([&runs]()
+                        {
+        for (const auto &count : runs) {
+            if (count < 3) {
+                return false;
+            }
+        }
+        return true; }));
+
+    for (auto id : ids)
+    {
+        runtime.cancel(id);
+    }
+    EXPECT_EQ(runtime.taskCount(), 0u);
+}
@@ -0,0 +1,86 @@
+#include "flight_controller_handler.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+using drone_sdk::FlightControllerStatus;
+using drone_sdk::Location;
+
+namespace
+{
+    // Stands in for hw_sdk_mock::FlightController and records what the handler sends
+    struct RecordingFlightController
+    {
+        using ResponseCode = hw_sdk_mock::FlightController::ResponseCode;
+
+        struct GoTo
+        {
+            double latitude;
+            double longitude;
+            double altitude;
+        };
+
+        // The handler owns its controller, so the calls are kept where the test can see them
+        inline static std::vector<std::string> commands;
+        inline static std::optional<GoTo> lastGoTo;
+
+        ResponseCode arm() { return sent("arm"); }
+        ResponseCode disarm() { return sent("disarm"); }
+        ResponseCode takeOff() { return sent("takeOff"); }
+        ResponseCode land() { return sent("land"); }
+        ResponseCode goHome() { return sent("goHome"); }
+
+        ResponseCode goTo(double latitude, double longitude, double altitude)
+        {
+            lastGoTo = GoTo{latitude, longitude, altitude};
+            return sent("goTo");
+        }
+
+    private:
+        static ResponseCode sent(const std::string &command)
+        {
+            commands.push_back(command);
+            return ResponseCode::SUCCESS;
+        }
+    };
+
+    class FlightControllerHandlerTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            RecordingFlightController::commands.clear();
+            RecordingFlightController::lastGoTo.reset();
+        }
+
+        BasicFlightControllerHandler<RecordingFlightController> handler;
+        std::optional<FlightControllerStatus> status;
+
+        BasicFlightControllerHandler<RecordingFlightController>::Done recordStatus()
+        {
+            return [this](FlightControllerStatus result) { status = result; };
+        }
+    };
+}
+
+TEST_F(FlightControllerHandlerTest, GoToSendsLatitudeLongitudeAltitude)
+{
+    handler.goTo(Location(32.08, 34.78, 120.0), recordStatus());
+
+    ASSERT_TRUE(RecordingFlightController::lastGoTo.has_value());
+    EXPECT_DOUBLE_EQ(RecordingFlightController::lastGoTo->latitude, 32.08);
+    EXPECT_DOUBLE_EQ(RecordingFlightController::lastGoTo->longitude, 34.78);
+    EXPECT_DOUBLE_EQ(RecordingFlightController::lastGoTo->altitude, 120.0);
+    EXPECT_EQ(status, FlightControllerStatus::SUCCESS);
+}
+
+TEST_F(FlightControllerHandlerTest, TakeOffSendsNoTarget)
+{
+    handler.takeOff(Location(32.08, 34.78, 120.0), recordStatus());
+
+    EXPECT_EQ(RecordingFlightController::commands, std::vector<std::string>{"takeOff"});
+    EXPECT_FALSE(RecordingFlightController::lastGoTo.has_value());
+    EXPECT_EQ(status, FlightControllerStatus::SUCCESS);
+}
@@ -0,0 +1,229 @@
+#include "flight_recorder.hpp"
+#include "state_machines/drone_state_machine.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace drone_sdk;
+using dronestatemachine::DroneStateMachine;
+
+class FlightRecorderTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path directory;
+
+    void SetUp() override
+    {
+        const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        directory = std::filesystem::temp_directory_path() / (std::string("flight_recorder_") + info->name());
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    // Waits for the recorder thread to write @p count dumps
+    static bool waitForDumps(const FlightRecorder &recorder, std::uint64_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (recorder.dumps() < count)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+// Test: the capacity is rounded up and 0 is refused
+TEST_F(FlightRecorderTest, Capacity)
+{
+    EXPECT_EQ(FlightRecorder(1000).capacity(), 1024u);
+    EXPECT_EQ(FlightRecorder(64).capacity(), 64u);
+    EXPECT_THROW(FlightRecorder(0), std::invalid_argument);
+}
+
+// Test: once the ring wraps only the newest records are kept, oldest first, with monotonic timestamps
+TEST_F(FlightRecorderTest, KeepsNewestRecords)
+{
+    FlightRecorder recorder(64);
+    for (int i = 0; i < 100; ++i)
+    {
+        recorder.recordGpsSample(Location(i, 0.0, 10.0), SignalQuality::GOOD);
+    }
+
+    std::uint64_t dropped = 0;
+    const auto records = recorder.snapshot(&dropped);
+
+    EXPECT_EQ(recorder.recorded(), 100u);
+    EXPECT_EQ(dropped, 36u);
+    ASSERT_EQ(records.size(), 64u);
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].kind, RecordKind::GPS_SAMPLE);
+        EXPECT_EQ(records[i].from, static_cast<std::uint8_t>(SignalQuality::GOOD));
+        EXPECT_EQ(records[i].location.latitude, static_cast<double>(36 + i));
+        if (i > 0)
+        {
+            EXPECT_GE(records[i].timestamp, records[i - 1].timestamp);
+        }
+    }
+}
+
+// Test: records of concurrent threads are never torn
+TEST_F(FlightRecorderTest, ConcurrentRecording)
+{
+    constexpr int kThreads = 4;
+    constexpr int kRecords = 20000;
+    FlightRecorder recorder(1024);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&recorder, t]()
+                             {
+                                 for (int i = 0; i < kRecords; ++i)
+                                 {
+                                     const double value = t * kRecords + i;
+                                     recorder.recordCommand(RecordedCommand::GOTO, FlightControllerStatus::SUCCESS,
+                                                            Location(value, value, value));
+                                 } });
+    }
+    // Snapshots taken while the ring is being written skip the slots in progress
+    for (int i = 0; i < 50; ++i)
+    {
+        for (const auto &record : recorder.snapshot())
+        {
+            EXPECT_EQ(record.location.latitude, record.location.longitude);
+            EXPECT_EQ(record.location.latitude, record.location.altitude);
+        }
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(recorder.recorded(), static_cast<std::uint64_t>(kThreads * kRecords));
+    EXPECT_EQ(recorder.snapshot().size(), 1024u);
+}
+
+// Test: a dump reads back as the records it was taken from
+TEST_F(FlightRecorderTest, DumpRoundTrip)
+{
+    FlightRecorder recorder(16);
+    recorder.recordEvent(RecordedEvent::TASK_ASSIGNED, 0);
+    recorder.recordTransition(StateRegion::COMMAND, CommandStatus::IDLE, CommandStatus::BUSY);
+    recorder.recordLinkSample(SignalQuality::POOR);
+    recorder.recordCommand(RecordedCommand::TAKEOFF, FlightControllerStatus::HARDWARE_ERROR, Location(1.0, 2.0, 3.0));
+    const std::string filename = (directory / "dump.bin").string();
+
+    recorder.dump(filename);
+    const auto loaded = FlightRecorder::load(filename);
+    const auto records = recorder.snapshot();
+
+    ASSERT_EQ(loaded.size(), 4u);
+    for (std::size_t i = 0; i < loaded.size(); ++i)
+    {
+        EXPECT_EQ(loaded[i].timestamp, records[i].timestamp);
+        EXPECT_EQ(loaded[i].kind, records[i].kind);
+        EXPECT_EQ(loaded[i].code, records[i].code);
+        EXPECT_EQ(loaded[i].from, records[i].from);
+        EXPECT_EQ(loaded[i].to, records[i].to);
+        EXPECT_EQ(loaded[i].location, records[i].location);
+    }
+    EXPECT_EQ(loaded[1].to, static_cast<std::uint8_t>(CommandStatus::BUSY));
+    EXPECT_EQ(loaded[3].location, Location(1.0, 2.0, 3.0));
+}
+
+// Test: missing and foreign files are refused
+TEST_F(FlightRecorderTest, InvalidFiles)
+{
+    EXPECT_THROW(FlightRecorder::load((directory / "missing.bin").string()), std::runtime_error);
+    EXPECT_THROW(FlightRecorder(16).dump((directory / "missing" / "dump.bin").string()), std::runtime_error);
+
+    const std::string filename = (directory / "foreign.bin").string();
+    std::FILE *file = std::fopen(filename.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a flight recorder dump, just text long enough", file);
+    std::fclose(file);
+    EXPECT_THROW(FlightRecorder::load(filename), std::runtime_error);
+}
+
+// Test: the state machine records its events and transitions, and an abort dumps them to a new file
+TEST_F(FlightRecorderTest, DumpOnAbort)
+{
+    FlightRecorder recorder;
+    recorder.setDumpDirectory(directory.string());
+    DroneStateMachine sm;
+    sm.setRecorder(&recorder);
+    sm.subscribeToCommandState([&recorder](CommandTransition transition)
+                               {
+                                   if (transition.to == CommandStatus::MISSION_ABORT)
+                                   {
+                                       recorder.requestDump();
+                                   } });
+
+    sm.handleTaskAssigned(CurrentMission::GOTO, Location{1.0, 1.0, 10.0});
+    sm.handleGpsSignal(SignalQuality::GOOD);
+    EXPECT_EQ(recorder.dumps(), 0u);
+    sm.handleGpsSignal(SignalQuality::NO_SIGNAL);
+
+    ASSERT_TRUE(waitForDumps(recorder, 1));
+    const std::string filename = recorder.lastDump();
+    EXPECT_EQ(std::filesystem::path(filename).parent_path(), directory);
+    const auto records = FlightRecorder::load(filename);
+
+    // The dump ends with the loss of the GPS and the transitions it caused up to the abort. The
+    // GPS transition is recorded after the abort is notified, so it may come too late for it.
+    std::size_t end = records.size();
+    if (end > 0 && records[end - 1].kind == RecordKind::TRANSITION &&
+        records[end - 1].code == static_cast<std::uint8_t>(StateRegion::GPS))
+    {
+        EXPECT_EQ(records[end - 1].to, static_cast<std::uint8_t>(safetyState::GPS_NOT_HEALTHY));
+        --end;
+    }
+    ASSERT_GE(end, 3u);
+    const auto *loss = &records[end - 3];
+    EXPECT_EQ(loss[0].kind, RecordKind::EVENT);
+    EXPECT_EQ(loss[0].code, static_cast<std::uint8_t>(RecordedEvent::GPS_SIGNAL));
+    EXPECT_EQ(loss[0].from, static_cast<std::uint8_t>(SignalQuality::NO_SIGNAL));
+    EXPECT_EQ(loss[1].kind, RecordKind::TRANSITION);
+    EXPECT_EQ(loss[1].code, static_cast<std::uint8_t>(StateRegion::FLIGHT));
+    EXPECT_EQ(loss[1].to, static_cast<std::uint8_t>(FlightState::EMERGENCY_LAND));
+    EXPECT_EQ(loss[2].code, static_cast<std::uint8_t>(StateRegion::COMMAND));
+    EXPECT_EQ(loss[2].from, static_cast<std::uint8_t>(CommandStatus::BUSY));
+    EXPECT_EQ(loss[2].to, static_cast<std::uint8_t>(CommandStatus::MISSION_ABORT));
+    EXPECT_EQ(records.front().code, static_cast<std::uint8_t>(RecordedEvent::TASK_ASSIGNED));
+}
+
+// Test: drones aborting at the same moment dump to files of their own
+TEST_F(FlightRecorderTest, ConcurrentDumpsDoNotCollide)
+{
+    FlightRecorder first(16);
+    FlightRecorder second(16);
+    first.setDumpDirectory(directory.string());
+    second.setDumpDirectory(directory.string());
+    first.recordEvent(RecordedEvent::TASK_ASSIGNED, 1);
+    second.recordEvent(RecordedEvent::TASK_ASSIGNED, 2);
+
+    first.requestDump();
+    second.requestDump();
+
+    ASSERT_TRUE(waitForDumps(first, 1));
+    ASSERT_TRUE(waitForDumps(second, 1));
+    EXPECT_NE(first.lastDump(), second.lastDump());
+    EXPECT_EQ(FlightRecorder::load(first.lastDump()).front().from, 1u);
+    EXPECT_EQ(FlightRecorder::load(second.lastDump()).front().from, 2u);
+}
@@ -0,0 +1,76 @@
+#include "geo.hpp"
+
+#include <gtest/gtest.h>
+
+using drone_sdk::Location;
+using namespace drone_sdk::geo;
+
+// Test: one degree of latitude is about 111 km everywhere
+TEST(GeoTest, HaversineDegreeOfLatitude)
+{
+    EXPECT_NEAR(haversineDistance({0, 0, 0}, {1, 0, 0}), 111195.0, 1.0);
+    EXPECT_NEAR(haversineDistance({60, 10, 0}, {61, 10, 0}), 111195.0, 1.0);
+}
+
+// Test: a degree of longitude shrinks with the cosine of the latitude
+TEST(GeoTest, HaversineDegreeOfLongitude)
+{
+    EXPECT_NEAR(haversineDistance({60, 10, 0}, {60, 11, 0}), 55597.0, 50.0);
+}
+
+// Test: long range distance (Tel Aviv to London, about 3570 km)
+TEST(GeoTest, HaversineLongRange)
+{
+    EXPECT_NEAR(haversineDistance({32.0853, 34.7818, 0}, {51.5074, -0.1278, 0}), 3570000.0, 15000.0);
+}
+
+// Test: crossing the antimeridian takes the short way round
+TEST(GeoTest, Antimeridian)
+{
+    EXPECT_NEAR(haversineDistance({0, 179.9999, 0}, {0, -179.9999, 0}), 22.2, 0.1);
+
+    ArrivalDetector detector(30.0);
+    detector.setTarget({0, 179.9999, 0});
+    EXPECT_TRUE(detector.arrived({0, -179.9999, 0}));
+}
+
+// Test: the 3D distance includes the altitude difference
+TEST(GeoTest, Distance3d)
+{
+    EXPECT_NEAR(distance({10, 20, 100}, {10, 20, 130}), 30.0, 1e-9);
+}
+
+// Test: arrival triggers inside the radius and not outside, in every axis
+TEST(GeoTest, ArrivalRadius)
+{
+    ArrivalDetector detector(2.0);
+    const Location target{32.0, 34.0, 50.0};
+    detector.setTarget(target);
+
+    const double degreeLatitude = 1.0 / kMetersPerDegree; // One meter north
+
+    EXPECT_TRUE(detector.arrived(target));
+    EXPECT_TRUE(detector.arrived({32.0 + 1.5 * degreeLatitude, 34.0, 50.0}));
+    EXPECT_FALSE(detector.arrived({32.0 + 2.5 * degreeLatitude, 34.0, 50.0}));
+    EXPECT_TRUE(detector.arrived({32.0, 34.0, 51.9}));
+    EXPECT_FALSE(detector.arrived({32.0, 34.0, 52.1}));
+    EXPECT_FALSE(detector.arrived({32.0 + 1.5 * degreeLatitude, 34.0, 51.5})); // Inside on each axis, outside in 3D
+
+    const double degreeLongitude = degreeLatitude / std::cos(32.0 * kRadiansPerDegree);
+    EXPECT_TRUE(detector.arrived({32.0, 34.0 + 1.5 * degreeLongitude, 50.0}));
+    EXPECT_FALSE(detector.arrived({32.0, 34.0 + 2.5 * degreeLongitude, 50.0}));
+}
+
+// Test: the near range approximation agrees with haversine, the far range uses it
+TEST(GeoTest, DistanceToMatchesHaversine)
+{
+    ArrivalDetector detector;
+    const Location target{45.0, 7.0, 0.0};
+    detector.setTarget(target);
+
+    const Location near{45.01, 7.01, 0.0};
+    EXPECT_NEAR(detector.distanceTo(near), haversineDistance(near, target), 1.0);
+
+    const Location far{46.0, 9.0, 0.0};
+    EXPECT_DOUBLE_EQ(detector.distanceTo(far), distance(far, target));
+}
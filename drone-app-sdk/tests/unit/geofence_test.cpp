@@ -0,0 +1,124 @@
+#include "geofence.hpp"
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using drone_sdk::Geofence;
+using drone_sdk::GeofenceZone;
+using drone_sdk::Location;
+
+namespace
+{
+    // Axis aligned square zone, corners in degrees
+    GeofenceZone square(double south, double west, double north, double east,
+                        double floorMeters = -1.0e9, double ceilingMeters = 1.0e9)
+    {
+        return {{{south, west, 0.0}, {north, west, 0.0}, {north, east, 0.0}, {south, east, 0.0}}, floorMeters, ceilingMeters};
+    }
+}
+
+// Test: points inside, outside, and in the altitude band of a zone
+TEST(GeofenceTest, PointQueries)
+{
+    Geofence geofence;
+    geofence.addNoFlyZone(square(32.00, 34.00, 32.05, 34.05, 0.0, 300.0));
+
+    EXPECT_TRUE(geofence.violates(Location{32.025, 34.025, 100.0}));  // Deep inside, a fully covered cell
+    EXPECT_TRUE(geofence.violates(Location{32.0001, 34.0001, 100.0})); // Near the boundary
+    EXPECT_FALSE(geofence.violates(Location{31.9999, 34.0001, 100.0}));
+    EXPECT_FALSE(geofence.violates(Location{32.025, 34.025, 350.0}));  // Above the zone
+    EXPECT_FALSE(geofence.violates(Location{10.0, 10.0, 100.0}));
+}
+
+// Test: a concave zone does not cover its notch
+TEST(GeofenceTest, ConcaveZone)
+{
+    Geofence geofence(0.005);
+    // U shape opening to the north, notch between longitudes 34.01 and 34.02
+    geofence.addNoFlyZone({{{32.00, 34.00, 0}, {32.03, 34.00, 0}, {32.03, 34.01, 0}, {32.01, 34.01, 0},
+                            {32.01, 34.02, 0}, {32.03, 34.02, 0}, {32.03, 34.03, 0}, {32.00, 34.03, 0}}});
+
+    EXPECT_TRUE(geofence.violates(Location{32.02, 34.005, 10.0}));
+    EXPECT_FALSE(geofence.violates(Location{32.02, 34.015, 10.0}));
+    EXPECT_TRUE(geofence.violates(Location{32.005, 34.015, 10.0}));
+}
+
+// Test: the altitude ceiling applies everywhere
+TEST(GeofenceTest, AltitudeCeiling)
+{
+    Geofence geofence;
+    geofence.setAltitudeCeiling(120.0);
+
+    EXPECT_FALSE(geofence.violates(Location{1.0, 1.0, 119.0}));
+    EXPECT_TRUE(geofence.violates(Location{1.0, 1.0, 121.0}));
+    EXPECT_TRUE(geofence.violates(Location{1.0, 1.0, 50.0}, Location{1.1, 1.1, 150.0}));
+}
+
+// Test: legs crossing a zone violate it even though both ends are outside
+TEST(GeofenceTest, SegmentQueries)
+{
+    Geofence geofence;
+    geofence.addNoFlyZone(square(32.000, 34.000, 32.001, 34.001, 0.0, 300.0)); // Much smaller than a cell
+
+    EXPECT_TRUE(geofence.violates(Location{31.99, 34.0005, 50.0}, Location{32.01, 34.0005, 50.0}));
+    EXPECT_FALSE(geofence.violates(Location{31.99, 34.002, 50.0}, Location{32.01, 34.002, 50.0}));
+    EXPECT_FALSE(geofence.violates(Location{31.99, 34.0005, 400.0}, Location{32.01, 34.0005, 400.0})); // Over it
+    EXPECT_TRUE(geofence.violates(Location{31.99, 34.0005, 400.0}, Location{32.01, 34.0005, 200.0}));  // Descends into it
+}
+
+// Test: firstViolation reports the waypoint ending the first bad leg
+TEST(GeofenceTest, PathQueries)
+{
+    Geofence geofence;
+    geofence.addNoFlyZone(square(32.00, 34.00, 32.05, 34.05));
+
+    const std::vector<Location> path{{31.90, 33.90, 50.0}, {31.90, 34.10, 50.0}, {32.10, 34.10, 50.0}, {32.10, 33.90, 50.0}, {31.95, 34.10, 50.0}};
+
+    EXPECT_EQ(geofence.firstViolation(path), 4u);
+    EXPECT_EQ(geofence.firstViolation(std::span<const Location>(path).first(4)), std::nullopt);
+    EXPECT_EQ(geofence.firstViolation(path, Location{32.10, 34.04, 50.0}), 0u); // Reaching the start crosses it
+    EXPECT_EQ(geofence.firstViolation({}), std::nullopt);
+}
+
+// Test: from a start that already violates, legs leading out are allowed but not into other zones
+TEST(GeofenceTest, LeavingViolation)
+{
+    Geofence geofence;
+    geofence.addNoFlyZone(square(32.00, 34.00, 32.05, 34.05, 0.0, 300.0));
+    geofence.addNoFlyZone(square(32.00, 34.10, 32.05, 34.15, 0.0, 300.0));
+    geofence.setAltitudeCeiling(120.0);
+    const Location inside{32.025, 34.025, 50.0};
+
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{32.025, 33.90, 50.0}}, inside), std::nullopt); // Straight out
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{32.025, 34.04, 50.0}}, inside), 0u);            // Staying in
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{32.025, 34.20, 50.0}}, inside), 0u);            // Out through the other zone
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{32.025, 33.90, 50.0}, {32.025, 34.07, 50.0}}, inside),
+              1u); // Only the first leg may cross the zone it leaves
+
+    // Above the ceiling, descending below it
+    const Location high{31.90, 33.90, 150.0};
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{31.90, 33.80, 100.0}}, high), std::nullopt);
+    EXPECT_EQ(geofence.firstViolation(std::vector<Location>{{31.90, 33.80, 130.0}}, high), 0u);
+}
+
+// Test: many zones are indexed independently
+TEST(GeofenceTest, ManyZones)
+{
+    Geofence geofence;
+    for (int row = 0; row < 50; ++row)
+    {
+        for (int column = 0; column < 50; ++column)
+        {
+            const double south = 30.0 + row * 0.1;
+            const double west = 30.0 + column * 0.1;
+            geofence.addNoFlyZone(square(south, west, south + 0.02, west + 0.02));
+        }
+    }
+
+    EXPECT_EQ(geofence.zoneCount(), 2500u);
+    EXPECT_TRUE(geofence.violates(Location{32.51, 33.01, 10.0}));
+    EXPECT_FALSE(geofence.violates(Location{32.55, 33.05, 10.0}));
+    EXPECT_THROW(geofence.addNoFlyZone({{{1, 1, 1}, {2, 2, 2}}}), std::invalid_argument);
+}
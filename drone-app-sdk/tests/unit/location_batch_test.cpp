@@ -0,0 +1,117 @@
+#include "location_batch.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using drone_sdk::Location;
+using drone_sdk::LocationBatch;
+namespace batch = drone_sdk::batch;
+namespace geo = drone_sdk::geo;
+
+namespace
+{
+    std::vector<Location> sampleLocations()
+    {
+        return {{32.0, 34.0, 50.0}, {32.01, 34.0, 60.0}, {32.0, 34.01, 40.0}, {31.99, 33.99, 55.0}, {32.005, 34.005, 50.0}};
+    }
+}
+
+// Test: locations round trip through the columns and the columns are aligned
+TEST(LocationBatchTest, TransposesBothWays)
+{
+    const auto locations = sampleLocations();
+    LocationBatch locationBatch(locations);
+
+    ASSERT_EQ(locationBatch.size(), locations.size());
+    EXPECT_EQ(locationBatch.latitudes()[1], 32.01);
+    EXPECT_EQ(locationBatch.altitudes()[2], 40.0);
+    EXPECT_EQ(locationBatch[3], locations[3]);
+    EXPECT_EQ(locationBatch.toLocations(), locations);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(locationBatch.longitudes().data()) % LocationBatch::kAlignment, 0u);
+
+    locationBatch.push_back({1.0, 2.0, 3.0});
+    EXPECT_EQ(locationBatch[5], Location(1.0, 2.0, 3.0));
+
+    std::vector<Location> tooSmall(2);
+    EXPECT_THROW(locationBatch.copyTo(tooSmall), std::invalid_argument);
+
+    locationBatch.clear();
+    EXPECT_TRUE(locationBatch.empty());
+}
+
+// Test: the kernels give the same results on a batch and on a plain array of locations
+TEST(LocationBatchTest, KernelsMatchOnBothLayouts)
+{
+    const auto locations = sampleLocations();
+    const LocationBatch locationBatch(locations);
+    const Location origin{32.0, 34.0, 50.0};
+
+    std::vector<double> fromBatch(locations.size());
+    std::vector<double> fromArray(locations.size());
+    batch::distances(locationBatch.columns(), origin, fromBatch);
+    batch::distances(drone_sdk::columns(locations), origin, fromArray);
+    EXPECT_EQ(fromBatch, fromArray);
+
+    batch::bearings(locationBatch.columns(), origin, fromBatch);
+    batch::bearings(drone_sdk::columns(locations), origin, fromArray);
+    EXPECT_EQ(fromBatch, fromArray);
+}
+
+// Test: distances agree with geo::distance() at mission range, bearings point the right way
+TEST(LocationBatchTest, DistancesAndBearings)
+{
+    const auto locations = sampleLocations();
+    const Location &origin = locations.front();
+    std::vector<double> distances(locations.size());
+    std::vector<double> bearings(locations.size());
+
+    batch::distances(drone_sdk::columns(locations), origin, distances);
+    batch::bearings(drone_sdk::columns(locations), origin, bearings);
+
+    for (std::size_t i = 0; i < locations.size(); ++i)
+    {
+        EXPECT_NEAR(distances[i], geo::distance(origin, locations[i]), 1.0) << i;
+    }
+    EXPECT_NEAR(bearings[1], 0.0, 1e-9);   // North
+    EXPECT_NEAR(bearings[2], 90.0, 1e-9);  // East
+    EXPECT_GT(bearings[3], 180.0);         // South west
+    EXPECT_LT(bearings[3], 270.0);
+
+    std::vector<double> tooSmall(1);
+    EXPECT_THROW(batch::distances(drone_sdk::columns(locations), origin, tooSmall), std::invalid_argument);
+}
+
+// Test: local coordinates fold the longitude across the antimeridian
+TEST(LocationBatchTest, EnuAcrossAntimeridian)
+{
+    const std::vector<Location> locations{{0.0, 179.999, 10.0}, {0.0, -179.999, 20.0}};
+    const Location origin{0.0, 179.999, 0.0};
+    std::vector<double> east(2), north(2), up(2);
+
+    batch::toEnu(drone_sdk::columns(locations), origin, east, north, up);
+
+    EXPECT_DOUBLE_EQ(east[0], 0.0);
+    EXPECT_NEAR(east[1], 0.002 * geo::kMetersPerDegree, 1e-6);
+    EXPECT_DOUBLE_EQ(north[1], 0.0);
+    EXPECT_DOUBLE_EQ(up[1], 20.0);
+}
+
+// Test: the bounding box covers every location, an empty batch gives an empty box
+TEST(LocationBatchTest, Bounds)
+{
+    const LocationBatch locationBatch(sampleLocations());
+
+    const auto box = batch::bounds(locationBatch.columns());
+
+    EXPECT_EQ(box.minLatitude, 31.99);
+    EXPECT_EQ(box.maxLatitude, 32.01);
+    EXPECT_EQ(box.minLongitude, 33.99);
+    EXPECT_EQ(box.maxLongitude, 34.01);
+    EXPECT_EQ(box.minAltitude, 40.0);
+    EXPECT_EQ(box.maxAltitude, 60.0);
+
+    const auto empty = batch::bounds(LocationBatch().columns());
+    EXPECT_GT(empty.minLatitude, empty.maxLatitude);
+}
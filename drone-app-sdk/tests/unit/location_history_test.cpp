@@ -0,0 +1,141 @@
+#include "location_history.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using drone_sdk::Location;
+using drone_sdk::LocationHistory;
+using drone_sdk::LocationSample;
+using namespace std::chrono_literals;
+
+namespace
+{
+    const auto kStart = std::chrono::steady_clock::time_point(1000h);
+
+    // A drone circling at 10 Hz and 10 m/s, climbing slowly
+    std::vector<LocationSample> smoothTrajectory(std::size_t count)
+    {
+        std::vector<LocationSample> samples;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double angle = static_cast<double>(i) * 0.001;
+            samples.push_back({kStart + i * 100ms,
+                               Location(32.0 + 0.01 * std::sin(angle), 34.0 + 0.01 * std::cos(angle),
+                                        50.0 + static_cast<double>(i) * 0.01)});
+        }
+        return samples;
+    }
+
+    std::size_t rawBytes(std::size_t count)
+    {
+        return count * (sizeof(Location) + sizeof(std::chrono::steady_clock::time_point));
+    }
+}
+
+// Test: quantized samples decode within half a step, across block boundaries
+TEST(LocationHistoryTest, QuantizedRoundTrip)
+{
+    LocationHistory::Options options;
+    options.samplesPerBlock = 64;
+    LocationHistory history(options);
+    const auto samples = smoothTrajectory(1000);
+    for (const auto &sample : samples)
+    {
+        history.append(sample.timestamp, sample.location);
+    }
+
+    const auto decoded = history.range(kStart, kStart + 1h);
+
+    ASSERT_EQ(history.size(), samples.size());
+    ASSERT_EQ(decoded.size(), samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        EXPECT_EQ(decoded[i].timestamp, samples[i].timestamp);
+        EXPECT_NEAR(decoded[i].location.latitude, samples[i].location.latitude, 0.5e-7);
+        EXPECT_NEAR(decoded[i].location.longitude, samples[i].location.longitude, 0.5e-7);
+        EXPECT_NEAR(decoded[i].location.altitude, samples[i].location.altitude, 0.005);
+    }
+}
+
+// Test: XOR encoding gives back the exact doubles, also for noisy input
+TEST(LocationHistoryTest, XorIsLossless)
+{
+    LocationHistory::Options options;
+    options.encoding = LocationHistory::Encoding::XOR;
+    options.samplesPerBlock = 100;
+    LocationHistory history(options);
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0.0, 1e-5);
+    std::vector<Location> locations;
+    for (int i = 0; i < 500; ++i)
+    {
+        locations.emplace_back(32.0 + noise(generator), 34.0 + noise(generator), i % 7 == 0 ? 50.0 : 50.0 + noise(generator));
+        history.append(kStart + i * 100ms, locations.back());
+    }
+
+    const auto decoded = history.range(kStart, kStart + 1h);
+
+    ASSERT_EQ(decoded.size(), locations.size());
+    for (std::size_t i = 0; i < locations.size(); ++i)
+    {
+        EXPECT_EQ(decoded[i].location, locations[i]) << i;
+    }
+}
+
+// Test: an hour of smooth flight compresses at least 8 times in the default mode
+TEST(LocationHistoryTest, CompressesSmoothTrajectory)
+{
+    LocationHistory history;
+    const auto samples = smoothTrajectory(36000);
+    for (const auto &sample : samples)
+    {
+        history.append(sample.timestamp, sample.location);
+    }
+
+    EXPECT_GE(rawBytes(samples.size()), 8 * history.compressedBytes());
+}
+
+// Test: range reads return only the requested window, downsampled reads one sample per interval
+TEST(LocationHistoryTest, RangeAndDownsample)
+{
+    LocationHistory::Options options;
+    options.samplesPerBlock = 16;
+    LocationHistory history(options);
+    for (const auto &sample : smoothTrajectory(200))
+    {
+        history.append(sample.timestamp, sample.location);
+    }
+
+    const auto window = history.range(kStart + 5s, kStart + 6s);
+    ASSERT_EQ(window.size(), 11u);
+    EXPECT_EQ(window.front().timestamp, kStart + 5s);
+    EXPECT_EQ(window.back().timestamp, kStart + 6s);
+
+    const auto perSecond = history.downsample(kStart, kStart + 1h, 1s);
+    ASSERT_EQ(perSecond.size(), 20u);
+    EXPECT_EQ(perSecond[3].timestamp, kStart + 3s);
+
+    EXPECT_TRUE(history.range(kStart + 1h, kStart + 2h).empty());
+    EXPECT_THROW(history.downsample(kStart, kStart + 1h, 0s), std::invalid_argument);
+}
+
+// Test: out of order timestamps are clamped, clear() starts over
+TEST(LocationHistoryTest, OutOfOrderAndClear)
+{
+    LocationHistory history;
+    history.append(kStart + 1s, Location(1.0, 2.0, 3.0));
+    history.append(kStart, Location(1.0, 2.0, 4.0));
+
+    const auto samples = history.range(kStart, kStart + 1h);
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_EQ(samples[1].timestamp, kStart + 1s);
+
+    history.clear();
+    EXPECT_EQ(history.size(), 0u);
+    EXPECT_EQ(history.compressedBytes(), 0u);
+    EXPECT_THROW(LocationHistory(LocationHistory::Options{.degreesStep = 0.0}), std::invalid_argument);
+}
@@ -1,9 +1,11 @@
 #include "state_machine_manager.hpp"
+#include "path_simplifier.hpp"
 #include "icd.hpp"
 
 #include <gtest/gtest.h>
 #include <queue>
 #include <optional>
+#include <memory>
 
 using namespace drone_sdk;
 
@@ -95,21 +97,21 @@ protected:
         m_stateMachineManager.start();
         // Attach observers for various states
         m_stateMachineManager.subscribeToGpsSignalState(
-            [this](safetyState state)
-            { m_observer.onGpsStateUpdate(state); });
+            [this](SafetyTransition transition)
+            { m_observer.onGpsStateUpdate(transition.to); });
 
         m_stateMachineManager.subscribeToLinkSignalState(
-            [this](safetyState state)
-            { m_observer.onLinkStateUpdate(state); });
+            [this](SafetyTransition transition)
+            { m_observer.onLinkStateUpdate(transition.to); });
 
         m_stateMachineManager.subscribeToFlightState(
-            [this](FlightState state)
-            { m_observer.onFlightStateUpdate(state); });
+            [this](FlightTransition transition)
+            { m_observer.onFlightStateUpdate(transition.to); });
 
         // Attach observer for CommandMachine states
         m_stateMachineManager.subscribeToCommandState(
-            [this](CommandStatus state)
-            { m_observer.onStateChanged(state); });
+            [this](CommandTransition transition)
+            { m_observer.onStateChanged(transition.to); });
 
         m_stateMachineManager.subscribeToWaypoint(
             [this](Location waypoint)
@@ -208,7 +210,7 @@ TEST_F(StateMachineManagerTest, NewTaskGotoMissionWithHoverInterrupt)
     // Validate the flight controller's response for the HOVER interrupt
     EXPECT_EQ(statusHover, drone_sdk::FlightControllerStatus::SUCCESS);
     EXPECT_EQ(m_observer.getLastState(), drone_sdk::CommandStatus::IDLE); // Command should reflect IDLE after interruption
-    EXPECT_EQ(m_observer.getPrevFlightState(), drone_sdk::FlightState::HOVER);//???
+    EXPECT_EQ(m_observer.getPrevFlightState(), drone_sdk::FlightState::AIRBORNE); // Hovering again is no transition
     EXPECT_EQ(m_observer.getLastFlightState(), drone_sdk::FlightState::HOVER);
 }
 
@@ -339,3 +341,70 @@ TEST_F(StateMachineManagerTest, NewTaskGotoMissionWithAbortInterrupt)
    // EXPECT_EQ(m_observer.getPrevFlightState(), drone_sdk::FlightState::LANDED);
     EXPECT_EQ(m_observer.getLastFlightState(), drone_sdk::FlightState::RETURN_HOME);
 }
+
+// Geofence around 37.70..37.72 N, 122.40..122.42 E up to 500 m, with a 120 m ceiling everywhere
+std::shared_ptr<const Geofence> makeTestGeofence()
+{
+    auto geofence = std::make_shared<Geofence>();
+    geofence->addNoFlyZone({{{37.70, 122.40, 0.0}, {37.72, 122.40, 0.0}, {37.72, 122.42, 0.0}, {37.70, 122.42, 0.0}}, 0.0, 500.0});
+    geofence->setAltitudeCeiling(120.0);
+    return geofence;
+}
+
+TEST_F(StateMachineManagerTest, GeofenceRejectsCrossingMissions)
+{
+    m_stateMachineManager.setGeofence(makeTestGeofence());
+    m_stateMachineManager.handleGpsUpdate({37.69, 122.41, 30.0}, SignalQuality::EXCELLENT);
+
+    // Straight through the zone
+    EXPECT_EQ(m_stateMachineManager.newTask(CurrentMission::GOTO, Location{37.73, 122.41, 30.0}, std::nullopt),
+              FlightControllerStatus::GEOFENCE_VIOLATION);
+    // Above the ceiling
+    EXPECT_EQ(m_stateMachineManager.newTask(CurrentMission::GOTO, Location{37.69, 122.38, 150.0}, std::nullopt),
+              FlightControllerStatus::GEOFENCE_VIOLATION);
+    // Second leg of a path cuts the zone
+    EXPECT_EQ(m_stateMachineManager.newPathTask(Path{{37.69, 122.39, 30.0}, {37.73, 122.41, 30.0}}),
+              FlightControllerStatus::GEOFENCE_VIOLATION);
+    EXPECT_EQ(m_observer.getLastState(), CommandStatus::IDLE);
+
+    // Around the zone is fine
+    EXPECT_EQ(m_stateMachineManager.newPathTask(Path{{37.69, 122.39, 30.0}, {37.73, 122.39, 30.0}}),
+              FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(m_observer.getLastState(), CommandStatus::BUSY);
+}
+
+TEST_F(StateMachineManagerTest, GeofenceChecksSimplifiedRoute)
+{
+    m_stateMachineManager.setGeofence(makeTestGeofence());
+    m_stateMachineManager.handleGpsUpdate({37.71, 122.38, 30.0}, SignalQuality::EXCELLENT);
+    // West of the zone, around its south west corner, then south of it
+    const auto aroundCorner = []()
+    { return Path{{37.71, 122.39, 30.0}, {37.695, 122.395, 30.0}, {37.695, 122.42, 30.0}}; };
+
+    // Flying every waypoint stays clear
+    EXPECT_EQ(m_stateMachineManager.checkGeofence(aroundCorner(), std::nullopt), FlightControllerStatus::SUCCESS);
+
+    // A tolerance of 2 km drops the corner waypoint, the shortcut cuts through the zone
+    Path simplified = simplifyPath(aroundCorner(), 2000.0);
+    ASSERT_EQ(simplified.routeSize(), 2u);
+    EXPECT_EQ(m_stateMachineManager.checkGeofence(simplified, std::nullopt), FlightControllerStatus::GEOFENCE_VIOLATION);
+    EXPECT_EQ(m_stateMachineManager.newPathTask(std::move(simplified)), FlightControllerStatus::GEOFENCE_VIOLATION);
+    EXPECT_EQ(m_observer.getLastState(), CommandStatus::IDLE);
+}
+
+TEST_F(StateMachineManagerTest, GeofenceBreachAbortsMission)
+{
+    std::optional<safetyState> geofenceState;
+    m_stateMachineManager.subscribeToGeofenceState([&geofenceState](SafetyTransition transition)
+                                                   { geofenceState = transition.to; });
+    m_stateMachineManager.setGeofence(makeTestGeofence());
+    m_stateMachineManager.handleGpsUpdate({37.69, 122.39, 30.0}, SignalQuality::EXCELLENT);
+    ASSERT_EQ(m_stateMachineManager.newTask(CurrentMission::GOTO, Location{37.69, 122.38, 30.0}, std::nullopt),
+              FlightControllerStatus::SUCCESS);
+
+    // The drone drifts into the zone on its way
+    m_stateMachineManager.handleGpsUpdate({37.71, 122.41, 30.0}, SignalQuality::EXCELLENT);
+
+    EXPECT_EQ(geofenceState, safetyState::GEOFENCE_VIOLATED);
+    EXPECT_EQ(m_observer.getLastState(), CommandStatus::MISSION_ABORT);
+}
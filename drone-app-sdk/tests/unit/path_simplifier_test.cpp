@@ -0,0 +1,96 @@
+#include "path_simplifier.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using drone_sdk::douglasPeucker;
+using drone_sdk::Location;
+using drone_sdk::Path;
+using drone_sdk::simplifyPath;
+
+namespace
+{
+    // About 1.1 m of latitude
+    constexpr double kMeterInDegrees = 1.0e-5;
+}
+
+// Test: waypoints on a straight line collapse to its end points
+TEST(PathSimplifierTest, StraightLineKeepsEndPoints)
+{
+    std::vector<Location> line;
+    for (int i = 0; i <= 100; ++i)
+    {
+        line.emplace_back(32.0 + i * kMeterInDegrees, 34.0 + i * kMeterInDegrees, 50.0 + i);
+    }
+
+    const auto kept = douglasPeucker(line, 0.5);
+
+    ASSERT_EQ(kept.size(), 2u);
+    EXPECT_EQ(kept.front(), 0u);
+    EXPECT_EQ(kept.back(), 100u);
+}
+
+// Test: a corner further away than the tolerance is kept, one within it is dropped
+TEST(PathSimplifierTest, ToleranceDecidesCorners)
+{
+    const std::vector<Location> corner{{32.0, 34.0, 50.0},
+                                       {32.0 + 100 * kMeterInDegrees, 34.0, 50.0},
+                                       {32.0 + 200 * kMeterInDegrees, 34.0, 50.0 + 5.0}};
+
+    EXPECT_EQ(douglasPeucker(corner, 1.0), (std::vector<std::size_t>{0, 1, 2}));
+    EXPECT_EQ(douglasPeucker(corner, 5.0), (std::vector<std::size_t>{0, 2}));
+}
+
+// Test: every dropped waypoint lies within the tolerance of the leg replacing it
+TEST(PathSimplifierTest, DroppedWaypointsWithinTolerance)
+{
+    std::vector<Location> zigzag;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double wobble = std::sin(i * 0.05) * 20.0 * kMeterInDegrees;
+        zigzag.emplace_back(32.0 + i * kMeterInDegrees + wobble, 34.0 + i * kMeterInDegrees, 50.0);
+    }
+
+    const auto kept = douglasPeucker(zigzag, 3.0);
+    EXPECT_LT(kept.size(), zigzag.size() / 4);
+
+    Path path{std::vector<Location>(zigzag)};
+    path.setRoute(kept);
+    std::size_t covered = 0;
+    while (!path.empty())
+    {
+        covered += path.pop().size();
+    }
+    EXPECT_EQ(covered, zigzag.size());
+}
+
+// Test: simplifyPath routes only the waypoints still ahead and keeps the originals
+TEST(PathSimplifierTest, SimplifyPathKeepsOriginals)
+{
+    Path path{{32.0, 34.0, 50.0},
+              {32.0 + 10 * kMeterInDegrees, 34.0, 50.0},
+              {32.0 + 20 * kMeterInDegrees, 34.0, 50.0},
+              {32.0 + 30 * kMeterInDegrees, 34.0, 50.0}};
+    path.pop();
+
+    path = simplifyPath(std::move(path), 1.0);
+
+    EXPECT_EQ(path.size(), 2u);
+    EXPECT_EQ(path.position(), 1u);
+    EXPECT_EQ(path.waypoints().size(), 4u);
+    EXPECT_EQ(path.pop().size(), 1u);
+    EXPECT_EQ(path.pop().size(), 2u);
+    EXPECT_TRUE(path.empty());
+}
+
+// Test: a zero tolerance leaves the path untouched
+TEST(PathSimplifierTest, ZeroToleranceIsNoOp)
+{
+    Path path{{1, 1, 1}, {1, 1, 1}, {1, 1, 1}};
+
+    path = simplifyPath(std::move(path), 0.0);
+
+    EXPECT_EQ(path.size(), 3u);
+}
@@ -0,0 +1,159 @@
+#include "path.hpp"
+
+#include <gtest/gtest.h>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using drone_sdk::Location;
+using drone_sdk::Path;
+
+// Test: a path hands out its waypoints in order like a queue
+TEST(PathTest, QueueLikeConsumption)
+{
+    Path path{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+
+    ASSERT_EQ(path.size(), 3u);
+    EXPECT_EQ(path.front(), Location(1, 1, 1));
+    path.pop();
+    EXPECT_EQ(path.front(), Location(2, 2, 2));
+    EXPECT_EQ(path.position(), 1u);
+    EXPECT_EQ(path.remaining().size(), 2u);
+    EXPECT_EQ(path.waypoints().size(), 3u);
+    path.pop();
+    path.pop();
+    EXPECT_TRUE(path.empty());
+    EXPECT_THROW(path.front(), std::out_of_range);
+}
+
+// Test: building a path from a vector keeps the vector's buffer
+TEST(PathTest, TakesVectorWithoutCopy)
+{
+    std::vector<Location> points(50000, Location(1, 2, 3));
+    const Location *buffer = points.data();
+
+    Path path(std::move(points));
+
+    EXPECT_EQ(path.waypoints().data(), buffer);
+    EXPECT_EQ(path.size(), 50000u);
+}
+
+// Test: moving a path moves the cursor and leaves the source empty
+TEST(PathTest, MoveKeepsCursor)
+{
+    static_assert(!std::is_copy_constructible_v<Path>, "Path must be move-only");
+
+    Path source{{1, 1, 1}, {2, 2, 2}};
+    source.pop();
+    const Location *buffer = source.waypoints().data();
+
+    Path target(std::move(source));
+
+    EXPECT_EQ(target.front(), Location(2, 2, 2));
+    EXPECT_EQ(target.waypoints().data(), buffer);
+    EXPECT_TRUE(source.empty());
+}
+
+// Test: the legacy queue conversion keeps the order
+TEST(PathTest, FromQueue)
+{
+    std::queue<Location> queue;
+    queue.push({1, 1, 1});
+    queue.push({2, 2, 2});
+
+    Path path = Path::fromQueue(queue);
+
+    ASSERT_EQ(path.size(), 2u);
+    EXPECT_EQ(path.front(), Location(1, 1, 1));
+}
+
+// Test: external storage stays alive as long as the path
+TEST(PathTest, ExternalStorage)
+{
+    auto storage = std::make_shared<std::vector<Location>>(std::vector<Location>{{5, 5, 5}, {6, 6, 6}});
+    std::weak_ptr<std::vector<Location>> watch = storage;
+
+    Path path(storage, std::span<const Location>(storage->data(), storage->size()));
+    storage.reset();
+
+    EXPECT_FALSE(watch.expired());
+    EXPECT_EQ(path.front(), Location(5, 5, 5));
+    path = Path();
+    EXPECT_TRUE(watch.expired());
+}
+
+// Test: a route skips waypoints but pop() reports them with the next routed one
+TEST(PathTest, RouteCoversSkippedWaypoints)
+{
+    Path path{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}, {4, 4, 4}};
+    EXPECT_THROW(path.setRoute({0, 2}), std::invalid_argument);
+    EXPECT_THROW(path.setRoute({0, 2, 2, 3}), std::invalid_argument);
+
+    path.setRoute({0, 2, 3});
+
+    EXPECT_EQ(path.size(), 3u);
+    EXPECT_EQ(path.pop().size(), 1u);
+    EXPECT_EQ(path.front(), Location(3, 3, 3));
+    EXPECT_EQ(path.remaining().size(), 2u);
+    const auto leg = path.pop();
+    ASSERT_EQ(leg.size(), 2u);
+    EXPECT_EQ(leg[0], Location(2, 2, 2));
+    EXPECT_EQ(path.pop().size(), 1u);
+    EXPECT_TRUE(path.empty());
+}
+
+// Test: waypoints not reached yet can be appended, replaced and dropped
+TEST(PathTest, EditInPlace)
+{
+    Path path{{1, 1, 1}, {2, 2, 2}};
+    path.pop();
+
+    const std::vector<Location> more{{3, 3, 3}, {4, 4, 4}};
+    path.append(more);
+    EXPECT_EQ(path.size(), 3u);
+
+    const std::vector<Location> detour{{9, 9, 9}};
+    path.replaceRemaining(2, detour);
+    EXPECT_EQ(path.waypoints().size(), 3u);
+    EXPECT_EQ(path.waypoints()[2], Location(9, 9, 9));
+    EXPECT_THROW(path.replaceRemaining(0, detour), std::out_of_range);
+    EXPECT_THROW(path.truncate(4), std::out_of_range);
+
+    path.truncate(1);
+    EXPECT_TRUE(path.empty());
+    path.append(more);
+    EXPECT_EQ(path.front(), Location(3, 3, 3));
+}
+
+// Test: edits of a routed path fly the new waypoints and keep the rest covered
+TEST(PathTest, EditRoutedPath)
+{
+    Path path{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}, {4, 4, 4}, {5, 5, 5}};
+    path.setRoute({0, 4});
+    path.pop();
+
+    const std::vector<Location> detour{{7, 7, 7}, {8, 8, 8}};
+    path.replaceRemaining(3, detour); // Keeps 2 and 3, which the route skipped
+
+    EXPECT_EQ(path.size(), 3u);
+    EXPECT_EQ(path.front(), Location(3, 3, 3));
+    EXPECT_EQ(path.pop().size(), 2u);
+    EXPECT_EQ(path.pop().size(), 1u);
+    EXPECT_EQ(path.pop()[0], Location(8, 8, 8));
+    EXPECT_TRUE(path.empty());
+}
+
+// Test: a path over foreign memory copies it on the first edit only
+TEST(PathTest, EditCopiesForeignStorage)
+{
+    auto owner = std::make_shared<std::vector<Location>>(std::vector<Location>{{1, 1, 1}, {2, 2, 2}});
+    Path path(owner, std::span<const Location>(*owner));
+
+    const std::vector<Location> more{{3, 3, 3}};
+    path.append(more);
+
+    EXPECT_NE(path.waypoints().data(), owner->data());
+    EXPECT_EQ(owner->size(), 2u);
+    EXPECT_EQ(path.waypoints().size(), 3u);
+}
@@ -0,0 +1,225 @@
+#include "retry_policy.hpp"
+#include "command_worker.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using drone_sdk::FlightControllerStatus;
+using drone_sdk::Idempotency;
+using drone_sdk::Retrier;
+using drone_sdk::RetryPolicy;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Returns the scripted statuses in order, then SUCCESS
+    struct ScriptedCommand
+    {
+        std::vector<FlightControllerStatus> script;
+        int calls = 0;
+
+        FlightControllerStatus operator()()
+        {
+            const auto index = static_cast<std::size_t>(calls++);
+            return index < script.size() ? script[index] : FlightControllerStatus::SUCCESS;
+        }
+    };
+
+    RetryPolicy fixedPolicy()
+    {
+        RetryPolicy policy;
+        policy.jitter = 0.0;
+        return policy;
+    }
+
+    // Runs the retries at once, keeping their waits
+    Retrier::Schedule immediate(std::vector<Retrier::Clock::duration> *waits = nullptr)
+    {
+        return [waits](Retrier::Clock::duration delay, std::move_only_function<void()> retry)
+        {
+            if (waits)
+            {
+                waits->push_back(delay);
+            }
+            retry();
+        };
+    }
+
+    // Keeps the status a command finished with
+    struct Outcome
+    {
+        std::optional<FlightControllerStatus> status;
+
+        Retrier::Done done()
+        {
+            return [this](FlightControllerStatus result)
+            { status = result; };
+        }
+    };
+
+    // Runs @p command to the end, the retries running at once
+    FlightControllerStatus runNow(Retrier &retrier, Idempotency idempotency, ScriptedCommand &command)
+    {
+        Outcome outcome;
+        retrier.run(idempotency, std::ref(command), outcome.done());
+        return outcome.status.value();
+    }
+}
+
+// Test: transient failures are retried with exponential backoff until the command succeeds
+TEST(RetryPolicyTest, RetriesTransientFailures)
+{
+    std::vector<Retrier::Clock::duration> waits;
+    Retrier retrier(fixedPolicy(), immediate(&waits));
+    ScriptedCommand command{{FlightControllerStatus::CONNECTION_ERROR, FlightControllerStatus::HARDWARE_ERROR}};
+
+    const auto status = runNow(retrier, Idempotency::IDEMPOTENT, command);
+
+    EXPECT_EQ(status, FlightControllerStatus::SUCCESS);
+    EXPECT_EQ(command.calls, 3);
+    ASSERT_EQ(waits.size(), 2u);
+    EXPECT_EQ(waits[0], Retrier::Clock::duration(50ms));
+    EXPECT_EQ(waits[1], Retrier::Clock::duration(100ms));
+    const auto metrics = retrier.metrics();
+    EXPECT_EQ(metrics.commands, 1u);
+    EXPECT_EQ(metrics.retries, 2u);
+    EXPECT_EQ(metrics.recovered, 1u);
+    EXPECT_EQ(metrics.exhausted, 0u);
+}
+
+// Test: permanent failures and non idempotent commands are not repeated
+TEST(RetryPolicyTest, DoesNotRepeatUnsafeOrPermanentFailures)
+{
+    Retrier retrier(fixedPolicy(), immediate());
+    ScriptedCommand invalid{{FlightControllerStatus::INVALID_COMMAND}};
+    ScriptedCommand takeOff{{FlightControllerStatus::CONNECTION_ERROR}};
+
+    EXPECT_EQ(runNow(retrier, Idempotency::IDEMPOTENT, invalid), FlightControllerStatus::INVALID_COMMAND);
+    EXPECT_EQ(runNow(retrier, Idempotency::NON_IDEMPOTENT, takeOff), FlightControllerStatus::CONNECTION_ERROR);
+
+    EXPECT_EQ(invalid.calls, 1);
+    EXPECT_EQ(takeOff.calls, 1);
+    const auto metrics = retrier.metrics();
+    EXPECT_EQ(metrics.commands, 2u);
+    EXPECT_EQ(metrics.retries, 0u);
+    EXPECT_EQ(metrics.exhausted, 1u);
+}
+
+// Test: retries stop at maxAttempts, or earlier once the deadline would be passed
+TEST(RetryPolicyTest, GivesUpAtLimits)
+{
+    const std::vector<FlightControllerStatus> alwaysDown(10, FlightControllerStatus::CONNECTION_ERROR);
+    Retrier retrier(fixedPolicy(), immediate());
+    ScriptedCommand limited{alwaysDown};
+    EXPECT_EQ(runNow(retrier, Idempotency::IDEMPOTENT, limited), FlightControllerStatus::CONNECTION_ERROR);
+    EXPECT_EQ(limited.calls, 4);
+
+    RetryPolicy tight = fixedPolicy();
+    tight.maxAttempts = 10;
+    tight.deadline = 120ms; // Room for the 50 ms wait, not for the 100 ms one after it
+    retrier.setPolicy(tight);
+    ScriptedCommand deadlined{alwaysDown};
+    EXPECT_EQ(runNow(retrier, Idempotency::IDEMPOTENT, deadlined), FlightControllerStatus::CONNECTION_ERROR);
+    EXPECT_EQ(deadlined.calls, 2);
+
+    const auto metrics = retrier.metrics();
+    EXPECT_EQ(metrics.exhausted, 2u);
+    EXPECT_EQ(metrics.deadlineExceeded, 1u);
+}
+
+// Test: backoff is capped and jitter only ever shortens it, by at most the jitter share
+TEST(RetryPolicyTest, BackoffCapAndJitter)
+{
+    const RetryPolicy policy;
+    EXPECT_EQ(Retrier::backoff(policy, 1), Retrier::Clock::duration(50ms));
+    EXPECT_EQ(Retrier::backoff(policy, 4), Retrier::Clock::duration(400ms));
+    EXPECT_EQ(Retrier::backoff(policy, 8), Retrier::Clock::duration(500ms));
+
+    std::vector<Retrier::Clock::duration> waits;
+    RetryPolicy jittery;
+    jittery.maxAttempts = 50;
+    jittery.maxBackoff = 50ms;
+    jittery.deadline = 1h;
+    Retrier retrier(jittery, immediate(&waits), 42);
+    ScriptedCommand command{std::vector<FlightControllerStatus>(100, FlightControllerStatus::HARDWARE_ERROR)};
+    runNow(retrier, Idempotency::IDEMPOTENT, command);
+
+    ASSERT_EQ(waits.size(), 49u);
+    bool varied = false;
+    for (const auto wait : waits)
+    {
+        EXPECT_LE(wait, Retrier::Clock::duration(50ms));
+        EXPECT_GE(wait, Retrier::Clock::duration(25ms));
+        varied = varied || wait != waits.front();
+    }
+    EXPECT_TRUE(varied);
+}
+
+// Test: a later command cancels the retries still pending for an earlier one
+TEST(RetryPolicyTest, LaterCommandCancelsPendingRetries)
+{
+    std::deque<std::move_only_function<void()>> pending;
+    Retrier retrier(fixedPolicy(), [&pending](Retrier::Clock::duration, std::move_only_function<void()> retry)
+                    { pending.push_back(std::move(retry)); });
+    ScriptedCommand goTo{{FlightControllerStatus::CONNECTION_ERROR}};
+    ScriptedCommand land;
+    Outcome flown;
+    Outcome landed;
+
+    retrier.run(Idempotency::IDEMPOTENT, std::ref(goTo), flown.done());
+    ASSERT_EQ(pending.size(), 1u);
+    EXPECT_FALSE(flown.status);
+    retrier.run(Idempotency::IDEMPOTENT, std::ref(land), landed.done());
+    EXPECT_EQ(landed.status, FlightControllerStatus::SUCCESS);
+    pending.front()();
+
+    EXPECT_EQ(goTo.calls, 1); // Not attempted again after the landing
+    EXPECT_EQ(flown.status, FlightControllerStatus::CONNECTION_ERROR);
+    const auto metrics = retrier.metrics();
+    EXPECT_EQ(metrics.commands, 2u);
+    EXPECT_EQ(metrics.exhausted, 1u);
+    EXPECT_EQ(metrics.cancelled, 1u);
+}
+
+// Test: on the command worker, other commands run while a retry waits
+TEST(RetryPolicyTest, WorkerRunsOtherCommandsBetweenAttempts)
+{
+    std::mutex mutex;
+    std::vector<int> sent; // 1 for the retried command, 2 for the other one
+    CommandWorker worker;
+    RetryPolicy policy = fixedPolicy();
+    policy.initialBackoff = std::chrono::milliseconds(100);
+    Retrier retrier(policy, [&worker](Retrier::Clock::duration delay, std::move_only_function<void()> retry)
+                    { worker.postAt(CommandWorker::Clock::now() + delay, std::move(retry)); });
+    const auto record = [&mutex, &sent](int command)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.push_back(command);
+    };
+    std::promise<FlightControllerStatus> retried;
+    std::promise<FlightControllerStatus> other;
+
+    worker.post([&]()
+                {
+                    retrier.run(Idempotency::IDEMPOTENT, [&record, failures = 1]() mutable
+                                {
+                                    record(1);
+                                    return failures-- > 0 ? FlightControllerStatus::HARDWARE_ERROR : FlightControllerStatus::SUCCESS; },
+                                [&retried](FlightControllerStatus status)
+                                { retried.set_value(status); }); });
+    worker.post([&]()
+                { record(2);
+                  other.set_value(FlightControllerStatus::SUCCESS); });
+
+    EXPECT_EQ(other.get_future().wait_for(std::chrono::milliseconds(50)), std::future_status::ready);
+    // The other job did not go through the retrier, so the retry was left pending
+    EXPECT_EQ(retried.get_future().get(), FlightControllerStatus::SUCCESS);
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(sent, (std::vector<int>{1, 2, 1}));
+}
@@ -0,0 +1,123 @@
+#include "seqlock.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Every field carries the same value, so a torn read shows up as a mismatch
+    struct Record
+    {
+        std::uint64_t values[5];
+        std::uint32_t tail;
+    };
+
+    Record makeRecord(std::uint64_t value)
+    {
+        Record record{};
+        for (auto &field : record.values)
+        {
+            field = value;
+        }
+        record.tail = static_cast<std::uint32_t>(value);
+        return record;
+    }
+
+    bool isConsistent(const Record &record)
+    {
+        for (const auto &field : record.values)
+        {
+            if (field != record.values[0])
+            {
+                return false;
+            }
+        }
+        return record.tail == static_cast<std::uint32_t>(record.values[0]);
+    }
+}
+
+// Test: the initial value is readable before anything is stored
+TEST(SeqLockTest, InitialValue)
+{
+    SeqLock<Record> lock(makeRecord(7));
+    EXPECT_EQ(lock.load().values[3], 7u);
+    EXPECT_EQ(lock.version(), 0u);
+}
+
+// Test: store and modify publish new values
+TEST(SeqLockTest, StoreAndModify)
+{
+    SeqLock<Record> lock;
+    lock.store(makeRecord(1));
+    lock.modify([](Record &record)
+                { record.tail = 42; });
+
+    Record record = lock.load();
+    EXPECT_EQ(record.values[0], 1u);
+    EXPECT_EQ(record.tail, 42u);
+    EXPECT_EQ(lock.version(), 2u);
+}
+
+// Test: readers never observe a half written value while a writer publishes continuously
+TEST(SeqLockTest, ReadersNeverSeeTornValues)
+{
+    SeqLock<Record> lock(makeRecord(0));
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&]()
+                             {
+            std::uint64_t last = 0;
+            while (!done) {
+                Record record = lock.load();
+                if (!isConsistent(record) || record.values[0] < last) {
+                    ++torn;
+                }
+                last = record.values[0];
+            } });
+    }
+
+    for (std::uint64_t value = 1; value <= 200000; ++value)
+    {
+        lock.store(makeRecord(value));
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(lock.load().values[0], 200000u);
+}
+
+// Test: writers on several threads each update their own field without losing the others
+TEST(SeqLockTest, ConcurrentModifiers)
+{
+    SeqLock<Record> lock;
+    std::vector<std::thread> writers;
+    for (std::size_t field = 0; field < 4; ++field)
+    {
+        writers.emplace_back([&lock, field]()
+                             {
+            for (int i = 0; i < 10000; ++i) {
+                lock.modify([field](Record &record) { ++record.values[field]; });
+            } });
+    }
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    Record record = lock.load();
+    for (std::size_t field = 0; field < 4; ++field)
+    {
+        EXPECT_EQ(record.values[field], 10000u);
+    }
+}
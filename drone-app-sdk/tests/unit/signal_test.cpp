@@ -0,0 +1,113 @@
+#include "signal.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class SignalTest : public ::testing::Test
+{
+protected:
+    drone_sdk::Signal<void(int)> signal;
+    std::vector<int> calls;
+};
+
+// Test: every connected slot receives the emitted value, in connection order
+TEST_F(SignalTest, EmitsToAllSlotsInOrder)
+{
+    signal.connect([this](int value)
+                   { calls.push_back(value); });
+    signal.connect([this](int value)
+                   { calls.push_back(value * 10); });
+
+    signal(3);
+
+    EXPECT_EQ(calls, (std::vector<int>{3, 30}));
+    EXPECT_EQ(signal.num_slots(), 2u);
+}
+
+// Test: a disconnected slot is not called anymore
+TEST_F(SignalTest, DisconnectStopsDelivery)
+{
+    auto connection = signal.connect([this](int value)
+                                     { calls.push_back(value); });
+    signal(1);
+    EXPECT_TRUE(connection.connected());
+
+    connection.disconnect();
+    signal(2);
+
+    EXPECT_FALSE(connection.connected());
+    EXPECT_EQ(calls, (std::vector<int>{1}));
+    EXPECT_TRUE(signal.empty());
+}
+
+// Test: a slot may disconnect itself and connect others while the signal emits
+TEST_F(SignalTest, ReentrantConnectAndDisconnect)
+{
+    drone_sdk::Connection self;
+    self = signal.connect([this, &self](int value)
+                          {
+        calls.push_back(value);
+        self.disconnect();
+        signal.connect([this](int later) { calls.push_back(later + 100); }); });
+
+    signal(1); // The slot connected during this emission only sees the next one
+    signal(2);
+
+    EXPECT_EQ(calls, (std::vector<int>{1, 102}));
+}
+
+// Test: disconnect_all_slots() removes every subscriber
+TEST_F(SignalTest, DisconnectAll)
+{
+    auto first = signal.connect([this](int value)
+                                { calls.push_back(value); });
+    signal.connect([this](int value)
+                   { calls.push_back(value); });
+
+    signal.disconnect_all_slots();
+    signal(5);
+
+    EXPECT_TRUE(calls.empty());
+    EXPECT_FALSE(first.connected());
+}
+
+// Test: a connection outliving its signal is harmless
+TEST(SignalLifetimeTest, ConnectionOutlivesSignal)
+{
+    drone_sdk::Connection connection;
+    {
+        drone_sdk::Signal<void()> signal;
+        connection = signal.connect([]() {});
+        EXPECT_TRUE(connection.connected());
+    }
+    EXPECT_FALSE(connection.connected());
+    connection.disconnect();
+}
+
+// Test: emitting while another thread keeps connecting and disconnecting
+TEST(SignalThreadTest, EmitDuringChurn)
+{
+    drone_sdk::Signal<void(int)> signal;
+    std::atomic<long> sum{0};
+    signal.connect([&sum](int value)
+                   { sum += value; });
+
+    std::atomic<bool> done{false};
+    std::thread churn([&]()
+                      {
+        while (!done) {
+            auto connection = signal.connect([](int) {});
+            connection.disconnect();
+        } });
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        signal(1);
+    }
+    done = true;
+    churn.join();
+
+    EXPECT_EQ(sum, 100000);
+}
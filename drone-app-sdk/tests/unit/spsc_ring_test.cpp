@@ -0,0 +1,106 @@
+#include "spsc_ring.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+
+class SpscRingTest : public ::testing::Test
+{
+protected:
+    SpscRing<int, 8> ring;
+};
+
+// Test: a new ring is empty
+TEST_F(SpscRingTest, InitiallyEmpty)
+{
+    int value = 0;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.tryPop(value));
+    EXPECT_EQ(ring.stats().capacity, 8u);
+}
+
+// Test: elements come out in the order they went in, across the wrap-around
+TEST_F(SpscRingTest, FifoOrderAcrossWrap)
+{
+    int value = 0;
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            EXPECT_TRUE(ring.tryPush(round * 10 + i));
+        }
+        for (int i = 0; i < 6; ++i)
+        {
+            ASSERT_TRUE(ring.tryPop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+// Test: a full ring drops new elements and counts them
+TEST_F(SpscRingTest, FullRingDrops)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(100));
+    EXPECT_FALSE(ring.tryPush(101));
+
+    RingStats stats = ring.stats();
+    EXPECT_EQ(stats.pushed, 8u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.highWaterMark, 8u);
+
+    // The oldest elements are kept
+    int value = -1;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 0);
+}
+
+// Test: the high-water mark keeps the deepest backlog
+TEST_F(SpscRingTest, HighWaterMark)
+{
+    int value = 0;
+    ring.tryPush(1);
+    ring.tryPush(2);
+    ring.tryPush(3);
+    ring.tryPop(value);
+    ring.tryPop(value);
+    ring.tryPush(4);
+
+    EXPECT_EQ(ring.stats().highWaterMark, 3u);
+    EXPECT_EQ(ring.size(), 2u);
+}
+
+// Test: one producer and one consumer thread see every accepted element once and in order
+TEST(SpscRingThreadTest, ProducerConsumer)
+{
+    SpscRing<std::uint64_t, 64> ring;
+    constexpr std::uint64_t kCount = 200000;
+
+    std::thread producer([&ring]()
+                         {
+        for (std::uint64_t i = 1; i <= kCount; ++i) {
+            while (!ring.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        } });
+
+    std::uint64_t expected = 1;
+    std::uint64_t value = 0;
+    while (expected <= kCount)
+    {
+        if (ring.tryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+
+    RingStats stats = ring.stats();
+    EXPECT_EQ(stats.pushed, kCount);
+    EXPECT_LE(stats.highWaterMark, 64u);
+}
@@ -0,0 +1,165 @@
+#include "telemetry_replay.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace drone_sdk;
+using namespace std::chrono_literals;
+
+namespace
+{
+    const auto kStart = std::chrono::steady_clock::time_point(1000h);
+    const auto kGpsLoss = kStart + 5min;
+
+    // Ten minutes at 10 Hz GPS and 1 Hz link, flying north, with the GPS lost after five minutes
+    std::vector<TelemetrySample> flightLog()
+    {
+        std::vector<TelemetrySample> samples;
+        for (int i = 0; i < 6000; ++i)
+        {
+            const auto timestamp = kStart + i * 100ms;
+            TelemetrySample gps;
+            gps.timestamp = timestamp;
+            gps.source = TelemetrySource::GPS;
+            gps.quality = timestamp < kGpsLoss ? SignalQuality::GOOD : SignalQuality::NO_SIGNAL;
+            gps.location = Location(32.0 + i * 1e-6, 34.0, 50.0);
+            samples.push_back(gps);
+            if (i % 10 == 0)
+            {
+                TelemetrySample link;
+                link.timestamp = timestamp;
+                link.source = TelemetrySource::LINK;
+                link.quality = SignalQuality::EXCELLENT;
+                samples.push_back(link);
+            }
+        }
+        return samples;
+    }
+
+    struct Trace
+    {
+        std::vector<FlightTransition> flight;
+        std::vector<CommandTransition> command;
+    };
+
+    // A replay of flightLog() flying a GOTO given one second in
+    ReplayResult replay(const std::vector<TelemetrySample> &samples, const ReplayOptions &options, Trace &trace)
+    {
+        TelemetryReplay replay;
+        replay.manager().subscribeToFlightState([&trace](FlightTransition transition)
+                                                { trace.flight.push_back(transition); });
+        replay.manager().subscribeToCommandState([&trace](CommandTransition transition)
+                                                 { trace.command.push_back(transition); });
+        replay.schedule(kStart + 1s, [](StateMachineManager &manager)
+                        { manager.newTask(CurrentMission::GOTO, Location(33.0, 34.0, 50.0), std::nullopt); });
+        return replay.run(samples, options);
+    }
+}
+
+// Test: the transitions carry the recorded time of the sample causing them, identically on every run
+TEST(TelemetryReplayTest, AsFastAsPossibleIsDeterministic)
+{
+    const auto samples = flightLog();
+    Trace first;
+    Trace second;
+
+    const ReplayResult result = replay(samples, {}, first);
+    const ReplayResult repeat = replay(samples, {}, second);
+
+    EXPECT_EQ(result.samples, samples.size());
+    EXPECT_EQ(result.simulated, samples.back().timestamp - kStart);
+    EXPECT_LT(result.elapsed, result.simulated);
+    EXPECT_EQ(result.digest, repeat.digest);
+    EXPECT_EQ(result.transitions, repeat.transitions);
+    EXPECT_NE(result.digest, ReplayResult::kEmptyDigest);
+
+    // Take off, then flying, then the GPS loss aborts and lands
+    ASSERT_EQ(first.command.size(), 2u);
+    EXPECT_EQ(first.command[0].to, CommandStatus::BUSY);
+    EXPECT_EQ(first.command[0].timestamp, kStart + 1s);
+    EXPECT_EQ(first.command[1].to, CommandStatus::MISSION_ABORT);
+    EXPECT_EQ(first.command[1].timestamp, kGpsLoss);
+    ASSERT_FALSE(first.flight.empty());
+    EXPECT_EQ(first.flight.back().to, FlightState::EMERGENCY_LAND);
+    EXPECT_EQ(first.flight.back().timestamp, kGpsLoss);
+
+    ASSERT_EQ(second.flight.size(), first.flight.size());
+    for (std::size_t i = 0; i < first.flight.size(); ++i)
+    {
+        EXPECT_EQ(second.flight[i].to, first.flight[i].to);
+        EXPECT_EQ(second.flight[i].timestamp, first.flight[i].timestamp);
+    }
+}
+
+// Test: scaled time paces the samples on the wall clock and changes nothing else
+TEST(TelemetryReplayTest, ScaledTime)
+{
+    auto samples = flightLog();
+    samples.resize(20); // About two seconds of log
+    ReplayOptions options;
+    options.mode = ReplayOptions::Mode::SCALED;
+    options.speed = 10.0;
+    Trace fast;
+    Trace scaled;
+
+    const ReplayResult reference = replay(samples, {}, fast);
+    const ReplayResult result = replay(samples, options, scaled);
+
+    EXPECT_GE(result.elapsed, result.simulated / 10);
+    EXPECT_EQ(result.digest, reference.digest);
+    EXPECT_EQ(scaled.command.size(), fast.command.size());
+}
+
+// Test: the samples of a flight recorder dump replay at their recorded times
+TEST(TelemetryReplayTest, ReplaysRecorderDump)
+{
+    FlightRecorder recorder(64);
+    recorder.recordEvent(RecordedEvent::TASK_ASSIGNED, 0);
+    recorder.recordGpsSample(Location(1.0, 2.0, 3.0), SignalQuality::GOOD);
+    recorder.recordLinkSample(SignalQuality::POOR);
+    recorder.recordGpsSample(Location(1.0, 2.0, 4.0), SignalQuality::NO_SIGNAL);
+    const std::string filename = (std::filesystem::temp_directory_path() / "telemetry_replay_dump.bin").string();
+    recorder.dump(filename);
+
+    const auto samples = TelemetryReplay::load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples[0].source, TelemetrySource::GPS);
+    EXPECT_EQ(samples[0].location, Location(1.0, 2.0, 3.0));
+    EXPECT_EQ(samples[1].source, TelemetrySource::LINK);
+    EXPECT_EQ(samples[1].quality, SignalQuality::POOR);
+    EXPECT_EQ(samples[2].quality, SignalQuality::NO_SIGNAL);
+
+    TelemetryReplay replay;
+    std::vector<SafetyTransition> gps;
+    replay.manager().subscribeToGpsSignalState([&gps](SafetyTransition transition)
+                                               { gps.push_back(transition); });
+    const ReplayResult result = replay.run(samples);
+
+    EXPECT_EQ(result.samples, 3u);
+    ASSERT_EQ(gps.size(), 1u);
+    EXPECT_EQ(gps[0].to, safetyState::GPS_NOT_HEALTHY);
+    EXPECT_EQ(gps[0].timestamp, samples[2].timestamp);
+    EXPECT_EQ(replay.clock().now(), samples[2].timestamp);
+}
+
+// Test: unordered samples and a speed of 0 are refused
+TEST(TelemetryReplayTest, InvalidInput)
+{
+    auto samples = flightLog();
+    samples.resize(3);
+    ReplayOptions options;
+    options.mode = ReplayOptions::Mode::SCALED;
+    options.speed = 0.0;
+    TelemetryReplay replay;
+
+    EXPECT_THROW(replay.run(samples, options), std::invalid_argument);
+    std::swap(samples[0], samples[2]);
+    EXPECT_THROW(replay.run(samples), std::invalid_argument);
+}
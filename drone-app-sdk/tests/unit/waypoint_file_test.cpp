@@ -0,0 +1,88 @@
+#include "waypoint_file.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using drone_sdk::Location;
+
+class WaypointFileTest : public ::testing::Test
+{
+protected:
+    std::string filename;
+
+    void SetUp() override
+    {
+        const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        filename = (std::filesystem::temp_directory_path() / (std::string("waypoints_") + info->name() + ".dwp")).string();
+    }
+
+    void TearDown() override
+    {
+        std::remove(filename.c_str());
+    }
+};
+
+// Test: waypoints written by the writer come back unchanged and in order
+TEST_F(WaypointFileTest, RoundTrip)
+{
+    {
+        drone_sdk::WaypointFileWriter writer(filename);
+        for (int i = 0; i < 1000; ++i)
+        {
+            writer.append(Location(i, i * 0.5, 100.0));
+        }
+        EXPECT_EQ(writer.count(), 1000u);
+    }
+
+    auto file = drone_sdk::MappedWaypointFile::open(filename);
+    ASSERT_EQ(file->waypoints().size(), 1000u);
+    EXPECT_EQ(file->waypoints()[0], Location(0, 0, 100.0));
+    EXPECT_EQ(file->waypoints()[999], Location(999, 499.5, 100.0));
+}
+
+// Test: a path loaded from a file walks the mapped records and keeps the mapping alive
+TEST_F(WaypointFileTest, LoadPath)
+{
+    std::vector<Location> points{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+    {
+        drone_sdk::WaypointFileWriter writer(filename);
+        writer.append(points);
+    }
+
+    drone_sdk::Path path = drone_sdk::loadPathFile(filename);
+    ASSERT_EQ(path.size(), 3u);
+    path.pop();
+    EXPECT_EQ(path.front(), Location(2, 2, 2));
+}
+
+// Test: an empty file yields an empty path
+TEST_F(WaypointFileTest, EmptyFile)
+{
+    drone_sdk::WaypointFileWriter(filename).close();
+
+    EXPECT_TRUE(drone_sdk::loadPathFile(filename).empty());
+}
+
+// Test: missing, foreign and truncated files are rejected
+TEST_F(WaypointFileTest, InvalidFiles)
+{
+    EXPECT_THROW(drone_sdk::loadPathFile(filename), std::runtime_error);
+
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "this is not a waypoint file at all";
+    }
+    EXPECT_THROW(drone_sdk::loadPathFile(filename), std::runtime_error);
+
+    {
+        drone_sdk::WaypointFileWriter writer(filename);
+        writer.append(Location(1, 2, 3));
+        writer.append(Location(4, 5, 6));
+    }
+    std::filesystem::resize_file(filename, sizeof(drone_sdk::WaypointFileHeader) + sizeof(Location));
+    EXPECT_THROW(drone_sdk::loadPathFile(filename), std::runtime_error);
+}
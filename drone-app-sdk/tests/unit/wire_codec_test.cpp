@@ -0,0 +1,129 @@
+#include "wire_codec.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace drone_sdk;
+using namespace drone_sdk::wire;
+
+// Test: a location survives a round trip bit for bit, in a frame of the advertised size
+TEST(WireCodecTest, LocationRoundTrip)
+{
+    const Location location{32.0853, 34.781768, -12.5};
+    std::array<std::uint8_t, kFrameSize<Location>> buffer{};
+
+    const auto written = encode(location, buffer);
+
+    ASSERT_TRUE(written.has_value());
+    EXPECT_EQ(*written, 30u);
+    EXPECT_EQ(buffer[0], kVersion);
+    EXPECT_EQ(buffer[1], WireTraits<Location>::kTypeId);
+    const auto decoded = decode<Location>(buffer);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(*decoded, location);
+}
+
+// Test: every enum value of the ICD encodes to one byte and back
+TEST(WireCodecTest, EnumRoundTrip)
+{
+    std::array<std::uint8_t, 16> buffer{};
+
+    for (const auto status : {FlightControllerStatus::SUCCESS, FlightControllerStatus::GEOFENCE_VIOLATION,
+                              FlightControllerStatus::UNKNOWN_ERROR})
+    {
+        ASSERT_EQ(encode(status, buffer).value(), kFrameSize<FlightControllerStatus>);
+        EXPECT_EQ(decode<FlightControllerStatus>(buffer).value(), status);
+    }
+    ASSERT_TRUE(encode(SignalQuality::FAIR, buffer).has_value());
+    EXPECT_EQ(decode<SignalQuality>(buffer).value(), SignalQuality::FAIR);
+    ASSERT_TRUE(encode(FlightState::HOVER, buffer).has_value());
+    EXPECT_EQ(decode<FlightState>(buffer).value(), FlightState::HOVER);
+    ASSERT_TRUE(encode(CommandStatus::MISSION_ABORT, buffer).has_value());
+    EXPECT_EQ(decode<CommandStatus>(buffer).value(), CommandStatus::MISSION_ABORT);
+}
+
+// Test: a telemetry snapshot keeps every field
+TEST(WireCodecTest, TelemetrySnapshotRoundTrip)
+{
+    TelemetrySnapshot snapshot;
+    snapshot.location = {32.0, 34.0, 50.0};
+    snapshot.gpsQuality = SignalQuality::GOOD;
+    snapshot.linkQuality = SignalQuality::POOR;
+    snapshot.flightState = FlightState::AIRBORNE;
+    snapshot.commandStatus = CommandStatus::BUSY;
+    snapshot.destination = {32.1, 34.1, 60.0};
+    snapshot.timestamp = std::chrono::steady_clock::now();
+    snapshot.version = 42;
+    std::vector<std::uint8_t> buffer(kFrameSize<TelemetrySnapshot>);
+
+    ASSERT_TRUE(encode(snapshot, buffer).has_value());
+    const auto decoded = decode<TelemetrySnapshot>(buffer);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->location, snapshot.location);
+    EXPECT_EQ(decoded->gpsQuality, snapshot.gpsQuality);
+    EXPECT_EQ(decoded->linkQuality, snapshot.linkQuality);
+    EXPECT_EQ(decoded->flightState, snapshot.flightState);
+    EXPECT_EQ(decoded->commandStatus, snapshot.commandStatus);
+    EXPECT_EQ(decoded->destination, snapshot.destination);
+    EXPECT_EQ(decoded->timestamp, snapshot.timestamp);
+    EXPECT_EQ(decoded->version, 42u);
+}
+
+// Test: damaged, foreign or short frames are rejected with the matching error
+TEST(WireCodecTest, RejectsBadFrames)
+{
+    std::array<std::uint8_t, kFrameSize<Location>> buffer{};
+    EXPECT_EQ(encode(Location{}, std::span<std::uint8_t>(buffer).first(10)).error(), WireError::BUFFER_TOO_SMALL);
+    ASSERT_TRUE(encode(Location{1.0, 2.0, 3.0}, buffer).has_value());
+
+    EXPECT_EQ(decode<Location>(std::span<const std::uint8_t>(buffer).first(20)).error(), WireError::BUFFER_TOO_SMALL);
+    EXPECT_EQ(decode<FlightState>(buffer).error(), WireError::WRONG_TYPE);
+
+    auto corrupted = buffer;
+    corrupted[10] ^= 0x01;
+    EXPECT_EQ(decode<Location>(corrupted).error(), WireError::CRC_MISMATCH);
+
+    auto newer = buffer;
+    newer[0] = kVersion + 1;
+    EXPECT_EQ(decode<Location>(newer).error(), WireError::UNSUPPORTED_VERSION);
+}
+
+// Test: an out of range enum byte with a valid CRC is still rejected
+TEST(WireCodecTest, RejectsInvalidEnumValue)
+{
+    std::array<std::uint8_t, kFrameSize<SignalQuality>> buffer{};
+    buffer[0] = kVersion;
+    buffer[1] = WireTraits<SignalQuality>::kTypeId;
+    buffer[2] = 9;
+    const auto crc = crc32(std::span<const std::uint8_t>(buffer).first(3));
+    for (std::size_t i = 0; i < kCrcSize; ++i)
+    {
+        buffer[3 + i] = static_cast<std::uint8_t>(crc >> (8 * i));
+    }
+
+    EXPECT_EQ(decode<SignalQuality>(buffer).error(), WireError::INVALID_VALUE);
+}
+
+// Test: a stream of mixed frames can be split with peekType() and frameSize()
+TEST(WireCodecTest, SplitsMixedStream)
+{
+    std::vector<std::uint8_t> stream(kFrameSize<Location> + kFrameSize<CommandStatus>);
+    ASSERT_TRUE(encode(Location{1.0, 2.0, 3.0}, stream).has_value());
+    ASSERT_TRUE(encode(CommandStatus::BUSY, std::span<std::uint8_t>(stream).subspan(kFrameSize<Location>)).has_value());
+
+    std::span<const std::uint8_t> rest(stream);
+    std::vector<std::uint8_t> types;
+    while (!rest.empty())
+    {
+        const auto type = peekType(rest);
+        ASSERT_TRUE(type.has_value());
+        types.push_back(*type);
+        rest = rest.subspan(frameSize(*type));
+    }
+
+    EXPECT_EQ(types, (std::vector<std::uint8_t>{WireTraits<Location>::kTypeId, WireTraits<CommandStatus>::kTypeId}));
+}